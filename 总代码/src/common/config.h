@@ -3,6 +3,7 @@
 #include <atomic>
 #include <chrono>
 #include <cstdint>
+#include <string>
 
 #define BUFFER_LENGTH 8192
 
@@ -24,8 +25,37 @@ static constexpr int HEADER_PAGE_ID = 0;                                      //
 static constexpr int PAGE_SIZE = 4096;                                        // size of a data page in byte  4KB
 static constexpr int BUFFER_POOL_SIZE = 65536;                                // size of buffer pool 256MB
 // static constexpr int BUFFER_POOL_SIZE = 262144;                                // size of buffer pool 1GB
+static constexpr int BUFFER_POOL_MAX_SIZE = 262144;                           // 缓冲池在线扩大的上限(1GB)，启动时按它预留地址空间
 static constexpr int LOG_BUFFER_SIZE = (1024 * PAGE_SIZE);                    // size of a log buffer in byte
 static constexpr int BUCKET_SIZE = 50;                                        // size of extendible hash bucket
+static constexpr int IO_BATCH_MAX_PAGES = 32;                                 // 一次向量化I/O(preadv/pwritev)最多合并的连续页面数
+static constexpr int BUFFER_POOL_SHARDS = 16;                                 // 缓冲池分片个数的上限，每个分片有独立的页表、空闲链表、replacer和latch
+static constexpr int BUFFER_POOL_SHARD_MIN_FRAMES = 1024;                     // 每个分片至少包含的帧个数，缓冲池较小时相应减少分片个数
+static constexpr int BUFFER_POOL_SHARD_PAGES = IO_BATCH_MAX_PAGES;            // 文件中每这么多个连续页面映射到同一个分片，使合并I/O和预读仍在一个分片内进行
+static constexpr bool ENABLE_ASYNC_IO = true;                                 // 是否使用io_uring异步I/O，内核不支持时自动退化为同步I/O
+static constexpr unsigned ASYNC_IO_QUEUE_DEPTH = 64;                          // 每个线程的io_uring队列深度
+static constexpr bool ENABLE_DIRECT_IO = true;                                // 数据文件是否以O_DIRECT打开，绕过内核页缓存，避免与buffer pool重复缓存
+static constexpr int DIRECT_IO_ALIGNMENT = 4096;                              // O_DIRECT要求的缓冲区地址、文件偏移和读写长度的对齐粒度
+static constexpr bool ENABLE_HUGE_PAGES = true;                               // 缓冲池帧数据区是否使用大页，优先MAP_HUGETLB，否则请求透明大页，都不支持时使用普通页面
+static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;                     // 大页的大小(2MB)
+static constexpr bool ENABLE_PAGE_COMPRESSION = false;                        // 新建的表和索引文件是否以压缩模式存储页面
+static constexpr bool ENABLE_BG_WRITER = true;                                // 是否启动后台写线程，提前写回即将被淘汰的脏页
+static constexpr int BG_WRITER_CLEAN_PERCENT = 10;                            // 后台写线程使淘汰端至少这么多比例(%)的可用帧保持干净
+static constexpr int BG_WRITER_INTERVAL_MS = 20;                              // 后台写线程两轮之间的间隔，前台遇到脏的淘汰页时会提前唤醒它
+static constexpr int BG_WRITER_MAX_PAGES = 256;                               // 后台写线程每轮最多写回的淘汰候选页面个数
+static constexpr int READAHEAD_MIN_PAGES = 4;                                 // 检测到顺序访问后第一轮预读的页面个数，之后每轮预读的页面被用到时窗口翻倍
+static constexpr int READAHEAD_MAX_PAGES = 64;                                // 预读窗口的最大页面个数，同时不超过缓冲池大小的1/8，为0时关闭预读
+static constexpr int BAS_BULK_READ_RING_PAGES = 32;                           // 大表顺序扫描使用的私有环的帧个数(128KB)，扫描在环内循环使用这些帧，不会挤掉缓冲池中的热点页面
+static constexpr int BAS_BULK_WRITE_RING_PAGES = 4096;                        // 批量写入(导入数据、建索引)使用的私有环的帧个数(16MB)，较大的环使脏页有机会合并写回
+static constexpr int BAS_READ_BATCH_PAGES = 8;                                // 使用私有环的扫描缺页时，一次向量化读读入的连续页面个数
+static constexpr int BAS_SCAN_THRESHOLD_PERCENT = 25;                         // 表的页面数超过缓冲池大小的这个比例(%)时，顺序扫描使用私有环
+static constexpr int BUFFER_POOL_DUMP_INTERVAL_S = 300;                       // 每隔这么多秒把缓冲池中的页面及其热度转储到文件，供重启后预热，为0时只在关闭数据库时转储
+static constexpr int WARM_UP_THREADS = 2;                                     // 重启后按转储文件预热缓冲池的后台线程个数
+static constexpr int WARM_UP_BATCH_PAGES = 1024;                              // 预热时按热度每次取出这么多个页面，排序后合并连续页面批量读入
+static constexpr bool ENABLE_POINTER_SWIZZLING = true;                        // B+树的查找和按记录号读取记录时，通过SwipTable直接访问热点页面，不经过页表
+static constexpr int MAX_OPEN_FILES = 512;                                    // 数据文件同时持有的操作系统文件描述符上限，超过时关闭空闲文件的描述符，下次访问时再重新打开
+static constexpr int FILE_EXTENT_SIZE = 1024 * 1024;                          // 文件按extent增长，每次用fallocate预分配的字节数，为0时不预分配
+static constexpr int FREE_PAGE_PUNCH_MIN_RUN = 16;                            // 连续空闲页面达到该长度时用fallocate(PUNCH_HOLE)归还磁盘空间，为0时不打洞
 
 using frame_id_t = int32_t;  // frame id type, 帧页ID, 页在BufferPool中的存储单元称为帧,一帧对应一页
 using page_id_t = int32_t;   // page id type , 页ID
@@ -38,7 +68,21 @@ using timestamp_t = int32_t;  // timestamp type, used for transaction concurrenc
 // log file
 static const std::string LOG_FILE_NAME = "db.log";
 
+// 数据文件的空闲页面表保存在同目录下的"<文件名>.free"中
+static const std::string FREE_LIST_FILE_SUFFIX = ".free";
+// 压缩文件的页面映射表保存在同目录下的"<文件名>.pagemap"中
+static const std::string PAGE_MAP_FILE_SUFFIX = ".pagemap";
+
 // replacer
-static const std::string REPLACER_TYPE = "LRU";
+static const std::string REPLACER_TYPE = "LRU";  // 缓冲池的置换策略：LRU、CLOCK、LRU-K或ARC，可以用环境变量UNIBASE_REPLACER在启动时覆盖
+static constexpr int REPLACER_LRU_K = 2;                                      // LRU-K策略中的K
+static constexpr int REPLACER_CORRELATED_PERIOD = 16;                         // LRU-K和ARC中，同一页面在这么多次访问以内的再次访问视为同一次引用(如逐条读取同一页的记录)，扫描不会因此被当作热点
 
 static const std::string DB_META_NAME = "db.meta";
+// 缓冲池中的页面及其热度转储在数据库目录下的这个文件中，重启后据此预热缓冲池
+static const std::string BUFFER_POOL_DUMP_FILE = "buffer_pool.dump";
+// 没有指定缓冲池的表和索引使用启动时创建的这个缓冲池；用CREATE BUFFER_POOL创建的缓冲池转储在"buffer_pool.<名称>.dump"中
+static const std::string DEFAULT_BUFFER_POOL = "default";
+// 不为空时默认缓冲池的帧放在这个名称的POSIX共享内存段中，进程退出(包括崩溃)后仍保留，重启并完成恢复后接管其中的干净页面；
+// 可以用环境变量UNIBASE_SHARED_BUFFER_POOL在启动时指定
+static const std::string SHARED_BUFFER_POOL_NAME = "";
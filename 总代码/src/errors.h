@@ -93,6 +93,16 @@ class TableExistsError : public UniBaseError {
     TableExistsError(const std::string &tab_name) : UniBaseError("Table already exists: " + tab_name) {}
 };
 
+class BufferPoolNotFoundError : public UniBaseError {
+   public:
+    BufferPoolNotFoundError(const std::string &pool_name) : UniBaseError("Buffer pool not found: " + pool_name) {}
+};
+
+class BufferPoolExistsError : public UniBaseError {
+   public:
+    BufferPoolExistsError(const std::string &pool_name) : UniBaseError("Buffer pool already exists: " + pool_name) {}
+};
+
 class ColumnNotFoundError : public UniBaseError {
    public:
     ColumnNotFoundError(const std::string &col_name) : UniBaseError("Column not found: " + col_name) {}
@@ -144,6 +154,13 @@ class AmbiguousColumnError : public UniBaseError {
     AmbiguousColumnError(const std::string &col_name) : UniBaseError("Ambiguous column: " + col_name) {}
 };
 
+class InvalidParameterValueError : public UniBaseError {
+   public:
+    InvalidParameterValueError(const std::string &param_name, int value, size_t min_value, size_t max_value)
+        : UniBaseError("Invalid value " + std::to_string(value) + " for " + param_name + ", must be between " +
+                       std::to_string(min_value) + " and " + std::to_string(max_value)) {}
+};
+
 class PageNotExistError : public UniBaseError {
    public:
     PageNotExistError(const std::string &table_name, int page_no)
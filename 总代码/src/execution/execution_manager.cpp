@@ -13,14 +13,17 @@
 const char *help_info = "Supported SQL syntax:\n"
                    "  command ;\n"
                    "command:\n"
-                   "  CREATE TABLE table_name (column_name type [, column_name type ...])\n"
+                   "  CREATE TABLE table_name (column_name type [, column_name type ...]) [BUFFER_POOL pool_name]\n"
                    "  DROP TABLE table_name\n"
-                   "  CREATE INDEX table_name (column_name)\n"
+                   "  CREATE INDEX table_name (column_name) [BUFFER_POOL pool_name]\n"
                    "  DROP INDEX table_name (column_name)\n"
                    "  INSERT INTO table_name VALUES (value [, value ...])\n"
                    "  DELETE FROM table_name [WHERE where_clause]\n"
                    "  UPDATE table_name SET column_name = value [, column_name = value ...] [WHERE where_clause]\n"
                    "  SELECT selector FROM table_name [WHERE where_clause]\n"
+                   "  SET buffer_pool_size = num_frames\n"
+                   "  CREATE BUFFER_POOL pool_name (num_frames [, 'replacer'])\n"
+                   "  DROP BUFFER_POOL pool_name\n"
                    "type:\n"
                    "  {INT | FLOAT | CHAR(n)}\n"
                    "where_clause:\n"
@@ -40,7 +43,7 @@ void QlManager::run_mutli_query(std::shared_ptr<Plan> plan, Context *context){
         switch(x->tag) {
             case T_CreateTable:
             {
-                sm_manager_->create_table(x->tab_name_, x->cols_, context);
+                sm_manager_->create_table(x->tab_name_, x->cols_, context, x->buffer_pool_);
                 break;
             }
             case T_DropTable:
@@ -50,7 +53,7 @@ void QlManager::run_mutli_query(std::shared_ptr<Plan> plan, Context *context){
             }
             case T_CreateIndex:
             {
-                sm_manager_->create_index(x->tab_name_, x->tab_col_names_, context);
+                sm_manager_->create_index(x->tab_name_, x->tab_col_names_, context, x->buffer_pool_);
                 break;
             }
             case T_DropIndex:
@@ -58,6 +61,18 @@ void QlManager::run_mutli_query(std::shared_ptr<Plan> plan, Context *context){
                 sm_manager_->drop_index(x->tab_name_, x->tab_col_names_, context);
                 break;
             }
+            case T_CreateBufferPool:
+            {
+                auto pool_plan = std::static_pointer_cast<BufferPoolPlan>(x);
+                sm_manager_->create_buffer_pool(pool_plan->tab_name_, pool_plan->pool_size_, pool_plan->replacer_type_,
+                                                context);
+                break;
+            }
+            case T_DropBufferPool:
+            {
+                sm_manager_->drop_buffer_pool(x->tab_name_, context);
+                break;
+            }
             default:
                 throw InternalError("Unexpected field type");
                 break;  
@@ -65,7 +80,7 @@ void QlManager::run_mutli_query(std::shared_ptr<Plan> plan, Context *context){
     }
 }
 
-// 执行help; show tables; desc table; begin; commit; abort;语句
+// 执行help; show tables; desc table; begin; commit; abort; set param = value;语句
 void QlManager::run_cmd_utility(std::shared_ptr<Plan> plan, txn_id_t *txn_id, Context *context) {
     if (auto x = std::dynamic_pointer_cast<OtherPlan>(plan)) {
         switch(x->tag) {
@@ -108,7 +123,26 @@ void QlManager::run_cmd_utility(std::shared_ptr<Plan> plan, txn_id_t *txn_id, Co
                 context->txn_ = txn_mgr_->get_transaction(*txn_id);
                 txn_mgr_->abort(context->txn_, context->log_mgr_);
                 break;
-            }     
+            }
+            case T_SetParameter:
+            {
+                auto set_plan = std::static_pointer_cast<SetParameterPlan>(x);
+                if (set_plan->param_name_ == "buffer_pool_size") {
+                    // 在线调整缓冲池大小，缩小时等待被固定的页面释放，不影响其他会话继续执行。
+                    // 每个分片至少保留一个帧，最多扩大到启动时预留的帧个数
+                    BufferPoolManager *bpm = sm_manager_->get_bpm();
+                    size_t min_size = bpm->get_num_shards();
+                    size_t max_size = bpm->get_max_pool_size();
+                    if (set_plan->value_ < 0 || static_cast<size_t>(set_plan->value_) < min_size ||
+                        static_cast<size_t>(set_plan->value_) > max_size) {
+                        throw InvalidParameterValueError(set_plan->param_name_, set_plan->value_, min_size, max_size);
+                    }
+                    bpm->resize(static_cast<size_t>(set_plan->value_));
+                } else {
+                    throw InternalError("Unknown parameter: " + set_plan->param_name_);
+                }
+                break;
+            }
             default:
                 throw InternalError("Unexpected field type");
                 break;                        
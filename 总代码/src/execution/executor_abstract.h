@@ -30,6 +30,7 @@ class AbstractExecutor {
 
     virtual Rid &rid() = 0;
 
+    // 扫描算子返回的记录可能直接指向缓冲池的帧，只在下一次nextTuple()或Next()之前有效，需要保留记录的算子自行复制
     virtual std::unique_ptr<RmRecord> Next() = 0;
 
     virtual ColMeta get_col_offset(const TabCol &target) { return ColMeta();};
@@ -21,6 +21,7 @@ class IndexScanExecutor : public AbstractExecutor {
 
     Rid rid_;
     std::unique_ptr<RecScan> scan_;
+    RecordView view_;                           // 最近一次Next()返回的记录，下一次Next()时释放
 
     SmManager *sm_manager_;
 
@@ -88,7 +89,11 @@ class IndexScanExecutor : public AbstractExecutor {
     std::unique_ptr<RmRecord> Next() override {
          while (scan_ != nullptr && !scan_->is_end()) {
             rid_ = scan_->rid();
-            auto record = fh_->get_record(rid_, context_);
+            // 先在缓冲池帧中检查条件，不满足条件的记录不复制。
+            // 新旧记录可能在同一页面上，先释放上一条记录的读保护，同一线程不能重复获取页面的读锁
+            view_.drop();
+            view_ = fh_->get_record_view(rid_);
+            const char *data = view_.data();
             scan_->next();
             bool ok = true;
             for (auto &cond : fed_conds_) {
@@ -103,7 +108,7 @@ class IndexScanExecutor : public AbstractExecutor {
                     ok = false;
                     break;
                 }
-                const char *lhs_ptr = record->data + lhs_meta->offset;
+                const char *lhs_ptr = data + lhs_meta->offset;
                 const char *rhs_ptr = nullptr;
                 ColMeta rhs_meta;
                 if (cond.is_rhs_val) {
@@ -112,7 +117,7 @@ class IndexScanExecutor : public AbstractExecutor {
                     for (auto &c : cols_) {
                         if (c.name == cond.rhs_col.col_name) {
                             rhs_meta = c;
-                            rhs_ptr = record->data + rhs_meta.offset;
+                            rhs_ptr = data + rhs_meta.offset;
                             break;
                         }
                     }
@@ -150,10 +155,10 @@ class IndexScanExecutor : public AbstractExecutor {
                 }
             }
             if (ok) {
-                return record;
+                return view_.as_record();
             }
         }
-
+        view_.drop();
         return nullptr;
     }
 
@@ -16,7 +16,8 @@ class SeqScanExecutor : public AbstractExecutor {
     std::vector<Condition> fed_conds_;  // 同conds_，两个字段相同
 
     Rid rid_;
-    std::unique_ptr<RecScan> scan_;     // table_iterator
+    std::unique_ptr<RmScan> scan_;      // table_iterator，按页面批量读取记录
+    std::unique_ptr<BufferAccessStrategy> strategy_;  // 大表扫描使用的缓冲池访问策略，小表为nullptr
 
     SmManager *sm_manager_;
 
@@ -33,19 +34,86 @@ class SeqScanExecutor : public AbstractExecutor {
         context_ = context;
 
         fed_conds_ = conds_;
+
+        // 表比它所在缓冲池的BAS_SCAN_THRESHOLD_PERCENT%还大时，扫描只在一个私有的环中循环使用帧，不挤掉缓冲池中的热点页面
+        BufferPoolManager *bpm = fh_->get_buffer_pool_manager();
+        if (static_cast<size_t>(fh_->get_file_hdr().num_pages) * 100 >
+            bpm->get_pool_size() * BAS_SCAN_THRESHOLD_PERCENT) {
+            strategy_ = std::make_unique<BufferAccessStrategy>(BufferAccessType::BULK_READ);
+        }
     }
 
     void beginTuple() override {
-        
+        scan_ = std::make_unique<RmScan>(fh_, strategy_.get());
+        skip_unmatched();
     }
 
     void nextTuple() override {
-        
+        scan_->next();
+        skip_unmatched();
     }
 
+    bool is_end() const override { return scan_ == nullptr || scan_->is_end(); }
+
+    // 返回的记录直接指向扫描固定着的缓冲池帧，不分配空间也不复制，只在下一次nextTuple()之前有效
     std::unique_ptr<RmRecord> Next() override {
-        return nullptr;
+        return RmRecord::borrow(fh_->get_file_hdr().record_size, scan_->record());
     }
 
     Rid &rid() override { return rid_; }
+
+   private:
+    // 跳过不满足fed_conds_的记录，停在下一条满足所有条件的记录或文件末尾
+    void skip_unmatched() {
+        while (!scan_->is_end() && !eval_conds(scan_->record())) {
+            scan_->next();
+        }
+        rid_ = scan_->rid();
+    }
+
+    /**
+     * @description: 判断记录是否满足所有fed_conds_，条件的右边是常量或同一张表的字段
+     * @param {char*} data 记录的数据
+     */
+    bool eval_conds(const char *data) const {
+        for (auto &cond : fed_conds_) {
+            auto lhs_col = get_col_meta(cond.lhs_col.col_name);
+            const char *lhs_ptr = data + lhs_col->offset;
+            const char *rhs_ptr =
+                cond.is_rhs_val ? cond.rhs_val.raw->data : data + get_col_meta(cond.rhs_col.col_name)->offset;
+            int cmp = 0;
+            if (lhs_col->type == TYPE_INT) {
+                int l = *reinterpret_cast<const int *>(lhs_ptr);
+                int r = *reinterpret_cast<const int *>(rhs_ptr);
+                cmp = (l < r) ? -1 : (l > r);
+            } else if (lhs_col->type == TYPE_FLOAT) {
+                float l = *reinterpret_cast<const float *>(lhs_ptr);
+                float r = *reinterpret_cast<const float *>(rhs_ptr);
+                cmp = (l < r) ? -1 : (l > r);
+            } else if (lhs_col->type == TYPE_STRING) {
+                cmp = memcmp(lhs_ptr, rhs_ptr, lhs_col->len);
+            }
+            bool cond_ok = false;
+            switch (cond.op) {
+                case OP_EQ: cond_ok = (cmp == 0); break;
+                case OP_NE: cond_ok = (cmp != 0); break;
+                case OP_LT: cond_ok = (cmp < 0); break;
+                case OP_GT: cond_ok = (cmp > 0); break;
+                case OP_LE: cond_ok = (cmp <= 0); break;
+                case OP_GE: cond_ok = (cmp >= 0); break;
+            }
+            if (!cond_ok) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::vector<ColMeta>::const_iterator get_col_meta(const std::string &col_name) const {
+        auto pos = std::find_if(cols_.begin(), cols_.end(), [&](const ColMeta &col) { return col.name == col_name; });
+        if (pos == cols_.end()) {
+            throw ColumnNotFoundError(tab_name_ + '.' + col_name);
+        }
+        return pos;
+    }
 };
\ No newline at end of file
@@ -14,7 +14,7 @@ constexpr int IX_MAX_COL_LEN = 512;
 
 class IxFileHdr {
 public: 
-    page_id_t first_free_page_no_;      // 文件中第一个空闲的磁盘页面的页面号
+    page_id_t first_free_page_no_;      // 保留字段，始终为IX_NO_PAGE；释放的页面由DiskManager的空闲页面表("<索引文件名>.free")管理
     int num_pages_;                     // 磁盘文件中页面的数量
     page_id_t root_page_;               // B+树根节点对应的页面号
     int col_num_;                       // 索引包含的字段数量
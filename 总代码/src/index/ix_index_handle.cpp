@@ -203,7 +203,7 @@ int IxNodeHandle::remove(const char *key) {
 }
 
 IxIndexHandle::IxIndexHandle(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, int fd)
-    : disk_manager_(disk_manager), buffer_pool_manager_(buffer_pool_manager), fd_(fd) {
+    : disk_manager_(disk_manager), buffer_pool_manager_(buffer_pool_manager), fd_(fd), swips_(buffer_pool_manager, fd) {
     // init file_hdr_
     char *buf = new char[PAGE_SIZE];
     memset(buf, 0, PAGE_SIZE);
@@ -257,20 +257,20 @@ bool IxIndexHandle::get_value(const char *key, std::vector<Rid> *result, Transac
     // 2. 在叶子节点中查找目标key值的位置，并读取key对应的rid
     // 3. 把rid存入result参数中
     // 提示：使用完buffer_pool提供的page之后，记得unpin page；记得处理并发的上锁
-    std::lock_guard<std::mutex> guard(root_latch_);
-    auto [leaf, root_latched] = find_leaf_page(key, Operation::FIND, transaction);
-    if (leaf == nullptr) {
+    std::shared_lock<std::shared_mutex> lock(root_latch_);
+    if (is_empty()) {
         return false;
     }
+    ReadPageGuard guard = find_leaf_read(key);
+    IxNodeHandle leaf(file_hdr_, guard.get_page());
     bool found = false;
-    int pos = leaf->lower_bound(key);
-    while (pos < leaf->get_size() &&
-           ix_compare(leaf->get_key(pos), key, file_hdr_->col_types_, file_hdr_->col_lens_) == 0) {
-        result->push_back(*leaf->get_rid(pos));
+    int pos = leaf.lower_bound(key);
+    while (pos < leaf.get_size() &&
+           ix_compare(leaf.get_key(pos), key, file_hdr_->col_types_, file_hdr_->col_lens_) == 0) {
+        result->push_back(*leaf.get_rid(pos));
         found = true;
         pos++;
     }
-    buffer_pool_manager_->unpin_page(leaf->get_page_id(), false);
     return found;
 }
 
@@ -390,7 +390,7 @@ page_id_t IxIndexHandle::insert_entry(const char *key, const Rid &value, Transac
     // 2. 在该叶子节点中插入键值对
     // 3. 如果结点已满，分裂结点，并把新结点的相关信息插入父节点
     // 提示：记得unpin page；若当前叶子节点是最右叶子节点，则需要更新file_hdr_.last_leaf；记得处理并发的上锁
-    std::lock_guard<std::mutex> guard(root_latch_);
+    std::lock_guard<std::shared_mutex> guard(root_latch_);
     auto [leaf, root_latched] = find_leaf_page(key, Operation::INSERT, transaction);
     if (leaf == nullptr) {
         return IX_NO_PAGE;
@@ -435,7 +435,7 @@ bool IxIndexHandle::delete_entry(const char *key, Transaction *transaction) {
     // 2. 在该叶子结点中删除键值对
     // 3. 如果删除成功需要调用CoalesceOrRedistribute来进行合并或重分配操作，并根据函数返回结果判断是否有结点需要删除
     // 4. 如果需要并发，并且需要删除叶子结点，则需要在事务的delete_page_set中添加删除结点的对应页面；记得处理并发的上锁
-    std::lock_guard<std::mutex> guard(root_latch_);
+    std::lock_guard<std::shared_mutex> guard(root_latch_);
     auto [leaf, root_latched] = find_leaf_page(key, Operation::DELETE, transaction);
     if (leaf == nullptr) {
         return false;
@@ -449,13 +449,9 @@ bool IxIndexHandle::delete_entry(const char *key, Transaction *transaction) {
     if (leaf->get_size() > 0) {
         maintain_parent(leaf);
     }
+    // 合并后被删除的结点在coalesce_or_redistribute中直接归还给磁盘的空闲页面表
     bool root_is_latched = false;
-    bool need_delete = coalesce_or_redistribute(leaf, transaction, &root_is_latched);
-    if (need_delete && transaction != nullptr) {
-        Page *page = buffer_pool_manager_->fetch_page(leaf->get_page_id());
-        transaction->append_index_deleted_page(page);
-        buffer_pool_manager_->unpin_page(page->get_page_id(), false);
-    }
+    coalesce_or_redistribute(leaf, transaction, &root_is_latched);
     return true;
 }
 
@@ -483,6 +479,10 @@ bool IxIndexHandle::coalesce_or_redistribute(IxNodeHandle *node, Transaction *tr
     if (node->is_root_page()) {
         bool del_root = adjust_root(node);
         buffer_pool_manager_->unpin_page(node->get_page_id(), true);
+        // 内部根结点被其唯一的孩子取代后可以释放；空的叶子根结点仍保留在文件中
+        if (del_root && !node->is_leaf_page()) {
+            release_node_handle(*node);
+        }
         return del_root;
     }
     if (node->get_size() >= node->get_min_size()) {
@@ -499,14 +499,20 @@ bool IxIndexHandle::coalesce_or_redistribute(IxNodeHandle *node, Transaction *tr
         redistribute(neighbor, node, parent, node_idx);
         result = false;
     } else {
+        // coalesce之后node为被合并掉的右结点，unpin之后释放其页面
         bool delete_parent = coalesce(&neighbor, &node, &parent, node_idx, transaction, root_is_latched);
         if (delete_parent) {
             buffer_pool_manager_->unpin_page(neighbor->get_page_id(), true);
             buffer_pool_manager_->unpin_page(node->get_page_id(), true);
+            release_node_handle(*node);
             // parent will be unpinned in recursive call
             return coalesce_or_redistribute(parent, transaction, root_is_latched);
         }
-        result = false;
+        buffer_pool_manager_->unpin_page(neighbor->get_page_id(), true);
+        buffer_pool_manager_->unpin_page(parent->get_page_id(), true);
+        buffer_pool_manager_->unpin_page(node->get_page_id(), true);
+        release_node_handle(*node);
+        return false;
     }
     buffer_pool_manager_->unpin_page(neighbor->get_page_id(), true);
     buffer_pool_manager_->unpin_page(parent->get_page_id(), true);
@@ -656,12 +662,12 @@ bool IxIndexHandle::coalesce(IxNodeHandle **neighbor_node, IxNodeHandle **node,
  * @note iid和rid存的不是一个东西，rid是上层传过来的记录位置，iid是索引内部生成的索引槽位置
  */
 Rid IxIndexHandle::get_rid(const Iid &iid) const {
-    IxNodeHandle *node = fetch_node(iid.page_no);
-    if (iid.slot_no >= node->get_size()) {
+    ReadPageGuard guard = fetch_node_read(iid.page_no);
+    IxNodeHandle node(file_hdr_, guard.get_page());
+    if (iid.slot_no >= node.get_size()) {
         throw IndexEntryNotFoundError();
     }
-    buffer_pool_manager_->unpin_page(node->get_page_id(), false);  // unpin it!
-    return *node->get_rid(iid.slot_no);
+    return *node.get_rid(iid.slot_no);
 }
 
 /**
@@ -673,27 +679,24 @@ Rid IxIndexHandle::get_rid(const Iid &iid) const {
  * 可用*(int *)key转换回去
  */
 Iid IxIndexHandle::lower_bound(const char *key) {
+    std::shared_lock<std::shared_mutex> lock(root_latch_);
     if (is_empty()) {
         return Iid{-1, -1};
     }
-    auto [leaf, root_latched] = find_leaf_page(key, Operation::FIND, nullptr, true);
-    if (leaf == nullptr) {
-        return Iid{-1, -1};
-    }
+    ReadPageGuard guard = find_leaf_read(key);
     while (true) {
-        int pos = leaf->lower_bound(key);
-        if (pos < leaf->get_size()) {
-            Iid iid{leaf->get_page_no(), pos};
-            buffer_pool_manager_->unpin_page(leaf->get_page_id(), false);
-            return iid;
+        IxNodeHandle leaf(file_hdr_, guard.get_page());
+        int pos = leaf.lower_bound(key);
+        if (pos < leaf.get_size()) {
+            return Iid{leaf.get_page_no(), pos};
         }
-        page_id_t next = leaf->get_next_leaf();
-        buffer_pool_manager_->unpin_page(leaf->get_page_id(), false);
+        page_id_t next = leaf.get_next_leaf();
         if (next == IX_LEAF_HEADER_PAGE || next == IX_NO_PAGE) {
             break;
         }
-        leaf = fetch_node(next);
+        guard = fetch_node_read(next);
     }
+    guard.drop();
     return leaf_end();
 }
 
@@ -704,27 +707,24 @@ Iid IxIndexHandle::lower_bound(const char *key) {
  * @return Iid
  */
 Iid IxIndexHandle::upper_bound(const char *key) {
+    std::shared_lock<std::shared_mutex> lock(root_latch_);
     if (is_empty()) {
         return Iid{-1, -1};
     }
-    auto [leaf, root_latched] = find_leaf_page(key, Operation::FIND, nullptr, true);
-    if (leaf == nullptr) {
-        return Iid{-1, -1};
-    }
+    ReadPageGuard guard = find_leaf_read(key);
     while (true) {
-        int pos = leaf->upper_bound(key);
-        if (pos < leaf->get_size()) {
-            Iid iid{leaf->get_page_no(), pos};
-            buffer_pool_manager_->unpin_page(leaf->get_page_id(), false);
-            return iid;
+        IxNodeHandle leaf(file_hdr_, guard.get_page());
+        int pos = leaf.upper_bound(key);
+        if (pos < leaf.get_size()) {
+            return Iid{leaf.get_page_no(), pos};
         }
-        page_id_t next = leaf->get_next_leaf();
-        buffer_pool_manager_->unpin_page(leaf->get_page_id(), false);
+        page_id_t next = leaf.get_next_leaf();
         if (next == IX_LEAF_HEADER_PAGE || next == IX_NO_PAGE) {
             break;
         }
-        leaf = fetch_node(next);
+        guard = fetch_node_read(next);
     }
+    guard.drop();
     return leaf_end();
 }
 
@@ -735,9 +735,9 @@ Iid IxIndexHandle::upper_bound(const char *key) {
  * @return Iid
  */
 Iid IxIndexHandle::leaf_end() const {
-    IxNodeHandle *node = fetch_node(file_hdr_->last_leaf_);
-    Iid iid = {.page_no = file_hdr_->last_leaf_, .slot_no = node->get_size()};
-    buffer_pool_manager_->unpin_page(node->get_page_id(), false);  // unpin it!
+    ReadPageGuard guard = fetch_node_read(file_hdr_->last_leaf_);
+    IxNodeHandle node(file_hdr_, guard.get_page());
+    Iid iid = {.page_no = file_hdr_->last_leaf_, .slot_no = node.get_size()};
     return iid;
 }
 
@@ -767,23 +767,89 @@ IxNodeHandle *IxIndexHandle::fetch_node(int page_no) const {
     return node;
 }
 
+/**
+ * @brief 获取一个指定结点并加共享锁，用于只读取结点的操作
+ *
+ * @param page_no
+ * @return ReadPageGuard 结点页面的读保护，离开作用域时自动解锁并unpin
+ */
+ReadPageGuard IxIndexHandle::fetch_node_read(int page_no) const {
+    ReadPageGuard guard = buffer_pool_manager_->fetch_page_read(PageId{fd_, page_no});
+    assert(guard.is_valid());
+    return guard;
+}
+
+/**
+ * @brief 获取一个指定结点用于乐观读，不加页面锁，读到的内容需要验证后才能使用。
+ * 结点被swizzle时直接通过swips_找到它所在的帧，既不查页表也不固定页面，验证失败后需要重新获取结点
+ *
+ * @param page_no
+ * @return OptimisticPageGuard 结点页面的乐观读保护，固定了页面时离开作用域自动unpin
+ */
+OptimisticPageGuard IxIndexHandle::fetch_node_optimistic(int page_no) const {
+    OptimisticPageGuard guard = buffer_pool_manager_->fetch_page_swizzled(PageId{fd_, page_no}, &swips_);
+    assert(guard.is_valid());
+    return guard;
+}
+
+/**
+ * @brief 只读查找：从根结点向下找到key所在的叶子结点，调用者需持有root_latch_的共享锁且树不为空。
+ * 内部结点被所有查找反复读取，用乐观读代替共享锁：读出孩子的页号并获得孩子后，父结点的版本号没有变化才继续向下，
+ * 否则从根结点重新开始；到达叶子结点后加共享锁，加锁后版本号仍未变化说明它仍是读到的那个叶子。
+ * 通过swizzle引用得到的结点没有被固定，验证之前读到的可能是帧中其他页面的内容，键的个数超出范围时同样重新开始
+ *
+ * @param key 要查找的目标key值
+ * @return ReadPageGuard 叶子结点页面的读保护
+ */
+ReadPageGuard IxIndexHandle::find_leaf_read(const char *key) const {
+    while (true) {
+        page_id_t page_no = file_hdr_->root_page_;
+        OptimisticPageGuard guard = fetch_node_optimistic(page_no);
+        while (true) {
+            IxNodeHandle node(file_hdr_, guard.get_page());
+            bool is_leaf = node.is_leaf_page();
+            if (!is_leaf && (node.get_size() <= 0 || node.get_size() > node.get_max_size())) {
+                break;
+            }
+            page_id_t child_page_no = is_leaf ? INVALID_PAGE_ID : node.internal_lookup(key);
+            if (!guard.validate()) {
+                break;
+            }
+            if (is_leaf) {
+                ReadPageGuard leaf = fetch_node_read(page_no);
+                if (guard.validate()) {
+                    return leaf;
+                }
+                break;
+            }
+            OptimisticPageGuard child = fetch_node_optimistic(child_page_no);
+            if (!guard.validate()) {
+                break;
+            }
+            guard = std::move(child);
+            page_no = child_page_no;
+        }
+    }
+}
+
 /**
  * @brief 创建一个新结点
  *
  * @return IxNodeHandle*
  * @note pin the page, remember to unpin it outside!
- * 注意：对于Index的处理是，删除某个页面后，认为该被删除的页面是free_page
- * 而first_free_page实际上就是最新被删除的页面，初始为IX_NO_PAGE
- * 在最开始插入时，一直是create node，那么first_page_no一直没变，一直是IX_NO_PAGE
+ * 注意：对于Index的处理是，删除结点后其页面通过release_node_handle()归还给DiskManager的空闲页面表，
+ * new_page()会优先复用这些页面，因此新结点的页号不一定是file_hdr_->num_pages_
  * 与Record的处理不同，Record将未插入满的记录页认为是free_page
  */
 IxNodeHandle *IxIndexHandle::create_node() {
     IxNodeHandle *node;
-    file_hdr_->num_pages_++;
 
     PageId new_page_id = {.fd = fd_, .page_no = INVALID_PAGE_ID};
-    // 从3开始分配page_no，第一次分配之后，new_page_id.page_no=3，file_hdr_.num_pages=4
+    // 没有空闲页面时从3开始分配page_no，第一次分配之后，new_page_id.page_no=3，file_hdr_.num_pages=4
     Page *page = buffer_pool_manager_->new_page(&new_page_id);
+    assert(page != nullptr);
+    // num_pages_记录文件中曾经分配过的最大页号+1，重新打开文件时从这里继续分配
+    file_hdr_->num_pages_ = std::max(file_hdr_->num_pages_, new_page_id.page_no + 1);
     node = new IxNodeHandle(file_hdr_, page);
     return node;
 }
@@ -830,12 +896,13 @@ void IxIndexHandle::erase_leaf(IxNodeHandle *leaf) {
 }
 
 /**
- * @brief 删除node时，更新file_hdr_.num_pages
+ * @brief 删除node时，把node的页面从缓冲池中删除并归还给DiskManager的空闲页面表，之后create_node会复用该页面
+ * file_hdr_.num_pages保持不变，它表示文件中已分配的页号范围，而不是正在使用的页面个数
  *
- * @param node
+ * @param node 已经被unpin、不再被任何结点引用的结点
  */
 void IxIndexHandle::release_node_handle(IxNodeHandle &node) {
-    file_hdr_->num_pages_--;
+    buffer_pool_manager_->delete_page(node.get_page_id());
 }
 
 /**
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <shared_mutex>
+
 #include "ix_defs.h"
 #include "transaction/transaction.h"
 
@@ -157,7 +159,8 @@ class IxIndexHandle {
     BufferPoolManager *buffer_pool_manager_;
     int fd_;                                    // 存储B+树的文件
     IxFileHdr* file_hdr_;                       // 存了root_page，但其初始化为2（第0页存FILE_HDR_PAGE，第1页存LEAF_HEADER_PAGE）
-    std::mutex root_latch_;
+    std::shared_mutex root_latch_;              // 修改树的操作独占，只读的查找共享
+    SwipTable swips_;                           // 被swizzle的结点，查找时从父结点读出的孩子页号直接找到孩子所在的帧
 
    public:
     IxIndexHandle(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, int fd);
@@ -204,6 +207,12 @@ class IxIndexHandle {
     // for get/create node
     IxNodeHandle *fetch_node(int page_no) const;
 
+    ReadPageGuard fetch_node_read(int page_no) const;
+
+    OptimisticPageGuard fetch_node_optimistic(int page_no) const;
+
+    ReadPageGuard find_leaf_read(const char *key) const;
+
     IxNodeHandle *create_node();
 
     // for maintain data structure
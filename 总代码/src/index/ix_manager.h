@@ -47,7 +47,7 @@ class IxManager {
     void create_index(const std::string &filename, const std::vector<ColMeta>& index_cols) {
         std::string ix_name = get_index_name(filename, index_cols);
         // Create index file
-        disk_manager_->create_file(ix_name);
+        disk_manager_->create_file(ix_name, ENABLE_PAGE_COMPRESSION);
         // Open index file
         int fd = disk_manager_->open_file(ix_name);
 
@@ -133,17 +133,19 @@ class IxManager {
         disk_manager_->destroy_file(ix_name);
     }
 
-    // 注意这里打开文件，创建并返回了index file handle的指针
-    std::unique_ptr<IxIndexHandle> open_index(const std::string &filename, const std::vector<ColMeta>& index_cols) {
+    // 注意这里打开文件，创建并返回了index file handle的指针；bpm为空时使用默认缓冲池
+    std::unique_ptr<IxIndexHandle> open_index(const std::string &filename, const std::vector<ColMeta>& index_cols,
+                                              BufferPoolManager *bpm = nullptr) {
         std::string ix_name = get_index_name(filename, index_cols);
         int fd = disk_manager_->open_file(ix_name);
-        return std::make_unique<IxIndexHandle>(disk_manager_, buffer_pool_manager_, fd);
+        return std::make_unique<IxIndexHandle>(disk_manager_, bpm != nullptr ? bpm : buffer_pool_manager_, fd);
     }
 
-    std::unique_ptr<IxIndexHandle> open_index(const std::string &filename, const std::vector<std::string>& index_cols) {
+    std::unique_ptr<IxIndexHandle> open_index(const std::string &filename, const std::vector<std::string>& index_cols,
+                                              BufferPoolManager *bpm = nullptr) {
         std::string ix_name = get_index_name(filename, index_cols);
         int fd = disk_manager_->open_file(ix_name);
-        return std::make_unique<IxIndexHandle>(disk_manager_, buffer_pool_manager_, fd);
+        return std::make_unique<IxIndexHandle>(disk_manager_, bpm != nullptr ? bpm : buffer_pool_manager_, fd);
     }
 
     void close_index(const IxIndexHandle *ih) {
@@ -151,7 +153,15 @@ class IxManager {
         ih->file_hdr_->serialize(data);
         disk_manager_->write_page(ih->fd_, IX_FILE_HDR_PAGE, data, ih->file_hdr_->tot_len_);
         // 缓冲区的所有页刷到磁盘，注意这句话必须写在close_file前面
-        buffer_pool_manager_->flush_all_pages(ih->fd_);
+        ih->buffer_pool_manager_->flush_all_pages(ih->fd_);
+        // 关闭后不再访问该文件，释放它的页面占用的帧
+        ih->buffer_pool_manager_->drop_all_pages(ih->fd_);
+        disk_manager_->close_file(ih->fd_);
+    }
+
+    // 删除索引之前关闭索引文件，文件即将被删除，缓冲池中的页面直接丢弃，不写回磁盘
+    void discard_index(const IxIndexHandle *ih) {
+        ih->buffer_pool_manager_->drop_all_pages(ih->fd_);
         disk_manager_->close_file(ih->fd_);
     }
 };
\ No newline at end of file
@@ -1,20 +1,20 @@
 #include "ix_scan.h"
 
 /**
- * @brief 
- * @todo 加上读锁（需要使用缓冲池得到page）
+ * @brief 移动到下一个索引槽，读取叶子结点时持有其共享锁
  */
 void IxScan::next() {
     assert(!is_end());
-    IxNodeHandle *node = ih_->fetch_node(iid_.page_no);
-    assert(node->is_leaf_page());
-    assert(iid_.slot_no < node->get_size());
+    ReadPageGuard guard = ih_->fetch_node_read(iid_.page_no);
+    IxNodeHandle node(ih_->file_hdr_, guard.get_page());
+    assert(node.is_leaf_page());
+    assert(iid_.slot_no < node.get_size());
     // increment slot no
     iid_.slot_no++;
-    if (iid_.page_no != ih_->file_hdr_->last_leaf_ && iid_.slot_no == node->get_size()) {
+    if (iid_.page_no != ih_->file_hdr_->last_leaf_ && iid_.slot_no == node.get_size()) {
         // go to next leaf
         iid_.slot_no = 0;
-        iid_.page_no = node->get_next_leaf();
+        iid_.page_no = node.get_next_leaf();
     }
 }
 
@@ -28,6 +28,9 @@ class Optimizer {
         } else if (auto x = std::dynamic_pointer_cast<ast::ShowTables>(query->parse)) {
             // show tables;
             return std::make_shared<OtherPlan>(T_ShowTable, std::string());
+        } else if (auto x = std::dynamic_pointer_cast<ast::SetParameter>(query->parse)) {
+            // set param = value;
+            return std::make_shared<SetParameterPlan>(x->param_name, x->value);
         } else if (auto x = std::dynamic_pointer_cast<ast::DescTable>(query->parse)) {
             // desc table;
             return std::make_shared<OtherPlan>(T_DescTable, x->tab_name);
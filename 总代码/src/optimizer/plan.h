@@ -30,7 +30,10 @@ typedef enum PlanTag{
     T_IndexScan,
     T_NestLoop,
     T_Sort,
-    T_Projection
+    T_Projection,
+    T_SetParameter,
+    T_CreateBufferPool,
+    T_DropBufferPool
 } PlanTag;
 
 // 查询执行计划
@@ -145,7 +148,7 @@ class DMLPlan : public Plan
         std::vector<SetClause> set_clauses_;
 };
 
-// ddl语句, 包括create/drop table; create/drop index;
+// ddl语句, 包括create/drop table; create/drop index; create/drop buffer_pool;
 class DDLPlan : public Plan
 {
     public:
@@ -160,6 +163,19 @@ class DDLPlan : public Plan
         std::string tab_name_;
         std::vector<std::string> tab_col_names_;
         std::vector<ColDef> cols_;
+        std::string buffer_pool_ = DEFAULT_BUFFER_POOL;    // create table/index时文件所在的缓冲池
+};
+
+// create/drop buffer_pool语句对应的plan，tab_name_为缓冲池名称
+class BufferPoolPlan : public DDLPlan
+{
+    public:
+        BufferPoolPlan(PlanTag tag, std::string pool_name, size_t pool_size = 0, std::string replacer_type = REPLACER_TYPE)
+            : DDLPlan(tag, std::move(pool_name), std::vector<std::string>(), std::vector<ColDef>()),
+              pool_size_(pool_size), replacer_type_(std::move(replacer_type)) {}
+        ~BufferPoolPlan(){}
+        size_t pool_size_;
+        std::string replacer_type_;
 };
 
 // help; show tables; desc tables; begin; abort; commit; rollback语句对应的plan
@@ -175,6 +191,17 @@ class OtherPlan : public Plan
         std::string tab_name_;
 };
 
+// SET param = value; 运行时修改系统参数
+class SetParameterPlan : public OtherPlan
+{
+    public:
+        SetParameterPlan(std::string param_name, int value)
+            : OtherPlan(T_SetParameter, std::string()), param_name_(std::move(param_name)), value_(value) {}
+        ~SetParameterPlan(){}
+        std::string param_name_;
+        int value_;
+};
+
 class plannerInfo{
     public:
     std::shared_ptr<ast::SelectStmt> parse;
@@ -299,16 +299,34 @@ std::shared_ptr<Plan> Planner::do_planner(std::shared_ptr<Query> query, Context
                 throw InternalError("Unexpected field type");
             }
         }
-        plannerRoot = std::make_shared<DDLPlan>(T_CreateTable, x->tab_name, std::vector<std::string>(), col_defs);
+        auto ddl_plan = std::make_shared<DDLPlan>(T_CreateTable, x->tab_name, std::vector<std::string>(), col_defs);
+        if (!x->buffer_pool.empty()) {
+            ddl_plan->buffer_pool_ = x->buffer_pool;
+        }
+        plannerRoot = ddl_plan;
     } else if (auto x = std::dynamic_pointer_cast<ast::DropTable>(query->parse)) {
         // drop table;
         plannerRoot = std::make_shared<DDLPlan>(T_DropTable, x->tab_name, std::vector<std::string>(), std::vector<ColDef>());
     } else if (auto x = std::dynamic_pointer_cast<ast::CreateIndex>(query->parse)) {
         // create index;
-        plannerRoot = std::make_shared<DDLPlan>(T_CreateIndex, x->tab_name, x->col_names, std::vector<ColDef>());
+        auto ddl_plan = std::make_shared<DDLPlan>(T_CreateIndex, x->tab_name, x->col_names, std::vector<ColDef>());
+        if (!x->buffer_pool.empty()) {
+            ddl_plan->buffer_pool_ = x->buffer_pool;
+        }
+        plannerRoot = ddl_plan;
     } else if (auto x = std::dynamic_pointer_cast<ast::DropIndex>(query->parse)) {
         // drop index
         plannerRoot = std::make_shared<DDLPlan>(T_DropIndex, x->tab_name, x->col_names, std::vector<ColDef>());
+    } else if (auto x = std::dynamic_pointer_cast<ast::CreateBufferPool>(query->parse)) {
+        // create buffer_pool;
+        if (x->pool_size <= 0) {
+            throw InternalError("Buffer pool size must be positive");
+        }
+        plannerRoot = std::make_shared<BufferPoolPlan>(T_CreateBufferPool, x->pool_name, x->pool_size,
+                                                       x->replacer_type.empty() ? REPLACER_TYPE : x->replacer_type);
+    } else if (auto x = std::dynamic_pointer_cast<ast::DropBufferPool>(query->parse)) {
+        // drop buffer_pool;
+        plannerRoot = std::make_shared<BufferPoolPlan>(T_DropBufferPool, x->pool_name);
     } else if (auto x = std::dynamic_pointer_cast<ast::InsertStmt>(query->parse)) {
         // insert;
         plannerRoot = std::make_shared<DMLPlan>(T_Insert, std::shared_ptr<Plan>(),  x->tab_name,  
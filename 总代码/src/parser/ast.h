@@ -67,9 +67,10 @@ struct ColDef : public Field {
 struct CreateTable : public TreeNode {
     std::string tab_name;
     std::vector<std::shared_ptr<Field>> fields;
+    std::string buffer_pool;    // 为空时使用默认缓冲池
 
-    CreateTable(std::string tab_name_, std::vector<std::shared_ptr<Field>> fields_) :
-            tab_name(std::move(tab_name_)), fields(std::move(fields_)) {}
+    CreateTable(std::string tab_name_, std::vector<std::shared_ptr<Field>> fields_, std::string buffer_pool_ = "") :
+            tab_name(std::move(tab_name_)), fields(std::move(fields_)), buffer_pool(std::move(buffer_pool_)) {}
 };
 
 struct DropTable : public TreeNode {
@@ -87,9 +88,10 @@ struct DescTable : public TreeNode {
 struct CreateIndex : public TreeNode {
     std::string tab_name;
     std::vector<std::string> col_names;
+    std::string buffer_pool;    // 为空时使用默认缓冲池
 
-    CreateIndex(std::string tab_name_, std::vector<std::string> col_names_) :
-            tab_name(std::move(tab_name_)), col_names(std::move(col_names_)) {}
+    CreateIndex(std::string tab_name_, std::vector<std::string> col_names_, std::string buffer_pool_ = "") :
+            tab_name(std::move(tab_name_)), col_names(std::move(col_names_)), buffer_pool(std::move(buffer_pool_)) {}
 };
 
 struct DropIndex : public TreeNode {
@@ -100,6 +102,28 @@ struct DropIndex : public TreeNode {
             tab_name(std::move(tab_name_)), col_names(std::move(col_names_)) {}
 };
 
+struct CreateBufferPool : public TreeNode {
+    std::string pool_name;
+    int pool_size;
+    std::string replacer_type;  // 为空时使用默认置换策略
+
+    CreateBufferPool(std::string pool_name_, int pool_size_, std::string replacer_type_ = "") :
+            pool_name(std::move(pool_name_)), pool_size(pool_size_), replacer_type(std::move(replacer_type_)) {}
+};
+
+struct DropBufferPool : public TreeNode {
+    std::string pool_name;
+
+    DropBufferPool(std::string pool_name_) : pool_name(std::move(pool_name_)) {}
+};
+
+struct SetParameter : public TreeNode {
+    std::string param_name;
+    int value;
+
+    SetParameter(std::string param_name_, int value_) : param_name(std::move(param_name_)), value(value_) {}
+};
+
 struct Expr : public TreeNode {
 };
 
@@ -70,10 +70,15 @@ private:
             std::cout << "HELP\n";
         } else if (auto x = std::dynamic_pointer_cast<ShowTables>(node)) {
             std::cout << "SHOW_TABLES\n";
+        } else if (auto x = std::dynamic_pointer_cast<SetParameter>(node)) {
+            std::cout << "SET_PARAMETER\n";
+            print_val(x->param_name, offset);
+            print_val(x->value, offset);
         } else if (auto x = std::dynamic_pointer_cast<CreateTable>(node)) {
             std::cout << "CREATE_TABLE\n";
             print_val(x->tab_name, offset);
             print_node_list(x->fields, offset);
+            print_val(x->buffer_pool, offset);
         } else if (auto x = std::dynamic_pointer_cast<DropTable>(node)) {
             std::cout << "DROP_TABLE\n";
             print_val(x->tab_name, offset);
@@ -86,6 +91,15 @@ private:
             // print_val(x->col_name, offset);
             for(auto col_name: x->col_names)
                 print_val(col_name, offset);
+            print_val(x->buffer_pool, offset);
+        } else if (auto x = std::dynamic_pointer_cast<CreateBufferPool>(node)) {
+            std::cout << "CREATE_BUFFER_POOL\n";
+            print_val(x->pool_name, offset);
+            print_val(x->pool_size, offset);
+            print_val(x->replacer_type, offset);
+        } else if (auto x = std::dynamic_pointer_cast<DropBufferPool>(node)) {
+            std::cout << "DROP_BUFFER_POOL\n";
+            print_val(x->pool_name, offset);
         } else if (auto x = std::dynamic_pointer_cast<DropIndex>(node)) {
             std::cout << "DROP_INDEX\n";
             print_val(x->tab_name, offset);
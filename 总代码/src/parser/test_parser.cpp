@@ -14,6 +14,10 @@ int main() {
         "create index tb(a, b, c);",
         "drop index tb(a, b, c);",
         "drop index tb(b);",
+        "create buffer_pool audit (4096, 'CLOCK');",
+        "create table tb (a int) buffer_pool audit;",
+        "create index tb(a) buffer_pool audit;",
+        "drop buffer_pool audit;",
         "insert into tb values (1, 3.14, 'pi');",
         "delete from tb where a = 1;",
         "update tb set a = 1, b = 2.2, c = 'xyz' where x = 2 and y < 1.1 and z > 'abc';",
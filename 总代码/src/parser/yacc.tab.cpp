@@ -71,6 +71,7 @@
 
 #include "ast.h"
 #include "yacc.tab.h"
+#include <algorithm>
 #include <iostream>
 #include <memory>
 
@@ -80,9 +81,16 @@ void yyerror(YYLTYPE *locp, const char* s) {
     std::cerr << "Parser Error at line " << locp->first_line << " column " << locp->first_column << ": " << s << std::endl;
 }
 
+// BUFFER_POOL不是保留字，在语法动作中按标识符判断(不区分大小写)
+static bool is_buffer_pool_keyword(const std::string &word) {
+    static const std::string keyword = "BUFFER_POOL";
+    return word.size() == keyword.size() &&
+           std::equal(word.begin(), word.end(), keyword.begin(), [](char a, char b) { return toupper(a) == b; });
+}
+
 using namespace ast;
 
-#line 86 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 94 "/root/UniBase/src/parser/yacc.tab.cpp"
 
 # ifndef YY_CAST
 #  ifdef __cplusplus
@@ -153,11 +161,11 @@ enum yysymbol_kind_t
   YYSYMBOL_VALUE_INT = 40,                 /* VALUE_INT  */
   YYSYMBOL_VALUE_FLOAT = 41,               /* VALUE_FLOAT  */
   YYSYMBOL_42_ = 42,                       /* ';'  */
-  YYSYMBOL_43_ = 43,                       /* '('  */
-  YYSYMBOL_44_ = 44,                       /* ')'  */
-  YYSYMBOL_45_ = 45,                       /* ','  */
-  YYSYMBOL_46_ = 46,                       /* '.'  */
-  YYSYMBOL_47_ = 47,                       /* '='  */
+  YYSYMBOL_43_ = 43,                       /* '='  */
+  YYSYMBOL_44_ = 44,                       /* '('  */
+  YYSYMBOL_45_ = 45,                       /* ')'  */
+  YYSYMBOL_46_ = 46,                       /* ','  */
+  YYSYMBOL_47_ = 47,                       /* '.'  */
   YYSYMBOL_48_ = 48,                       /* '<'  */
   YYSYMBOL_49_ = 49,                       /* '>'  */
   YYSYMBOL_50_ = 50,                       /* '*'  */
@@ -167,29 +175,30 @@ enum yysymbol_kind_t
   YYSYMBOL_txnStmt = 54,                   /* txnStmt  */
   YYSYMBOL_dbStmt = 55,                    /* dbStmt  */
   YYSYMBOL_ddl = 56,                       /* ddl  */
-  YYSYMBOL_dml = 57,                       /* dml  */
-  YYSYMBOL_fieldList = 58,                 /* fieldList  */
-  YYSYMBOL_colNameList = 59,               /* colNameList  */
-  YYSYMBOL_field = 60,                     /* field  */
-  YYSYMBOL_type = 61,                      /* type  */
-  YYSYMBOL_valueList = 62,                 /* valueList  */
-  YYSYMBOL_value = 63,                     /* value  */
-  YYSYMBOL_condition = 64,                 /* condition  */
-  YYSYMBOL_optWhereClause = 65,            /* optWhereClause  */
-  YYSYMBOL_whereClause = 66,               /* whereClause  */
-  YYSYMBOL_col = 67,                       /* col  */
-  YYSYMBOL_colList = 68,                   /* colList  */
-  YYSYMBOL_op = 69,                        /* op  */
-  YYSYMBOL_expr = 70,                      /* expr  */
-  YYSYMBOL_setClauses = 71,                /* setClauses  */
-  YYSYMBOL_setClause = 72,                 /* setClause  */
-  YYSYMBOL_selector = 73,                  /* selector  */
-  YYSYMBOL_tableList = 74,                 /* tableList  */
-  YYSYMBOL_opt_order_clause = 75,          /* opt_order_clause  */
-  YYSYMBOL_order_clause = 76,              /* order_clause  */
-  YYSYMBOL_opt_asc_desc = 77,              /* opt_asc_desc  */
-  YYSYMBOL_tbName = 78,                    /* tbName  */
-  YYSYMBOL_colName = 79                    /* colName  */
+  YYSYMBOL_optBufferPool = 57,             /* optBufferPool  */
+  YYSYMBOL_dml = 58,                       /* dml  */
+  YYSYMBOL_fieldList = 59,                 /* fieldList  */
+  YYSYMBOL_colNameList = 60,               /* colNameList  */
+  YYSYMBOL_field = 61,                     /* field  */
+  YYSYMBOL_type = 62,                      /* type  */
+  YYSYMBOL_valueList = 63,                 /* valueList  */
+  YYSYMBOL_value = 64,                     /* value  */
+  YYSYMBOL_condition = 65,                 /* condition  */
+  YYSYMBOL_optWhereClause = 66,            /* optWhereClause  */
+  YYSYMBOL_whereClause = 67,               /* whereClause  */
+  YYSYMBOL_col = 68,                       /* col  */
+  YYSYMBOL_colList = 69,                   /* colList  */
+  YYSYMBOL_op = 70,                        /* op  */
+  YYSYMBOL_expr = 71,                      /* expr  */
+  YYSYMBOL_setClauses = 72,                /* setClauses  */
+  YYSYMBOL_setClause = 73,                 /* setClause  */
+  YYSYMBOL_selector = 74,                  /* selector  */
+  YYSYMBOL_tableList = 75,                 /* tableList  */
+  YYSYMBOL_opt_order_clause = 76,          /* opt_order_clause  */
+  YYSYMBOL_order_clause = 77,              /* order_clause  */
+  YYSYMBOL_opt_asc_desc = 78,              /* opt_asc_desc  */
+  YYSYMBOL_tbName = 79,                    /* tbName  */
+  YYSYMBOL_colName = 80                    /* colName  */
 };
 typedef enum yysymbol_kind_t yysymbol_kind_t;
 
@@ -306,7 +315,7 @@ typedef int yytype_uint16;
 
 
 /* Stored state numbers (used for stacks). */
-typedef yytype_int8 yy_state_t;
+typedef yytype_uint8 yy_state_t;
 
 /* State numbers in computations.  */
 typedef int yy_state_fast_t;
@@ -518,18 +527,18 @@ union yyalloc
 #endif /* !YYCOPY_NEEDED */
 
 /* YYFINAL -- State number of the termination state.  */
-#define YYFINAL  39
+#define YYFINAL  44
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   112
+#define YYLAST   129
 
 /* YYNTOKENS -- Number of terminals.  */
 #define YYNTOKENS  51
 /* YYNNTS -- Number of nonterminals.  */
-#define YYNNTS  29
+#define YYNNTS  30
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  69
+#define YYNRULES  75
 /* YYNSTATES -- Number of states.  */
-#define YYNSTATES  127
+#define YYNSTATES  145
 
 /* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   296
@@ -550,9 +559,9 @@ static const yytype_int8 yytranslate[] =
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-      43,    44,    50,     2,    45,     2,    46,     2,     2,     2,
+      44,    45,    50,     2,    46,     2,    47,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,    42,
-      48,    47,    49,     2,     2,     2,     2,     2,     2,     2,
+      48,    43,    49,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -582,13 +591,14 @@ static const yytype_int8 yytranslate[] =
 /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_int16 yyrline[] =
 {
-       0,    56,    56,    61,    66,    71,    79,    80,    81,    82,
-      86,    90,    94,    98,   105,   112,   116,   120,   124,   128,
-     135,   139,   143,   147,   154,   158,   165,   169,   176,   183,
-     187,   191,   198,   202,   209,   213,   217,   224,   231,   232,
-     239,   243,   250,   254,   261,   265,   272,   276,   280,   284,
-     288,   292,   299,   303,   310,   314,   321,   328,   332,   336,
-     340,   344,   351,   355,   359,   366,   367,   368,   371,   373
+       0,    64,    64,    69,    74,    79,    87,    88,    89,    90,
+      94,    98,   102,   106,   113,   117,   124,   128,   132,   136,
+     140,   144,   152,   160,   172,   175,   186,   190,   194,   198,
+     205,   209,   216,   220,   227,   234,   238,   242,   249,   253,
+     260,   264,   268,   275,   282,   283,   290,   294,   301,   305,
+     312,   316,   323,   327,   331,   335,   339,   343,   350,   354,
+     361,   365,   372,   379,   383,   387,   391,   395,   402,   406,
+     410,   417,   418,   419,   422,   424
 };
 #endif
 
@@ -610,12 +620,12 @@ static const char *const yytname[] =
   "CHAR", "FLOAT", "INDEX", "AND", "JOIN", "EXIT", "HELP", "TXN_BEGIN",
   "TXN_COMMIT", "TXN_ABORT", "TXN_ROLLBACK", "ORDER_BY", "LEQ", "NEQ",
   "GEQ", "T_EOF", "IDENTIFIER", "VALUE_STRING", "VALUE_INT", "VALUE_FLOAT",
-  "';'", "'('", "')'", "','", "'.'", "'='", "'<'", "'>'", "'*'", "$accept",
-  "start", "stmt", "txnStmt", "dbStmt", "ddl", "dml", "fieldList",
-  "colNameList", "field", "type", "valueList", "value", "condition",
-  "optWhereClause", "whereClause", "col", "colList", "op", "expr",
-  "setClauses", "setClause", "selector", "tableList", "opt_order_clause",
-  "order_clause", "opt_asc_desc", "tbName", "colName", YY_NULLPTR
+  "';'", "'='", "'('", "')'", "','", "'.'", "'<'", "'>'", "'*'", "$accept",
+  "start", "stmt", "txnStmt", "dbStmt", "ddl", "optBufferPool", "dml",
+  "fieldList", "colNameList", "field", "type", "valueList", "value",
+  "condition", "optWhereClause", "whereClause", "col", "colList", "op",
+  "expr", "setClauses", "setClause", "selector", "tableList",
+  "opt_order_clause", "order_clause", "opt_asc_desc", "tbName", "colName", YY_NULLPTR
 };
 
 static const char *
@@ -625,12 +635,12 @@ yysymbol_name (yysymbol_kind_t yysymbol)
 }
 #endif
 
-#define YYPACT_NINF (-75)
+#define YYPACT_NINF (-81)
 
 #define yypact_value_is_default(Yyn) \
   ((Yyn) == YYPACT_NINF)
 
-#define YYTABLE_NINF (-69)
+#define YYTABLE_NINF (-75)
 
 #define yytable_value_is_error(Yyn) \
   0
@@ -639,19 +649,21 @@ yysymbol_name (yysymbol_kind_t yysymbol)
    STATE-NUM.  */
 static const yytype_int8 yypact[] =
 {
-      42,    21,     5,     8,    -2,    32,    31,    -2,   -26,   -75,
-     -75,   -75,   -75,   -75,   -75,   -75,    52,     6,   -75,   -75,
-     -75,   -75,   -75,    -2,    -2,    -2,    -2,   -75,   -75,    -2,
-      -2,    34,    13,   -75,   -75,    16,    55,    39,   -75,   -75,
-     -75,    43,    44,   -75,    45,    78,    73,    53,    54,    -2,
-      53,    53,    53,    53,    50,    54,   -75,   -75,    -4,   -75,
-      51,   -75,    -7,   -75,   -75,   -11,   -75,    -5,    22,   -75,
-      33,    24,   -75,    74,    48,    53,   -75,    24,    -2,    -2,
-      85,   -75,    53,   -75,    58,   -75,   -75,   -75,    53,   -75,
-     -75,   -75,   -75,    36,   -75,    54,   -75,   -75,   -75,   -75,
-     -75,   -75,    17,   -75,   -75,   -75,   -75,    86,   -75,   -75,
-      63,   -75,   -75,    24,   -75,   -75,   -75,   -75,    54,    60,
-     -75,     1,   -75,   -75,   -75,   -75,   -75
+      92,     8,     3,     4,    -5,    25,    30,    -5,     6,   -33,
+     -81,   -81,   -81,   -81,   -81,   -81,   -81,    46,    11,   -81,
+     -81,   -81,   -81,   -81,    -5,    -5,    -5,    -5,    -5,    -5,
+     -81,   -81,    -5,    -5,    36,   -81,     5,    12,   -81,   -81,
+      31,    62,    32,   -81,   -81,   -81,    34,    37,    38,   -81,
+      40,   -81,    65,    63,     6,    47,    50,    -5,     6,     6,
+       6,    49,     6,    48,    50,   -81,   -14,   -81,    51,   -81,
+     -81,   -15,   -81,   -81,   -30,   -81,    44,   -26,   -81,    -6,
+      26,    29,   -81,    66,     2,     6,   -81,    29,    -5,    -5,
+      78,    60,     6,   -81,    58,   -81,   -81,    60,     6,   -81,
+      64,   -81,   -81,   -81,   -81,    28,   -81,    50,   -81,   -81,
+     -81,   -81,   -81,   -81,    23,   -81,   -81,   -81,   -81,    90,
+     -81,    -5,   -81,   -81,    67,   -81,   -81,    68,   -81,    29,
+     -81,   -81,   -81,   -81,    50,   -81,    69,   -81,   -81,     0,
+     -81,   -81,   -81,   -81,   -81
 };
 
 /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
@@ -659,113 +671,121 @@ static const yytype_int8 yypact[] =
    means the default is an error.  */
 static const yytype_int8 yydefact[] =
 {
-       0,     0,     0,     0,     0,     0,     0,     0,     0,     4,
-       3,    10,    11,    12,    13,     5,     0,     0,     9,     6,
-       7,     8,    14,     0,     0,     0,     0,    68,    17,     0,
-       0,     0,    69,    57,    44,    58,     0,     0,    43,     1,
-       2,     0,     0,    16,     0,     0,    38,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,    21,    69,    38,    54,
-       0,    45,    38,    59,    42,     0,    24,     0,     0,    26,
-       0,     0,    40,    39,     0,     0,    22,     0,     0,     0,
-      63,    15,     0,    29,     0,    31,    28,    18,     0,    19,
-      36,    34,    35,     0,    32,     0,    50,    49,    51,    46,
-      47,    48,     0,    55,    56,    61,    60,     0,    23,    25,
-       0,    27,    20,     0,    41,    52,    53,    37,     0,     0,
-      33,    67,    62,    30,    66,    65,    64
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       4,     3,    10,    11,    12,    13,     5,     0,     0,     9,
+       6,     7,     8,    14,     0,     0,     0,     0,     0,     0,
+      74,    18,     0,     0,     0,    75,     0,    75,    63,    50,
+      64,     0,     0,    49,     1,     2,     0,     0,     0,    17,
+       0,    23,     0,    44,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,    27,    44,    60,     0,    15,
+      51,    44,    65,    48,     0,    30,     0,     0,    32,     0,
+       0,     0,    46,    45,     0,     0,    28,     0,     0,     0,
+      69,    24,     0,    35,     0,    37,    34,    24,     0,    21,
+       0,    20,    42,    40,    41,     0,    38,     0,    56,    55,
+      57,    52,    53,    54,     0,    61,    62,    67,    66,     0,
+      29,     0,    16,    31,     0,    19,    33,     0,    26,     0,
+      47,    58,    59,    43,     0,    25,     0,    22,    39,    73,
+      68,    36,    72,    71,    70
 };
 
 /* YYPGOTO[NTERM-NUM].  */
 static const yytype_int8 yypgoto[] =
 {
-     -75,   -75,   -75,   -75,   -75,   -75,   -75,   -75,    56,    23,
-     -75,   -75,   -74,    11,   -27,   -75,    -8,   -75,   -75,   -75,
-     -75,    37,   -75,   -75,   -75,   -75,   -75,    -3,   -45
+     -81,   -81,   -81,   -81,   -81,   -81,    18,   -81,   -81,    54,
+      16,   -81,   -81,   -80,    10,   -53,   -81,    -9,   -81,   -81,
+     -81,   -81,    24,   -81,   -81,   -81,   -81,   -81,    -3,    -2
 };
 
 /* YYDEFGOTO[NTERM-NUM].  */
-static const yytype_int8 yydefgoto[] =
+static const yytype_uint8 yydefgoto[] =
 {
-       0,    16,    17,    18,    19,    20,    21,    65,    68,    66,
-      86,    93,    94,    72,    56,    73,    74,    35,   102,   117,
-      58,    59,    36,    62,   108,   122,   126,    37,    38
+       0,    17,    18,    19,    20,    21,   122,    22,    74,    77,
+      75,    96,   105,   106,    82,    65,    83,    84,    40,   114,
+     133,    66,    67,    41,    71,   120,   140,   144,    42,    43
 };
 
 /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
    positive, shift that token.  If negative, reduce the rule whose
    number is the opposite.  If YYTABLE_NINF, syntax error.  */
-static const yytype_int8 yytable[] =
+static const yytype_int16 yytable[] =
 {
-      34,    28,    60,   104,    31,    64,    67,    69,    69,   124,
-      55,    23,    32,    55,    25,   125,    83,    84,    85,    78,
-      41,    42,    43,    44,    33,    22,    45,    46,   115,    24,
-      60,    76,    26,    81,    82,    80,    27,    67,    79,   120,
-      61,    75,    29,   111,    30,     1,    63,     2,    40,     3,
-       4,     5,    39,    47,     6,    32,    90,    91,    92,   -68,
-       7,    48,     8,    90,    91,    92,    87,    88,    49,     9,
-      10,    11,    12,    13,    14,   105,   106,    89,    88,    15,
-     112,   113,    96,    97,    98,    50,    51,    52,    53,    54,
-      55,    57,    32,    71,   116,    99,   100,   101,    77,    95,
-     107,   110,   118,   119,   123,   109,   114,     0,     0,    70,
-     121,     0,   103
+      39,    31,    64,    64,    34,    37,    36,   116,   142,    24,
+      27,    88,    23,    86,   143,    91,    92,    38,    90,    97,
+      98,    46,    47,    48,    49,    50,    51,    25,    28,    52,
+      53,    89,    85,    30,   131,    32,   108,   109,   110,    99,
+     100,    26,    29,    33,    35,   111,    44,    70,    55,   138,
+     112,   113,    68,    45,    72,    54,    73,    76,    78,   -74,
+      78,    37,   102,   103,   104,    93,    94,    95,   102,   103,
+     104,   101,    98,   128,   129,    57,    63,    56,    59,    58,
+      64,    60,    61,    68,    62,   117,   118,    69,    37,    79,
+      76,   107,    81,   119,    87,     1,   126,     2,   121,     3,
+       4,     5,   124,   127,     6,   132,   134,   136,   123,   115,
+       7,     8,     9,   137,   141,   125,    80,   130,   135,    10,
+      11,    12,    13,    14,    15,   139,     0,     0,     0,    16
 };
 
-static const yytype_int8 yycheck[] =
+static const yytype_int16 yycheck[] =
 {
-       8,     4,    47,    77,     7,    50,    51,    52,    53,     8,
-      17,     6,    38,    17,     6,    14,    21,    22,    23,    26,
-      23,    24,    25,    26,    50,     4,    29,    30,   102,    24,
-      75,    58,    24,    44,    45,    62,    38,    82,    45,   113,
-      48,    45,    10,    88,    13,     3,    49,     5,    42,     7,
-       8,     9,     0,    19,    12,    38,    39,    40,    41,    46,
-      18,    45,    20,    39,    40,    41,    44,    45,    13,    27,
-      28,    29,    30,    31,    32,    78,    79,    44,    45,    37,
-      44,    45,    34,    35,    36,    46,    43,    43,    43,    11,
-      17,    38,    38,    43,   102,    47,    48,    49,    47,    25,
-      15,    43,    16,    40,    44,    82,    95,    -1,    -1,    53,
-     118,    -1,    75
+       9,     4,    17,    17,     7,    38,     8,    87,     8,     6,
+       6,    26,     4,    66,    14,    45,    46,    50,    71,    45,
+      46,    24,    25,    26,    27,    28,    29,    24,    24,    32,
+      33,    46,    46,    38,   114,    10,    34,    35,    36,    45,
+      46,    38,    38,    13,    38,    43,     0,    56,    43,   129,
+      48,    49,    54,    42,    57,    19,    58,    59,    60,    47,
+      62,    38,    39,    40,    41,    21,    22,    23,    39,    40,
+      41,    45,    46,    45,    46,    13,    11,    46,    44,    47,
+      17,    44,    44,    85,    44,    88,    89,    40,    38,    40,
+      92,    25,    44,    15,    43,     3,    98,     5,    38,     7,
+       8,     9,    44,    39,    12,   114,    16,    40,    92,    85,
+      18,    19,    20,    45,    45,    97,    62,   107,   121,    27,
+      28,    29,    30,    31,    32,   134,    -1,    -1,    -1,    37
 };
 
 /* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
    state STATE-NUM.  */
 static const yytype_int8 yystos[] =
 {
-       0,     3,     5,     7,     8,     9,    12,    18,    20,    27,
-      28,    29,    30,    31,    32,    37,    52,    53,    54,    55,
-      56,    57,     4,     6,    24,     6,    24,    38,    78,    10,
-      13,    78,    38,    50,    67,    68,    73,    78,    79,     0,
-      42,    78,    78,    78,    78,    78,    78,    19,    45,    13,
-      46,    43,    43,    43,    11,    17,    65,    38,    71,    72,
-      79,    67,    74,    78,    79,    58,    60,    79,    59,    79,
-      59,    43,    64,    66,    67,    45,    65,    47,    26,    45,
-      65,    44,    45,    21,    22,    23,    61,    44,    45,    44,
-      39,    40,    41,    62,    63,    25,    34,    35,    36,    47,
-      48,    49,    69,    72,    63,    78,    78,    15,    75,    60,
-      43,    79,    44,    45,    64,    63,    67,    70,    16,    40,
-      63,    67,    76,    44,     8,    14,    77
+       0,     3,     5,     7,     8,     9,    12,    18,    19,    20,
+      27,    28,    29,    30,    31,    32,    37,    52,    53,    54,
+      55,    56,    58,     4,     6,    24,    38,     6,    24,    38,
+      38,    79,    10,    13,    79,    38,    80,    38,    50,    68,
+      69,    74,    79,    80,     0,    42,    79,    79,    79,    79,
+      79,    79,    79,    79,    19,    43,    46,    13,    47,    44,
+      44,    44,    44,    11,    17,    66,    72,    73,    80,    40,
+      68,    75,    79,    80,    59,    61,    80,    60,    80,    40,
+      60,    44,    65,    67,    68,    46,    66,    43,    26,    46,
+      66,    45,    46,    21,    22,    23,    62,    45,    46,    45,
+      46,    45,    39,    40,    41,    63,    64,    25,    34,    35,
+      36,    43,    48,    49,    70,    73,    64,    79,    79,    15,
+      76,    38,    57,    61,    44,    57,    80,    39,    45,    46,
+      65,    64,    68,    71,    16,    79,    40,    45,    64,    68,
+      77,    45,     8,    14,    78
 };
 
 /* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
 static const yytype_int8 yyr1[] =
 {
        0,    51,    52,    52,    52,    52,    53,    53,    53,    53,
-      54,    54,    54,    54,    55,    56,    56,    56,    56,    56,
-      57,    57,    57,    57,    58,    58,    59,    59,    60,    61,
-      61,    61,    62,    62,    63,    63,    63,    64,    65,    65,
-      66,    66,    67,    67,    68,    68,    69,    69,    69,    69,
-      69,    69,    70,    70,    71,    71,    72,    73,    73,    74,
-      74,    74,    75,    75,    76,    77,    77,    77,    78,    79
+      54,    54,    54,    54,    55,    55,    56,    56,    56,    56,
+      56,    56,    56,    56,    57,    57,    58,    58,    58,    58,
+      59,    59,    60,    60,    61,    62,    62,    62,    63,    63,
+      64,    64,    64,    65,    66,    66,    67,    67,    68,    68,
+      69,    69,    70,    70,    70,    70,    70,    70,    71,    71,
+      72,    72,    73,    74,    74,    75,    75,    75,    76,    76,
+      77,    78,    78,    78,    79,    80
 };
 
 /* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
 static const yytype_int8 yyr2[] =
 {
        0,     2,     2,     1,     1,     1,     1,     1,     1,     1,
-       1,     1,     1,     1,     2,     6,     3,     2,     6,     6,
-       7,     4,     5,     6,     1,     3,     1,     3,     2,     1,
-       4,     1,     1,     3,     1,     1,     1,     3,     0,     2,
-       1,     3,     3,     1,     1,     3,     1,     1,     1,     1,
-       1,     1,     1,     1,     1,     3,     3,     1,     1,     1,
-       3,     3,     3,     0,     2,     1,     1,     0,     1,     1
+       1,     1,     1,     1,     2,     4,     7,     3,     2,     7,
+       6,     6,     8,     3,     0,     2,     7,     4,     5,     6,
+       1,     3,     1,     3,     2,     1,     4,     1,     1,     3,
+       1,     1,     1,     3,     0,     2,     1,     3,     3,     1,
+       1,     3,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     3,     3,     1,     1,     1,     3,     3,     3,     0,
+       2,     1,     1,     0,     1,     1
 };
 
 
@@ -1621,489 +1641,553 @@ yyreduce:
   switch (yyn)
     {
   case 2: /* start: stmt ';'  */
-#line 57 "/root/UniBase/src/parser/yacc.y"
+#line 65 "/root/UniBase/src/parser/yacc.y"
     {
         parse_tree = (yyvsp[-1].sv_node);
         YYACCEPT;
     }
-#line 1630 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 1650 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
   case 3: /* start: HELP  */
-#line 62 "/root/UniBase/src/parser/yacc.y"
+#line 70 "/root/UniBase/src/parser/yacc.y"
     {
         parse_tree = std::make_shared<Help>();
         YYACCEPT;
     }
-#line 1639 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 1659 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
   case 4: /* start: EXIT  */
-#line 67 "/root/UniBase/src/parser/yacc.y"
+#line 75 "/root/UniBase/src/parser/yacc.y"
     {
         parse_tree = nullptr;
         YYACCEPT;
     }
-#line 1648 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 1668 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
   case 5: /* start: T_EOF  */
-#line 72 "/root/UniBase/src/parser/yacc.y"
+#line 80 "/root/UniBase/src/parser/yacc.y"
     {
         parse_tree = nullptr;
         YYACCEPT;
     }
-#line 1657 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 1677 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
   case 10: /* txnStmt: TXN_BEGIN  */
-#line 87 "/root/UniBase/src/parser/yacc.y"
+#line 95 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnBegin>();
     }
-#line 1665 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 1685 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
   case 11: /* txnStmt: TXN_COMMIT  */
-#line 91 "/root/UniBase/src/parser/yacc.y"
+#line 99 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnCommit>();
     }
-#line 1673 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 1693 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
   case 12: /* txnStmt: TXN_ABORT  */
-#line 95 "/root/UniBase/src/parser/yacc.y"
+#line 103 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnAbort>();
     }
-#line 1681 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 1701 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
   case 13: /* txnStmt: TXN_ROLLBACK  */
-#line 99 "/root/UniBase/src/parser/yacc.y"
+#line 107 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnRollback>();
     }
-#line 1689 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 1709 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
   case 14: /* dbStmt: SHOW TABLES  */
-#line 106 "/root/UniBase/src/parser/yacc.y"
+#line 114 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<ShowTables>();
     }
-#line 1697 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 1717 "/root/UniBase/src/parser/yacc.tab.cpp"
+    break;
+
+  case 15: /* dbStmt: SET colName '=' VALUE_INT  */
+#line 118 "/root/UniBase/src/parser/yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<SetParameter>((yyvsp[-2].sv_str), (yyvsp[0].sv_int));
+    }
+#line 1725 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 15: /* ddl: CREATE TABLE tbName '(' fieldList ')'  */
-#line 113 "/root/UniBase/src/parser/yacc.y"
+  case 16: /* ddl: CREATE TABLE tbName '(' fieldList ')' optBufferPool  */
+#line 125 "/root/UniBase/src/parser/yacc.y"
     {
-        (yyval.sv_node) = std::make_shared<CreateTable>((yyvsp[-3].sv_str), (yyvsp[-1].sv_fields));
+        (yyval.sv_node) = std::make_shared<CreateTable>((yyvsp[-4].sv_str), (yyvsp[-2].sv_fields), (yyvsp[0].sv_str));
     }
-#line 1705 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 1733 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 16: /* ddl: DROP TABLE tbName  */
-#line 117 "/root/UniBase/src/parser/yacc.y"
+  case 17: /* ddl: DROP TABLE tbName  */
+#line 129 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<DropTable>((yyvsp[0].sv_str));
     }
-#line 1713 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 1741 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 17: /* ddl: DESC tbName  */
-#line 121 "/root/UniBase/src/parser/yacc.y"
+  case 18: /* ddl: DESC tbName  */
+#line 133 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<DescTable>((yyvsp[0].sv_str));
     }
-#line 1721 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 1749 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 18: /* ddl: CREATE INDEX tbName '(' colNameList ')'  */
-#line 125 "/root/UniBase/src/parser/yacc.y"
+  case 19: /* ddl: CREATE INDEX tbName '(' colNameList ')' optBufferPool  */
+#line 137 "/root/UniBase/src/parser/yacc.y"
     {
-        (yyval.sv_node) = std::make_shared<CreateIndex>((yyvsp[-3].sv_str), (yyvsp[-1].sv_strs));
+        (yyval.sv_node) = std::make_shared<CreateIndex>((yyvsp[-4].sv_str), (yyvsp[-2].sv_strs), (yyvsp[0].sv_str));
     }
-#line 1729 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 1757 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 19: /* ddl: DROP INDEX tbName '(' colNameList ')'  */
-#line 129 "/root/UniBase/src/parser/yacc.y"
+  case 20: /* ddl: DROP INDEX tbName '(' colNameList ')'  */
+#line 141 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<DropIndex>((yyvsp[-3].sv_str), (yyvsp[-1].sv_strs));
     }
-#line 1737 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 1765 "/root/UniBase/src/parser/yacc.tab.cpp"
+    break;
+
+  case 21: /* ddl: CREATE IDENTIFIER tbName '(' VALUE_INT ')'  */
+#line 145 "/root/UniBase/src/parser/yacc.y"
+    {
+        if (!is_buffer_pool_keyword((yyvsp[-4].sv_str))) {
+            yyerror(&(yylsp[-4]), "syntax error, expected BUFFER_POOL");
+            YYERROR;
+        }
+        (yyval.sv_node) = std::make_shared<CreateBufferPool>((yyvsp[-3].sv_str), (yyvsp[-1].sv_int));
+    }
+#line 1777 "/root/UniBase/src/parser/yacc.tab.cpp"
+    break;
+
+  case 22: /* ddl: CREATE IDENTIFIER tbName '(' VALUE_INT ',' VALUE_STRING ')'  */
+#line 153 "/root/UniBase/src/parser/yacc.y"
+    {
+        if (!is_buffer_pool_keyword((yyvsp[-6].sv_str))) {
+            yyerror(&(yylsp[-6]), "syntax error, expected BUFFER_POOL");
+            YYERROR;
+        }
+        (yyval.sv_node) = std::make_shared<CreateBufferPool>((yyvsp[-5].sv_str), (yyvsp[-3].sv_int), (yyvsp[-1].sv_str));
+    }
+#line 1789 "/root/UniBase/src/parser/yacc.tab.cpp"
+    break;
+
+  case 23: /* ddl: DROP IDENTIFIER tbName  */
+#line 161 "/root/UniBase/src/parser/yacc.y"
+    {
+        if (!is_buffer_pool_keyword((yyvsp[-1].sv_str))) {
+            yyerror(&(yylsp[-1]), "syntax error, expected BUFFER_POOL");
+            YYERROR;
+        }
+        (yyval.sv_node) = std::make_shared<DropBufferPool>((yyvsp[0].sv_str));
+    }
+#line 1801 "/root/UniBase/src/parser/yacc.tab.cpp"
+    break;
+
+  case 24: /* optBufferPool: %empty  */
+#line 172 "/root/UniBase/src/parser/yacc.y"
+    {
+        (yyval.sv_str) = "";
+    }
+#line 1809 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 20: /* dml: INSERT INTO tbName VALUES '(' valueList ')'  */
-#line 136 "/root/UniBase/src/parser/yacc.y"
+  case 25: /* optBufferPool: IDENTIFIER tbName  */
+#line 176 "/root/UniBase/src/parser/yacc.y"
+    {
+        if (!is_buffer_pool_keyword((yyvsp[-1].sv_str))) {
+            yyerror(&(yylsp[-1]), "syntax error, expected BUFFER_POOL");
+            YYERROR;
+        }
+        (yyval.sv_str) = (yyvsp[0].sv_str);
+    }
+#line 1821 "/root/UniBase/src/parser/yacc.tab.cpp"
+    break;
+
+  case 26: /* dml: INSERT INTO tbName VALUES '(' valueList ')'  */
+#line 187 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<InsertStmt>((yyvsp[-4].sv_str), (yyvsp[-1].sv_vals));
     }
-#line 1745 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 1829 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 21: /* dml: DELETE FROM tbName optWhereClause  */
-#line 140 "/root/UniBase/src/parser/yacc.y"
+  case 27: /* dml: DELETE FROM tbName optWhereClause  */
+#line 191 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<DeleteStmt>((yyvsp[-1].sv_str), (yyvsp[0].sv_conds));
     }
-#line 1753 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 1837 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 22: /* dml: UPDATE tbName SET setClauses optWhereClause  */
-#line 144 "/root/UniBase/src/parser/yacc.y"
+  case 28: /* dml: UPDATE tbName SET setClauses optWhereClause  */
+#line 195 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<UpdateStmt>((yyvsp[-3].sv_str), (yyvsp[-1].sv_set_clauses), (yyvsp[0].sv_conds));
     }
-#line 1761 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 1845 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 23: /* dml: SELECT selector FROM tableList optWhereClause opt_order_clause  */
-#line 148 "/root/UniBase/src/parser/yacc.y"
+  case 29: /* dml: SELECT selector FROM tableList optWhereClause opt_order_clause  */
+#line 199 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<SelectStmt>((yyvsp[-4].sv_cols), (yyvsp[-2].sv_strs), (yyvsp[-1].sv_conds), (yyvsp[0].sv_orderby));
     }
-#line 1769 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 1853 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 24: /* fieldList: field  */
-#line 155 "/root/UniBase/src/parser/yacc.y"
+  case 30: /* fieldList: field  */
+#line 206 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_fields) = std::vector<std::shared_ptr<Field>>{(yyvsp[0].sv_field)};
     }
-#line 1777 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 1861 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 25: /* fieldList: fieldList ',' field  */
-#line 159 "/root/UniBase/src/parser/yacc.y"
+  case 31: /* fieldList: fieldList ',' field  */
+#line 210 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_fields).push_back((yyvsp[0].sv_field));
     }
-#line 1785 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 1869 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 26: /* colNameList: colName  */
-#line 166 "/root/UniBase/src/parser/yacc.y"
+  case 32: /* colNameList: colName  */
+#line 217 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_strs) = std::vector<std::string>{(yyvsp[0].sv_str)};
     }
-#line 1793 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 1877 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 27: /* colNameList: colNameList ',' colName  */
-#line 170 "/root/UniBase/src/parser/yacc.y"
+  case 33: /* colNameList: colNameList ',' colName  */
+#line 221 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_strs).push_back((yyvsp[0].sv_str));
     }
-#line 1801 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 1885 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 28: /* field: colName type  */
-#line 177 "/root/UniBase/src/parser/yacc.y"
+  case 34: /* field: colName type  */
+#line 228 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_field) = std::make_shared<ColDef>((yyvsp[-1].sv_str), (yyvsp[0].sv_type_len));
     }
-#line 1809 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 1893 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 29: /* type: INT  */
-#line 184 "/root/UniBase/src/parser/yacc.y"
+  case 35: /* type: INT  */
+#line 235 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_INT, sizeof(int));
     }
-#line 1817 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 1901 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 30: /* type: CHAR '(' VALUE_INT ')'  */
-#line 188 "/root/UniBase/src/parser/yacc.y"
+  case 36: /* type: CHAR '(' VALUE_INT ')'  */
+#line 239 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_STRING, (yyvsp[-1].sv_int));
     }
-#line 1825 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 1909 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 31: /* type: FLOAT  */
-#line 192 "/root/UniBase/src/parser/yacc.y"
+  case 37: /* type: FLOAT  */
+#line 243 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_FLOAT, sizeof(float));
     }
-#line 1833 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 1917 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 32: /* valueList: value  */
-#line 199 "/root/UniBase/src/parser/yacc.y"
+  case 38: /* valueList: value  */
+#line 250 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_vals) = std::vector<std::shared_ptr<Value>>{(yyvsp[0].sv_val)};
     }
-#line 1841 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 1925 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 33: /* valueList: valueList ',' value  */
-#line 203 "/root/UniBase/src/parser/yacc.y"
+  case 39: /* valueList: valueList ',' value  */
+#line 254 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_vals).push_back((yyvsp[0].sv_val));
     }
-#line 1849 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 1933 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 34: /* value: VALUE_INT  */
-#line 210 "/root/UniBase/src/parser/yacc.y"
+  case 40: /* value: VALUE_INT  */
+#line 261 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_val) = std::make_shared<IntLit>((yyvsp[0].sv_int));
     }
-#line 1857 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 1941 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 35: /* value: VALUE_FLOAT  */
-#line 214 "/root/UniBase/src/parser/yacc.y"
+  case 41: /* value: VALUE_FLOAT  */
+#line 265 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_val) = std::make_shared<FloatLit>((yyvsp[0].sv_float));
     }
-#line 1865 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 1949 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 36: /* value: VALUE_STRING  */
-#line 218 "/root/UniBase/src/parser/yacc.y"
+  case 42: /* value: VALUE_STRING  */
+#line 269 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_val) = std::make_shared<StringLit>((yyvsp[0].sv_str));
     }
-#line 1873 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 1957 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 37: /* condition: col op expr  */
-#line 225 "/root/UniBase/src/parser/yacc.y"
+  case 43: /* condition: col op expr  */
+#line 276 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_cond) = std::make_shared<BinaryExpr>((yyvsp[-2].sv_col), (yyvsp[-1].sv_comp_op), (yyvsp[0].sv_expr));
     }
-#line 1881 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 1965 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 38: /* optWhereClause: %empty  */
-#line 231 "/root/UniBase/src/parser/yacc.y"
+  case 44: /* optWhereClause: %empty  */
+#line 282 "/root/UniBase/src/parser/yacc.y"
                       { /* ignore*/ }
-#line 1887 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 1971 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 39: /* optWhereClause: WHERE whereClause  */
-#line 233 "/root/UniBase/src/parser/yacc.y"
+  case 45: /* optWhereClause: WHERE whereClause  */
+#line 284 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_conds) = (yyvsp[0].sv_conds);
     }
-#line 1895 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 1979 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 40: /* whereClause: condition  */
-#line 240 "/root/UniBase/src/parser/yacc.y"
+  case 46: /* whereClause: condition  */
+#line 291 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_conds) = std::vector<std::shared_ptr<BinaryExpr>>{(yyvsp[0].sv_cond)};
     }
-#line 1903 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 1987 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 41: /* whereClause: whereClause AND condition  */
-#line 244 "/root/UniBase/src/parser/yacc.y"
+  case 47: /* whereClause: whereClause AND condition  */
+#line 295 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_conds).push_back((yyvsp[0].sv_cond));
     }
-#line 1911 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 1995 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 42: /* col: tbName '.' colName  */
-#line 251 "/root/UniBase/src/parser/yacc.y"
+  case 48: /* col: tbName '.' colName  */
+#line 302 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_col) = std::make_shared<Col>((yyvsp[-2].sv_str), (yyvsp[0].sv_str));
     }
-#line 1919 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 2003 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 43: /* col: colName  */
-#line 255 "/root/UniBase/src/parser/yacc.y"
+  case 49: /* col: colName  */
+#line 306 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_col) = std::make_shared<Col>("", (yyvsp[0].sv_str));
     }
-#line 1927 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 2011 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 44: /* colList: col  */
-#line 262 "/root/UniBase/src/parser/yacc.y"
+  case 50: /* colList: col  */
+#line 313 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_cols) = std::vector<std::shared_ptr<Col>>{(yyvsp[0].sv_col)};
     }
-#line 1935 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 2019 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 45: /* colList: colList ',' col  */
-#line 266 "/root/UniBase/src/parser/yacc.y"
+  case 51: /* colList: colList ',' col  */
+#line 317 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_cols).push_back((yyvsp[0].sv_col));
     }
-#line 1943 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 2027 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 46: /* op: '='  */
-#line 273 "/root/UniBase/src/parser/yacc.y"
+  case 52: /* op: '='  */
+#line 324 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_EQ;
     }
-#line 1951 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 2035 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 47: /* op: '<'  */
-#line 277 "/root/UniBase/src/parser/yacc.y"
+  case 53: /* op: '<'  */
+#line 328 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_LT;
     }
-#line 1959 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 2043 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 48: /* op: '>'  */
-#line 281 "/root/UniBase/src/parser/yacc.y"
+  case 54: /* op: '>'  */
+#line 332 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_GT;
     }
-#line 1967 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 2051 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 49: /* op: NEQ  */
-#line 285 "/root/UniBase/src/parser/yacc.y"
+  case 55: /* op: NEQ  */
+#line 336 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_NE;
     }
-#line 1975 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 2059 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 50: /* op: LEQ  */
-#line 289 "/root/UniBase/src/parser/yacc.y"
+  case 56: /* op: LEQ  */
+#line 340 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_LE;
     }
-#line 1983 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 2067 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 51: /* op: GEQ  */
-#line 293 "/root/UniBase/src/parser/yacc.y"
+  case 57: /* op: GEQ  */
+#line 344 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_GE;
     }
-#line 1991 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 2075 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 52: /* expr: value  */
-#line 300 "/root/UniBase/src/parser/yacc.y"
+  case 58: /* expr: value  */
+#line 351 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_expr) = std::static_pointer_cast<Expr>((yyvsp[0].sv_val));
     }
-#line 1999 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 2083 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 53: /* expr: col  */
-#line 304 "/root/UniBase/src/parser/yacc.y"
+  case 59: /* expr: col  */
+#line 355 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_expr) = std::static_pointer_cast<Expr>((yyvsp[0].sv_col));
     }
-#line 2007 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 2091 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 54: /* setClauses: setClause  */
-#line 311 "/root/UniBase/src/parser/yacc.y"
+  case 60: /* setClauses: setClause  */
+#line 362 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_set_clauses) = std::vector<std::shared_ptr<SetClause>>{(yyvsp[0].sv_set_clause)};
     }
-#line 2015 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 2099 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 55: /* setClauses: setClauses ',' setClause  */
-#line 315 "/root/UniBase/src/parser/yacc.y"
+  case 61: /* setClauses: setClauses ',' setClause  */
+#line 366 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_set_clauses).push_back((yyvsp[0].sv_set_clause));
     }
-#line 2023 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 2107 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 56: /* setClause: colName '=' value  */
-#line 322 "/root/UniBase/src/parser/yacc.y"
+  case 62: /* setClause: colName '=' value  */
+#line 373 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_set_clause) = std::make_shared<SetClause>((yyvsp[-2].sv_str), (yyvsp[0].sv_val));
     }
-#line 2031 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 2115 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 57: /* selector: '*'  */
-#line 329 "/root/UniBase/src/parser/yacc.y"
+  case 63: /* selector: '*'  */
+#line 380 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_cols) = {};
     }
-#line 2039 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 2123 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 59: /* tableList: tbName  */
-#line 337 "/root/UniBase/src/parser/yacc.y"
+  case 65: /* tableList: tbName  */
+#line 388 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_strs) = std::vector<std::string>{(yyvsp[0].sv_str)};
     }
-#line 2047 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 2131 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 60: /* tableList: tableList ',' tbName  */
-#line 341 "/root/UniBase/src/parser/yacc.y"
+  case 66: /* tableList: tableList ',' tbName  */
+#line 392 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_strs).push_back((yyvsp[0].sv_str));
     }
-#line 2055 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 2139 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 61: /* tableList: tableList JOIN tbName  */
-#line 345 "/root/UniBase/src/parser/yacc.y"
+  case 67: /* tableList: tableList JOIN tbName  */
+#line 396 "/root/UniBase/src/parser/yacc.y"
     {
         (yyval.sv_strs).push_back((yyvsp[0].sv_str));
     }
-#line 2063 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 2147 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 62: /* opt_order_clause: ORDER BY order_clause  */
-#line 352 "/root/UniBase/src/parser/yacc.y"
+  case 68: /* opt_order_clause: ORDER BY order_clause  */
+#line 403 "/root/UniBase/src/parser/yacc.y"
     { 
         (yyval.sv_orderby) = (yyvsp[0].sv_orderby); 
     }
-#line 2071 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 2155 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 63: /* opt_order_clause: %empty  */
-#line 355 "/root/UniBase/src/parser/yacc.y"
+  case 69: /* opt_order_clause: %empty  */
+#line 406 "/root/UniBase/src/parser/yacc.y"
                       { /* ignore*/ }
-#line 2077 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 2161 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 64: /* order_clause: col opt_asc_desc  */
-#line 360 "/root/UniBase/src/parser/yacc.y"
+  case 70: /* order_clause: col opt_asc_desc  */
+#line 411 "/root/UniBase/src/parser/yacc.y"
     { 
         (yyval.sv_orderby) = std::make_shared<OrderBy>((yyvsp[-1].sv_col), (yyvsp[0].sv_orderby_dir));
     }
-#line 2085 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 2169 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 65: /* opt_asc_desc: ASC  */
-#line 366 "/root/UniBase/src/parser/yacc.y"
+  case 71: /* opt_asc_desc: ASC  */
+#line 417 "/root/UniBase/src/parser/yacc.y"
                  { (yyval.sv_orderby_dir) = OrderBy_ASC;     }
-#line 2091 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 2175 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 66: /* opt_asc_desc: DESC  */
-#line 367 "/root/UniBase/src/parser/yacc.y"
+  case 72: /* opt_asc_desc: DESC  */
+#line 418 "/root/UniBase/src/parser/yacc.y"
                  { (yyval.sv_orderby_dir) = OrderBy_DESC;    }
-#line 2097 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 2181 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
-  case 67: /* opt_asc_desc: %empty  */
-#line 368 "/root/UniBase/src/parser/yacc.y"
+  case 73: /* opt_asc_desc: %empty  */
+#line 419 "/root/UniBase/src/parser/yacc.y"
             { (yyval.sv_orderby_dir) = OrderBy_DEFAULT; }
-#line 2103 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 2187 "/root/UniBase/src/parser/yacc.tab.cpp"
     break;
 
 
-#line 2107 "/root/UniBase/src/parser/yacc.tab.cpp"
+#line 2191 "/root/UniBase/src/parser/yacc.tab.cpp"
 
       default: break;
     }
@@ -2332,5 +2416,5 @@ yyreturnlab:
   return yyresult;
 }
 
-#line 374 "/root/UniBase/src/parser/yacc.y"
+#line 425 "/root/UniBase/src/parser/yacc.y"
 
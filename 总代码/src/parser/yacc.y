@@ -1,6 +1,7 @@
 %{
 #include "ast.h"
 #include "yacc.tab.h"
+#include <algorithm>
 #include <iostream>
 #include <memory>
 
@@ -10,6 +11,13 @@ void yyerror(YYLTYPE *locp, const char* s) {
     std::cerr << "Parser Error at line " << locp->first_line << " column " << locp->first_column << ": " << s << std::endl;
 }
 
+// BUFFER_POOL不是保留字，在语法动作中按标识符判断(不区分大小写)
+static bool is_buffer_pool_keyword(const std::string &word) {
+    static const std::string keyword = "BUFFER_POOL";
+    return word.size() == keyword.size() &&
+           std::equal(word.begin(), word.end(), keyword.begin(), [](char a, char b) { return toupper(a) == b; });
+}
+
 using namespace ast;
 %}
 
@@ -40,7 +48,7 @@ WHERE UPDATE SET SELECT INT CHAR FLOAT INDEX AND JOIN EXIT HELP TXN_BEGIN TXN_CO
 %type <sv_expr> expr
 %type <sv_val> value
 %type <sv_vals> valueList
-%type <sv_str> tbName colName
+%type <sv_str> tbName colName optBufferPool
 %type <sv_strs> tableList colNameList
 %type <sv_col> col
 %type <sv_cols> colList selector
@@ -106,12 +114,16 @@ dbStmt:
     {
         $$ = std::make_shared<ShowTables>();
     }
+    |   SET colName '=' VALUE_INT
+    {
+        $$ = std::make_shared<SetParameter>($2, $4);
+    }
     ;
 
 ddl:
-        CREATE TABLE tbName '(' fieldList ')'
+        CREATE TABLE tbName '(' fieldList ')' optBufferPool
     {
-        $$ = std::make_shared<CreateTable>($3, $5);
+        $$ = std::make_shared<CreateTable>($3, $5, $7);
     }
     |   DROP TABLE tbName
     {
@@ -121,14 +133,53 @@ ddl:
     {
         $$ = std::make_shared<DescTable>($2);
     }
-    |   CREATE INDEX tbName '(' colNameList ')'
+    |   CREATE INDEX tbName '(' colNameList ')' optBufferPool
     {
-        $$ = std::make_shared<CreateIndex>($3, $5);
+        $$ = std::make_shared<CreateIndex>($3, $5, $7);
     }
     |   DROP INDEX tbName '(' colNameList ')'
     {
         $$ = std::make_shared<DropIndex>($3, $5);
     }
+    |   CREATE IDENTIFIER tbName '(' VALUE_INT ')'
+    {
+        if (!is_buffer_pool_keyword($2)) {
+            yyerror(&@2, "syntax error, expected BUFFER_POOL");
+            YYERROR;
+        }
+        $$ = std::make_shared<CreateBufferPool>($3, $5);
+    }
+    |   CREATE IDENTIFIER tbName '(' VALUE_INT ',' VALUE_STRING ')'
+    {
+        if (!is_buffer_pool_keyword($2)) {
+            yyerror(&@2, "syntax error, expected BUFFER_POOL");
+            YYERROR;
+        }
+        $$ = std::make_shared<CreateBufferPool>($3, $5, $7);
+    }
+    |   DROP IDENTIFIER tbName
+    {
+        if (!is_buffer_pool_keyword($2)) {
+            yyerror(&@2, "syntax error, expected BUFFER_POOL");
+            YYERROR;
+        }
+        $$ = std::make_shared<DropBufferPool>($3);
+    }
+    ;
+
+optBufferPool:
+        /* epsilon */
+    {
+        $$ = "";
+    }
+    |   IDENTIFIER tbName
+    {
+        if (!is_buffer_pool_keyword($1)) {
+            yyerror(&@1, "syntax error, expected BUFFER_POOL");
+            YYERROR;
+        }
+        $$ = $2;
+    }
     ;
 
 dml:
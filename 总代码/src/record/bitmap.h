@@ -1,10 +1,14 @@
 #pragma once
 
+#include <endian.h>
+
 #include <cinttypes>
 #include <cstring>
 
 static constexpr int BITMAP_WIDTH = 8;
 static constexpr unsigned BITMAP_HIGHEST_BIT = 0x80u;  // 128 (2^7)
+static constexpr int BITMAP_WORD_BITS = 64;  // 按字查找时每次检查的位数
+static constexpr uint64_t BITMAP_WORD_HIGHEST_BIT = 1ULL << 63;
 
 class Bitmap {
    public:
@@ -21,7 +25,7 @@ class Bitmap {
     static bool is_set(const char *bm, int pos) { return (bm[get_bucket(pos)] & get_bit(pos)) != 0; }
 
     /**
-     * @brief 找下一个为0 or 1的位
+     * @brief 找下一个为0 or 1的位，每次检查64位的字
      * @param bit false表示要找下一个为0的位，true表示要找下一个为1的位
      * @param bm 要找的起始地址为bm
      * @param max_n 要找的从起始地址开始的偏移为[curr+1,max_n)
@@ -29,12 +33,55 @@ class Bitmap {
      * @return 找到了就返回偏移位置，没找到就返回max_n
      */
     static int next_bit(bool bit, const char *bm, int max_n, int curr) {
-        for (int i = curr + 1; i < max_n; i++) {
-            if (is_set(bm, i) == bit) {
-                return i;
+        int pos = curr + 1;
+        if (pos >= max_n) {
+            return max_n;
+        }
+        int num_bytes = get_bucket(max_n + BITMAP_WIDTH - 1);
+        int word_start = pos / BITMAP_WORD_BITS * BITMAP_WORD_BITS;
+        uint64_t word = load_word(bm, word_start, num_bytes, bit);
+        word &= ~0ULL >> (pos - word_start);  // 去掉pos之前的位
+        while (word == 0) {
+            word_start += BITMAP_WORD_BITS;
+            if (word_start >= max_n) {
+                return max_n;
             }
+            word = load_word(bm, word_start, num_bytes, bit);
+        }
+        // 超出max_n的位在找0时也会被当成找到，截断为max_n
+        int found = word_start + __builtin_clzll(word);
+        return found < max_n ? found : max_n;
+    }
+
+    /**
+     * @brief 按升序取出[0,max_n)中所有为1的位的偏移
+     * @param bm 起始地址
+     * @param max_n 位的个数
+     * @param out 存放偏移，至少要能存放count(bm, max_n)个
+     * @return 为1的位的个数
+     */
+    static int get_set_bits(const char *bm, int max_n, int *out) {
+        int num_bytes = get_bucket(max_n + BITMAP_WIDTH - 1);
+        int n = 0;
+        for (int word_start = 0; word_start < max_n; word_start += BITMAP_WORD_BITS) {
+            uint64_t word = load_word(bm, word_start, num_bytes, true) & tail_mask(word_start, max_n);
+            while (word != 0) {
+                int lead = __builtin_clzll(word);
+                out[n++] = word_start + lead;
+                word ^= BITMAP_WORD_HIGHEST_BIT >> lead;
+            }
+        }
+        return n;
+    }
+
+    // [0,max_n)中为1的位的个数
+    static int count(const char *bm, int max_n) {
+        int num_bytes = get_bucket(max_n + BITMAP_WIDTH - 1);
+        int n = 0;
+        for (int word_start = 0; word_start < max_n; word_start += BITMAP_WORD_BITS) {
+            n += __builtin_popcountll(load_word(bm, word_start, num_bytes, true) & tail_mask(word_start, max_n));
         }
-        return max_n;
+        return n;
     }
 
     // 找第一个为0 or 1的位
@@ -45,6 +92,29 @@ class Bitmap {
     // rid_.slot_no); int slot_no = Bitmap::first_bit(false, page_handle.bitmap, file_hdr_.num_records_per_page);
 
    private:
+    /**
+     * @brief 读出从第word_start位开始的64位，第word_start位放在字的最高位，与位在字节中的顺序一致
+     * @param num_bytes bitmap的字节数，超出的部分按0读出，不会越界读取
+     * @param bit 为false时取反，找0的位变为找1的位
+     */
+    static uint64_t load_word(const char *bm, int word_start, int num_bytes, bool bit) {
+        int byte = get_bucket(word_start);
+        uint64_t word = 0;
+        if (num_bytes - byte >= static_cast<int>(sizeof(word))) {
+            memcpy(&word, bm + byte, sizeof(word));
+        } else {
+            memcpy(&word, bm + byte, num_bytes - byte);
+        }
+        word = be64toh(word);
+        return bit ? word : ~word;
+    }
+
+    // 去掉字中超出max_n的位
+    static uint64_t tail_mask(int word_start, int max_n) {
+        int valid = max_n - word_start;
+        return valid >= BITMAP_WORD_BITS ? ~0ULL : ~(~0ULL >> valid);
+    }
+
     static int get_bucket(int pos) { return pos / BITMAP_WIDTH; }
 
     static char get_bit(int pos) { return BITMAP_HIGHEST_BIT >> static_cast<char>(pos % BITMAP_WIDTH); }
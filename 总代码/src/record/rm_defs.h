@@ -79,4 +79,44 @@ struct RmRecord {
         allocated_ = false;
         data = nullptr;
     }
+
+    // 不分配空间也不复制，只引用data_，由调用者保证data_在记录使用期间有效(如指向被固定的缓冲池帧)
+    static std::unique_ptr<RmRecord> borrow(int size_, const char* data_) {
+        auto rec = std::make_unique<RmRecord>();
+        rec->size = size_;
+        rec->data = const_cast<char*>(data_);
+        return rec;
+    }
+};
+
+/* 记录的只读视图，直接指向缓冲池帧中的记录，不分配空间也不复制。
+   视图持有记录所在页面的读保护(固定并加共享锁)，析构时自动释放；释放页面后还要使用记录时用to_record()复制出来 */
+class RecordView {
+   public:
+    RecordView() = default;
+
+    RecordView(ReadPageGuard guard, const char* data, int size) : guard_(std::move(guard)), data_(data), size_(size) {}
+
+    bool is_valid() const { return data_ != nullptr; }
+
+    const char* data() const { return data_; }
+
+    int size() const { return size_; }
+
+    // 复制出一条拥有数据的记录，之后与页面无关
+    std::unique_ptr<RmRecord> to_record() const { return std::make_unique<RmRecord>(size_, const_cast<char*>(data_)); }
+
+    // 引用视图中数据的记录，只在视图被释放之前有效
+    std::unique_ptr<RmRecord> as_record() const { return RmRecord::borrow(size_, data_); }
+
+    void drop() {
+        guard_.drop();
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+   private:
+    ReadPageGuard guard_;
+    const char* data_ = nullptr;
+    int size_ = 0;
 };
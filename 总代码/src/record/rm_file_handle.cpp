@@ -11,22 +11,41 @@ std::unique_ptr<RmRecord> RmFileHandle::get_record(const Rid& rid, Context* cont
     // 1. 获取指定记录所在的page handle
     // 2. 初始化一个指向RmRecord的指针（赋值其内部的data和size）
     assert(is_record(rid) && "Attempting to read a non-existing record!");
-    RmPageHandle page_handle = fetch_page_handle(rid.page_no);
-    char* record_data = page_handle.get_slot(rid.slot_no);
-    auto rec = std::make_unique<RmRecord>();
-    rec->size = file_hdr_.record_size;
-    rec->data = new char[file_hdr_.record_size];
-    memcpy(rec->data, record_data, file_hdr_.record_size);
+    auto rec = std::make_unique<RmRecord>(file_hdr_.record_size);
+    // 点查询不加页面锁复制记录，复制期间页面被修改过时重新复制。
+    // 通过swizzle引用得到的页面没有被固定，验证失败时帧中可能已换成其他页面，因此重新获取页面
+    while (true) {
+        OptimisticPageGuard guard = fetch_page_optimistic(rid.page_no);
+        RmPageHandle page_handle(&file_hdr_, guard.get_page());
+        memcpy(rec->data, page_handle.get_slot(rid.slot_no), file_hdr_.record_size);
+        if (guard.validate()) {
+            break;
+        }
+    }
     return rec;
 }
 
+/**
+ * @description: 获取当前表中记录号为rid的记录的只读视图，不分配空间也不复制，需要拥有记录时使用get_record()
+ * @param {Rid&} rid 记录号，指定记录的位置
+ * @return {RecordView} 直接指向缓冲池帧中记录的视图，在视图释放之前页面保持固定并加共享锁
+ */
+RecordView RmFileHandle::get_record_view(const Rid& rid) const {
+    ReadPageGuard guard = fetch_page_read(rid.page_no);
+    RmPageHandle page_handle(&file_hdr_, guard.get_page());
+    assert(Bitmap::is_set(page_handle.bitmap, rid.slot_no) && "Attempting to read a non-existing record!");
+    const char* data = page_handle.get_slot(rid.slot_no);
+    return RecordView(std::move(guard), data, file_hdr_.record_size);
+}
+
 /**
  * @description: 在当前表中插入一条记录，不指定插入位置
  * @param {char*} buf 要插入的记录的数据
  * @param {Context*} context
+ * @param {BufferAccessStrategy*} strategy 批量写入(导入数据)使用的访问策略，为nullptr时使用整个缓冲池
  * @return {Rid} 插入的记录的记录号（位置）
  */
-Rid RmFileHandle::insert_record(char* buf, Context* context) {
+Rid RmFileHandle::insert_record(char* buf, Context* context, BufferAccessStrategy* strategy) {
     // Todo:
     // 1. 获取当前未满的page handle
     // 2. 在page handle中找到空闲slot位置
@@ -34,10 +53,11 @@ Rid RmFileHandle::insert_record(char* buf, Context* context) {
     // 4. 更新page_handle.page_hdr中的数据结构
     // 注意考虑插入一条记录后页面已满的情况，需要更新file_hdr_.first_free_page_no
     int page_no = file_hdr_.first_free_page_no;
-    RmPageHandle page_handle =
+    WritePageGuard guard =
         (page_no != RM_NO_PAGE ? 
-         fetch_page_handle(page_no) : 
-         create_new_page_handle());
+         fetch_page_write(page_no, strategy) : 
+         create_new_page(strategy));
+    RmPageHandle page_handle(&file_hdr_, guard.get_page());
     int free_slot = Bitmap::next_bit(false,page_handle.bitmap,file_hdr_.num_records_per_page,-1);
     assert(free_slot != -1 && "first_free_page_no 指向一个已满的页面！");
     char* slot_ptr = page_handle.get_slot(free_slot);
@@ -47,7 +67,7 @@ Rid RmFileHandle::insert_record(char* buf, Context* context) {
     if (page_handle.page_hdr->num_records == file_hdr_.num_records_per_page) {
         file_hdr_.first_free_page_no = page_handle.page_hdr->next_free_page_no;
     }
-    Rid rid{page_handle.page->get_page_id().page_no, free_slot};
+    Rid rid{guard.get_page_id().page_no, free_slot};
 
     return rid;
 }
@@ -71,7 +91,8 @@ void RmFileHandle::delete_record(const Rid& rid, Context* context) {
     // 1. 获取指定记录所在的page handle
     // 2. 更新page_handle.page_hdr中的数据结构
     // 注意考虑删除一条记录后页面未满的情况，需要调用release_page_handle()
-    RmPageHandle page_handle = fetch_page_handle(rid.page_no);
+    WritePageGuard guard = fetch_page_write(rid.page_no);
+    RmPageHandle page_handle(&file_hdr_, guard.get_page());
     assert(Bitmap::is_set(page_handle.bitmap, rid.slot_no) &&
            "Attempting to delete a non-existing record!");
     Bitmap::reset(page_handle.bitmap, rid.slot_no);
@@ -95,52 +116,109 @@ void RmFileHandle::update_record(const Rid& rid, char* buf, Context* context) {
     // Todo:
     // 1. 获取指定记录所在的page handle
     // 2. 更新记录
-    RmPageHandle page_handle = fetch_page_handle(rid.page_no);
+    WritePageGuard guard = fetch_page_write(rid.page_no);
+    RmPageHandle page_handle(&file_hdr_, guard.get_page());
     assert(rid.slot_no >= 0 && rid.slot_no < file_hdr_.num_records_per_page);
     if (!Bitmap::is_set(page_handle.bitmap, rid.slot_no)) {
         throw std::runtime_error("update_record: target record does not exist");
     }
     char* dst = page_handle.get_slot(rid.slot_no);
     memcpy(dst, buf, file_hdr_.record_size);
-    buffer_pool_manager_->mark_dirty(page_handle.page);
+}
+
+/**
+ * @description: 固定一次页面，找出页面上所有存放了记录的slot，记录不复制，直接指向页面所在的帧。bitmap按64位的字查找
+ * @param {int} page_no 页面号
+ * @param {RmPageBatch&} batch 存放页面上记录的视图，原来持有的页面先被释放，重复使用可以避免重新分配空间
+ * @param {BufferAccessStrategy*} strategy 大表扫描使用的访问策略，为nullptr时使用整个缓冲池
+ * @return {int} 页面上的记录个数
+ */
+int RmFileHandle::read_page_batch(int page_no, RmPageBatch &batch, BufferAccessStrategy *strategy) const {
+    // 先释放上一个页面，使用私有环时它的帧才能被循环使用
+    batch.drop();
+    batch.guard = fetch_page_read(page_no, strategy);
+    RmPageHandle page_handle(&file_hdr_, batch.guard.get_page());
+    int num_records = Bitmap::count(page_handle.bitmap, file_hdr_.num_records_per_page);
+    batch.page_no = page_no;
+    batch.record_size = file_hdr_.record_size;
+    batch.slots_data = page_handle.slots;
+    batch.slots.resize(num_records);
+    Bitmap::get_set_bits(page_handle.bitmap, file_hdr_.num_records_per_page, batch.slots.data());
+    return num_records;
 }
 
 /**
  * 以下函数为辅助函数，仅提供参考，可以选择完成如下函数，也可以删除如下函数，在单元测试中不涉及如下函数接口的直接调用
 */
 /**
- * @description: 获取指定页面的页面句柄
+ * @description: 获取指定页面并加共享锁，用于只读取页面的操作
  * @param {int} page_no 页面号
- * @return {RmPageHandle} 指定页面的句柄
+ * @param {BufferAccessStrategy*} strategy 大表扫描等使用的访问策略，为nullptr时使用整个缓冲池
+ * @return {ReadPageGuard} 指定页面的读保护，离开作用域时自动解锁并取消固定
  */
-RmPageHandle RmFileHandle::fetch_page_handle(int page_no) const {
-    // Todo:
-    // 使用缓冲池获取指定页面，并生成page_handle返回给上层
+ReadPageGuard RmFileHandle::fetch_page_read(int page_no, BufferAccessStrategy *strategy) const {
     // if page_no is invalid, throw PageNotExistError exception
+    if (page_no < 0 || page_no >= file_hdr_.num_pages) {
+        throw PageNotExistError("",page_no);
+    }
+    ReadPageGuard guard = buffer_pool_manager_->fetch_page_read(PageId{fd_, page_no}, strategy);
+    if (!guard.is_valid()) {
+        throw std::runtime_error("fetch_page_read: buffer pool returned nullptr");
+    }
+    return guard;
+}
+
+/**
+ * @description: 获取指定页面用于乐观读，不加页面锁，读到的数据需要用OptimisticPageGuard::validate()验证。
+ *               页面被swizzle时直接通过swips_找到它所在的帧，不查页表也不固定页面
+ * @param {int} page_no 页面号
+ * @return {OptimisticPageGuard} 指定页面的乐观读保护，固定了页面时离开作用域自动取消固定
+ */
+OptimisticPageGuard RmFileHandle::fetch_page_optimistic(int page_no) const {
+    if (page_no < 0 || page_no >= file_hdr_.num_pages) {
+        throw PageNotExistError("",page_no);
+    }
+    OptimisticPageGuard guard = buffer_pool_manager_->fetch_page_swizzled(PageId{fd_, page_no}, &swips_);
+    if (!guard.is_valid()) {
+        throw std::runtime_error("fetch_page_optimistic: buffer pool returned nullptr");
+    }
+    return guard;
+}
 
+/**
+ * @description: 获取指定页面并加独占锁，用于修改页面的操作，页面在解锁时被标记为脏页
+ * @param {int} page_no 页面号
+ * @param {BufferAccessStrategy*} strategy 批量写入使用的访问策略，为nullptr时使用整个缓冲池
+ * @return {WritePageGuard} 指定页面的写保护，离开作用域时自动解锁并取消固定
+ */
+WritePageGuard RmFileHandle::fetch_page_write(int page_no, BufferAccessStrategy *strategy) const {
     if (page_no < 0 || page_no >= file_hdr_.num_pages) {
         throw PageNotExistError("",page_no);
     }
-    Page *page = buffer_pool_manager_->fetch_page(PageId{fd_, page_no});
-    if (page == nullptr) {
-        throw std::runtime_error("fetch_page_handle: buffer pool returned nullptr");
+    WritePageGuard guard = buffer_pool_manager_->fetch_page_write(PageId{fd_, page_no}, strategy);
+    if (!guard.is_valid()) {
+        throw std::runtime_error("fetch_page_write: buffer pool returned nullptr");
     }
-    return RmPageHandle(&file_hdr_, page);
+    return guard;
 }
 
 /**
- * @description: 创建一个新的page handle
- * @return {RmPageHandle} 新的PageHandle
+ * @description: 创建一个新的数据页面并初始化页头和bitmap
+ * @param {BufferAccessStrategy*} strategy 批量写入使用的访问策略，为nullptr时使用整个缓冲池
+ * @return {WritePageGuard} 新页面的写保护
  */
-RmPageHandle RmFileHandle::create_new_page_handle() {
+WritePageGuard RmFileHandle::create_new_page(BufferAccessStrategy *strategy) {
     // Todo:
     // 1.使用缓冲池来创建一个新page
     // 2.更新page handle中的相关信息
     // 3.更新file_hdr_
-    int new_page_no = file_hdr_.num_pages++;
-    PageId page_id{fd_, new_page_no};
-    Page *page = buffer_pool_manager_->new_page(&page_id);
-    if (!page) throw std::runtime_error("create_new_page_handle: failed to allocate page");
+    // new_page可能复用磁盘上已释放的页面，页号以其返回值为准
+    PageId page_id{fd_, INVALID_PAGE_ID};
+    WritePageGuard guard = buffer_pool_manager_->new_page_guarded(&page_id, strategy);
+    if (!guard.is_valid()) throw std::runtime_error("create_new_page: failed to allocate page");
+    Page *page = guard.get_page();
+    int new_page_no = page_id.page_no;
+    file_hdr_.num_pages = std::max(file_hdr_.num_pages, new_page_no + 1);
     RmPageHdr *hdr = reinterpret_cast<RmPageHdr*>(page->get_data() + page->OFFSET_PAGE_HDR);
     hdr->num_records = 0;
     hdr->next_free_page_no = -1;
@@ -149,7 +227,7 @@ RmPageHandle RmFileHandle::create_new_page_handle() {
     if (file_hdr_.first_free_page_no == RM_NO_PAGE) {
         file_hdr_.first_free_page_no = new_page_no;
     }
-    return RmPageHandle(&file_hdr_, page);
+    return guard;
 }
 
 /**
@@ -161,7 +239,7 @@ RmPageHandle RmFileHandle::create_new_page_handle() {
 RmPageHandle RmFileHandle::create_page_handle() {
     // Todo:
     // 1. 判断file_hdr_中是否还有空闲页
-    //     1.1 没有空闲页：使用缓冲池来创建一个新page；可直接调用create_new_page_handle()
+    //     1.1 没有空闲页：使用缓冲池来创建一个新page；可直接调用create_new_page()
     //     1.2 有空闲页：直接获取第一个空闲页
     // 2. 生成page handle并返回给上层
 
@@ -3,6 +3,7 @@
 #include <assert.h>
 
 #include <memory>
+#include <vector>
 
 #include "bitmap.h"
 #include "common/context.h"
@@ -10,7 +11,7 @@
 
 class RmManager;
 
-/* 对表数据文件中的页面进行封装 */
+/* 对表数据文件中的页面进行封装，只是页面数据的视图，页面的固定和锁由创建它时使用的页面保护负责 */
 struct RmPageHandle {
     const RmFileHdr *file_hdr;  // 当前页面所在文件的文件头指针
     Page *page;                 // 页面的实际数据，包括页面存储的数据、元信息等
@@ -30,6 +31,28 @@ struct RmPageHandle {
     }
 };
 
+/* 一个数据页上所有记录的视图，由RmFileHandle::read_page_batch固定一次页面后填充，记录直接指向缓冲池的帧，不复制。
+   持有页面的读保护，读取下一个页面或drop()时释放 */
+struct RmPageBatch {
+    ReadPageGuard guard;                // 页面的固定和共享锁
+    int page_no = RM_NO_PAGE;           // 记录所在的页面号
+    int record_size = 0;                // 每条记录的大小
+    const char *slots_data = nullptr;   // 页面中第0个slot的地址
+    std::vector<int> slots;             // 页面上存放了记录的slot_no，升序
+
+    int size() const { return static_cast<int>(slots.size()); }
+
+    Rid rid(int i) const { return Rid{page_no, slots[i]}; }
+
+    const char *get_record(int i) const { return slots_data + static_cast<size_t>(slots[i]) * record_size; }
+
+    void drop() {
+        guard.drop();
+        slots_data = nullptr;
+        slots.clear();
+    }
+};
+
 /* 每个RmFileHandle对应一个表的数据文件，里面有多个page，每个page的数据封装在RmPageHandle中 */
 class RmFileHandle {      
     friend class RmScan;    
@@ -40,10 +63,11 @@ class RmFileHandle {
     BufferPoolManager *buffer_pool_manager_;
     int fd_;        // 打开文件后产生的文件句柄
     RmFileHdr file_hdr_;    // 文件头，维护当前表文件的元数据
+    SwipTable swips_;       // 被swizzle的页面，按记录号读取记录时直接找到页面所在的帧
 
    public:
     RmFileHandle(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, int fd)
-        : disk_manager_(disk_manager), buffer_pool_manager_(buffer_pool_manager), fd_(fd) {
+        : disk_manager_(disk_manager), buffer_pool_manager_(buffer_pool_manager), fd_(fd), swips_(buffer_pool_manager, fd) {
         // 注意：这里从磁盘中读出文件描述符为fd的文件的file_hdr，读到内存中
         // 这里实际就是初始化file_hdr，只不过是从磁盘中读出进行初始化
         // init file_hdr_
@@ -54,16 +78,20 @@ class RmFileHandle {
 
     RmFileHdr get_file_hdr() { return file_hdr_; }
     int GetFd() { return fd_; }
+    BufferPoolManager *get_buffer_pool_manager() const { return buffer_pool_manager_; }
 
     /* 判断指定位置上是否已经存在一条记录，通过Bitmap来判断 */
     bool is_record(const Rid &rid) const {
-        RmPageHandle page_handle = fetch_page_handle(rid.page_no);
+        ReadPageGuard guard = fetch_page_read(rid.page_no);
+        RmPageHandle page_handle(&file_hdr_, guard.get_page());
         return Bitmap::is_set(page_handle.bitmap, rid.slot_no);  // page的slot_no位置上是否有record
     }
 
     std::unique_ptr<RmRecord> get_record(const Rid &rid, Context *context) const;
 
-    Rid insert_record(char *buf, Context *context);
+    RecordView get_record_view(const Rid &rid) const;
+
+    Rid insert_record(char *buf, Context *context, BufferAccessStrategy *strategy = nullptr);
 
     void insert_record(const Rid &rid, char *buf);
 
@@ -71,9 +99,15 @@ class RmFileHandle {
 
     void update_record(const Rid &rid, char *buf, Context *context);
 
-    RmPageHandle create_new_page_handle();
+    WritePageGuard create_new_page(BufferAccessStrategy *strategy = nullptr);
+
+    int read_page_batch(int page_no, RmPageBatch &batch, BufferAccessStrategy *strategy = nullptr) const;
+
+    ReadPageGuard fetch_page_read(int page_no, BufferAccessStrategy *strategy = nullptr) const;
+
+    OptimisticPageGuard fetch_page_optimistic(int page_no) const;
 
-    RmPageHandle fetch_page_handle(int page_no) const;
+    WritePageGuard fetch_page_write(int page_no, BufferAccessStrategy *strategy = nullptr) const;
 
    private:
     RmPageHandle create_page_handle();
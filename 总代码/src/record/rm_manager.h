@@ -25,7 +25,7 @@ class RmManager {
         if (record_size < 1 || record_size > RM_MAX_RECORD_SIZE) {
             throw InvalidRecordSizeError(record_size);
         }
-        disk_manager_->create_file(filename);
+        disk_manager_->create_file(filename, ENABLE_PAGE_COMPRESSION);
         int fd = disk_manager_->open_file(filename);
 
         // 初始化file header
@@ -54,11 +54,17 @@ class RmManager {
     /**
      * @description: 打开表的数据文件，并返回文件句柄
      * @param {string&} filename 要打开的文件名称
+     * @param {BufferPoolManager*} bpm 文件所属的缓冲池，为空时使用默认缓冲池
      * @return {unique_ptr<RmFileHandle>} 文件句柄的指针
      */
-    std::unique_ptr<RmFileHandle> open_file(const std::string& filename) {
+    std::unique_ptr<RmFileHandle> open_file(const std::string& filename, BufferPoolManager *bpm = nullptr) {
         int fd = disk_manager_->open_file(filename);
-        return std::make_unique<RmFileHandle>(disk_manager_, buffer_pool_manager_, fd);
+        if (bpm == nullptr) {
+            bpm = buffer_pool_manager_;
+        }
+        // 记录页面在页头之前保留了page_lsn，文件头页面没有
+        bpm->register_lsn_file(fd, RM_FIRST_RECORD_PAGE);
+        return std::make_unique<RmFileHandle>(disk_manager_, bpm, fd);
     }
     /**
      * @description: 关闭表的数据文件
@@ -68,7 +74,20 @@ class RmManager {
         disk_manager_->write_page(file_handle->fd_, RM_FILE_HDR_PAGE, (char *)&file_handle->file_hdr_,
                                   sizeof(file_handle->file_hdr_));
         // 缓冲区的所有页刷到磁盘，注意这句话必须写在close_file前面
-        buffer_pool_manager_->flush_all_pages(file_handle->fd_);
+        file_handle->buffer_pool_manager_->flush_all_pages(file_handle->fd_);
+        // 关闭后不再访问该文件，释放它的页面占用的帧
+        file_handle->buffer_pool_manager_->drop_all_pages(file_handle->fd_);
+        file_handle->buffer_pool_manager_->unregister_lsn_file(file_handle->fd_);
+        disk_manager_->close_file(file_handle->fd_);
+    }
+
+    /**
+     * @description: 删除表之前关闭表的数据文件，文件即将被删除，缓冲池中的页面直接丢弃，不写回磁盘
+     * @param {RmFileHandle*} file_handle 要关闭文件的句柄
+     */
+    void discard_file(const RmFileHandle* file_handle) {
+        file_handle->buffer_pool_manager_->drop_all_pages(file_handle->fd_);
+        file_handle->buffer_pool_manager_->unregister_lsn_file(file_handle->fd_);
         disk_manager_->close_file(file_handle->fd_);
     }
 };
@@ -4,41 +4,56 @@
 /**
  * @brief 初始化file_handle和rid
  * @param file_handle
+ * @param strategy 大表扫描使用的访问策略，扫描只在策略的私有环中循环使用帧，为nullptr时使用整个缓冲池
  */
-RmScan::RmScan(const RmFileHandle *file_handle) : file_handle_(file_handle) {
+RmScan::RmScan(const RmFileHandle *file_handle, BufferAccessStrategy *strategy)
+    : file_handle_(file_handle), strategy_(strategy) {
     // Todo:
     // 初始化file_handle和rid（指向第一个存放了记录的位置）
-    RmFileHdr hdr;
-    const_cast<RmFileHandle*>(file_handle_)->get_file_hdr();
-    rid_.page_no=1;
-    rid_.slot_no=-1;
+    rid_.page_no = RM_FIRST_RECORD_PAGE;
+    rid_.slot_no = -1;
+    // 全表扫描按页号顺序访问数据页，提示缓冲池立即开始预读；使用访问策略时由策略批量读入后续页面
+    if (strategy_ == nullptr) {
+        file_handle_->buffer_pool_manager_->hint_sequential(file_handle_->fd_, rid_.page_no);
+    }
     next();
 }
 
 /**
- * @brief 找到文件中下一个存放了记录的位置
+ * @brief 找到文件中下一个存放了记录的位置，当前页面上的记录用完后才读取下一个页面
  */
 void RmScan::next() {
     // Todo:
     // 找到文件中下一个存放了记录的非空闲位置，用rid_来指向这个位置
+    if (pos_ + 1 < batch_.size()) {
+        pos_++;
+        rid_ = batch_.rid(pos_);
+        return;
+    }
+    next_batch();
+}
+
+/**
+ * @brief 跳到下一个存放了记录的页面，固定一次页面得到其中所有记录的视图，当前页面上剩余的记录被跳过
+ * @return 是否还有这样的页面，没有时到达文件末尾
+ */
+bool RmScan::next_batch() {
     RmFileHdr hdr = const_cast<RmFileHandle*>(file_handle_)->get_file_hdr();
-    int page_no = rid_.page_no;
-    int slot_no = rid_.slot_no + 1;
-    while (page_no < hdr.num_pages) {
-        RmPageHandle page_handle = file_handle_->fetch_page_handle(page_no);
-        while (slot_no < hdr.num_records_per_page) {
-            if (Bitmap::is_set(page_handle.bitmap, slot_no)) {
-                rid_.page_no = page_no;
-                rid_.slot_no = slot_no;
-                return;
-            }
-            slot_no++;
+    int page_no = batch_.page_no == RM_NO_PAGE ? RM_FIRST_RECORD_PAGE : batch_.page_no + 1;
+    for (; page_no < hdr.num_pages; page_no++) {
+        if (file_handle_->read_page_batch(page_no, batch_, strategy_) > 0) {
+            pos_ = 0;
+            rid_ = batch_.rid(pos_);
+            return true;
         }
-        page_no++;
-        slot_no = 0;
     }
+    // 到达文件末尾时释放最后一个页面，之后可以修改扫描过的页面
+    batch_.drop();
+    batch_.page_no = hdr.num_pages;
+    pos_ = 0;
     rid_.page_no = hdr.num_pages;
     rid_.slot_no = 0;
+    return false;
 }
 
 /**
@@ -1,18 +1,30 @@
 #pragma once
 
 #include "rm_defs.h"
+#include "rm_file_handle.h"
 
-class RmFileHandle;
+class BufferAccessStrategy;
 
 class RmScan : public RecScan {
     const RmFileHandle *file_handle_;
+    BufferAccessStrategy *strategy_;    // 大表扫描使用的访问策略，为nullptr时使用整个缓冲池
     Rid rid_;
+    RmPageBatch batch_;                 // 当前页面上所有记录的视图，每个页面只固定一次，移到下一个页面时释放
+    int pos_ = 0;                       // rid_在batch_中的下标
 public:
-    RmScan(const RmFileHandle *file_handle);
+    RmScan(const RmFileHandle *file_handle, BufferAccessStrategy *strategy = nullptr);
 
     void next() override;
 
+    bool next_batch();
+
     bool is_end() const override;
 
     Rid rid() const override;
+
+    // 当前记录在缓冲池帧中的地址，与rid()对应，只在扫描移到下一个页面之前有效
+    const char *record() const { return batch_.get_record(pos_); }
+
+    // 当前页面上的所有记录，next_batch()之后整页处理
+    RmPageBatch &batch() { return batch_; }
 };
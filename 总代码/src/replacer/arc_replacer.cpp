@@ -0,0 +1,199 @@
+#include "arc_replacer.h"
+
+#include <algorithm>
+
+ARCReplacer::ARCReplacer(size_t num_pages) : capacity_(num_pages), frames_(num_pages) {}
+
+ARCReplacer::~ARCReplacer() = default;
+
+/**
+ * @description: T1超过目标大小p_时从T1淘汰，否则从T2淘汰，都取链表尾部(最久未被访问)的可淘汰帧。
+ *               被淘汰页面的page_key记入对应的ghost链表B1或B2
+ * @param {frame_id_t*} frame_id 被移除的frame的id
+ * @return {bool} 如果成功淘汰了一个页面则返回true，否则返回false
+ */
+bool ARCReplacer::victim(frame_id_t *frame_id) {
+    std::scoped_lock lock{latch_};
+    if (frame_id == nullptr || num_evictable_[T1] + num_evictable_[T2] == 0) {
+        return false;
+    }
+    ListType list = victim_list();
+    for (auto it = lists_[list].rbegin(); it != lists_[list].rend(); ++it) {
+        frame_id_t candidate = *it;
+        FrameState &state = frames_[candidate];
+        if (!state.evictable) {
+            continue;
+        }
+        if (state.page_key != -1 && !ghost_index_.count(state.page_key)) {
+            ghosts_[list].push_front(state.page_key);
+            ghost_index_[state.page_key] = GhostEntry{list, ghosts_[list].begin()};
+        }
+        remove_frame(candidate);
+        state = FrameState{};
+        trim_ghosts();
+        *frame_id = candidate;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @description: 固定指定的frame，即该页面无法被淘汰。帧仍留在T1或T2中，淘汰时跳过
+ * @param {frame_id_t} frame_id 需要固定的frame的id
+ */
+void ARCReplacer::pin(frame_id_t frame_id) {
+    std::scoped_lock lock{latch_};
+    FrameState &state = frames_[frame_id];
+    if (state.evictable) {
+        state.evictable = false;
+        if (state.list != NONE) {
+            num_evictable_[state.list]--;
+        }
+    }
+}
+
+/**
+ * @description: 取消固定一个frame，代表该页面可以被淘汰。还没有被记录过访问的帧放入T1
+ * @param {frame_id_t} frame_id 取消固定的frame的id
+ */
+void ARCReplacer::unpin(frame_id_t frame_id) {
+    std::scoped_lock lock{latch_};
+    FrameState &state = frames_[frame_id];
+    if (state.list == NONE) {
+        insert_frame(frame_id, T1);
+    }
+    if (!state.evictable) {
+        state.evictable = true;
+        num_evictable_[state.list]++;
+    }
+}
+
+/**
+ * @description: 记录一次页面访问。T1或T2中的页面再次被引用时移到T2首部，距上次访问不超过REPLACER_CORRELATED_PERIOD的
+ *               相关引用不提升；帧中换成了新页面时，若它在B1或B2中则调整p_并放入T2，否则放入T1
+ * @param {frame_id_t} frame_id 被访问的frame的id
+ * @param {int64_t} page_key 帧中的页面
+ */
+void ARCReplacer::record_access(frame_id_t frame_id, int64_t page_key) {
+    std::scoped_lock lock{latch_};
+    uint64_t now = ++current_timestamp_;
+    FrameState &state = frames_[frame_id];
+    if (state.list != NONE && state.page_key == page_key) {
+        if (now - state.last_access > static_cast<uint64_t>(REPLACER_CORRELATED_PERIOD)) {
+            remove_frame(frame_id);
+            insert_frame(frame_id, T2);
+        }
+        state.last_access = now;
+        return;
+    }
+    if (state.list != NONE) {
+        remove_frame(frame_id);
+    }
+    ListType target = T1;
+    auto ghost = ghost_index_.find(page_key);
+    if (ghost != ghost_index_.end()) {
+        size_t b1 = ghosts_[T1].size();
+        size_t b2 = ghosts_[T2].size();
+        if (ghost->second.list == T1) {
+            p_ = std::min(capacity_, p_ + std::max<size_t>(b2 / b1, 1));
+        } else {
+            size_t delta = std::max<size_t>(b1 / b2, 1);
+            p_ = p_ > delta ? p_ - delta : 0;
+        }
+        ghosts_[ghost->second.list].erase(ghost->second.pos);
+        ghost_index_.erase(ghost);
+        target = T2;
+    }
+    state.page_key = page_key;
+    state.last_access = now;
+    insert_frame(frame_id, target);
+    trim_ghosts();
+}
+
+/**
+ * @description: 获取当前replacer中可以被淘汰的页面数量
+ */
+size_t ARCReplacer::Size() {
+    std::scoped_lock lock{latch_};
+    return num_evictable_[T1] + num_evictable_[T2];
+}
+
+/**
+ * @description: 按淘汰顺序获取至多max_frames个可淘汰的frame，不把它们移出replacer：
+ *               先是当前应当淘汰的链表尾部的帧，再是另一个链表
+ * @param {vector<frame_id_t>*} frame_ids 获取的frame追加到其末尾
+ * @param {size_t} max_frames 最多获取的frame个数
+ */
+void ARCReplacer::peek_victims(std::vector<frame_id_t> *frame_ids, size_t max_frames) {
+    std::scoped_lock lock{latch_};
+    ListType first = victim_list();
+    for (ListType list : {first, first == T1 ? T2 : T1}) {
+        for (auto it = lists_[list].rbegin(); it != lists_[list].rend() && max_frames > 0; ++it) {
+            if (frames_[*it].evictable) {
+                frame_ids->push_back(*it);
+                max_frames--;
+            }
+        }
+    }
+}
+
+/**
+ * @description: 把帧插入T1或T2的首部，调用者需持有latch_
+ * @param {frame_id_t} frame_id 目标帧
+ * @param {ListType} list 目标链表
+ */
+void ARCReplacer::insert_frame(frame_id_t frame_id, ListType list) {
+    FrameState &state = frames_[frame_id];
+    lists_[list].push_front(frame_id);
+    state.list = list;
+    state.pos = lists_[list].begin();
+    if (state.evictable) {
+        num_evictable_[list]++;
+    }
+}
+
+/**
+ * @description: 把帧从所在的链表中移除，调用者需持有latch_
+ * @param {frame_id_t} frame_id 目标帧
+ */
+void ARCReplacer::remove_frame(frame_id_t frame_id) {
+    FrameState &state = frames_[frame_id];
+    lists_[state.list].erase(state.pos);
+    if (state.evictable) {
+        num_evictable_[state.list]--;
+    }
+    state.list = NONE;
+}
+
+/**
+ * @description: 选择从哪个链表淘汰：T1的大小超过p_时淘汰T1，否则淘汰T2；选中的链表没有可淘汰的帧时换另一个
+ */
+ARCReplacer::ListType ARCReplacer::victim_list() const {
+    ListType list = lists_[T1].size() > p_ ? T1 : T2;
+    if (num_evictable_[list] == 0) {
+        list = list == T1 ? T2 : T1;
+    }
+    return list;
+}
+
+/**
+ * @description: 限制ghost链表的长度：|T1| + |B1| <= c，|T1| + |T2| + |B1| + |B2| <= 2c，调用者需持有latch_
+ */
+void ARCReplacer::trim_ghosts() {
+    auto drop = [this](ListType list) {
+        ghost_index_.erase(ghosts_[list].back());
+        ghosts_[list].pop_back();
+    };
+    while (!ghosts_[T1].empty() && lists_[T1].size() + ghosts_[T1].size() > capacity_) {
+        drop(T1);
+    }
+    while (lists_[T1].size() + lists_[T2].size() + ghosts_[T1].size() + ghosts_[T2].size() > 2 * capacity_) {
+        if (!ghosts_[T2].empty()) {
+            drop(T2);
+        } else if (!ghosts_[T1].empty()) {
+            drop(T1);
+        } else {
+            break;
+        }
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "common/config.h"
+#include "replacer/replacer.h"
+
+/*
+ARCReplacer实现了ARC(Adaptive Replacement Cache)替换策略：
+T1保存最近只被引用过一次的页面，T2保存被引用过至少两次的页面，B1、B2分别记录最近从T1、T2淘汰的页面(只记录page_key)。
+缺页的页面命中B1说明T1太小，命中B2说明T2太小，据此自适应地调整T1的目标大小p_。扫描只会进入T1，不会挤掉T2中的热点页面
+*/
+class ARCReplacer : public Replacer {
+   public:
+    /**
+     * @description: 创建一个新的ARCReplacer
+     * @param {size_t} num_pages ARCReplacer最多需要存储的page数量
+     */
+    explicit ARCReplacer(size_t num_pages);
+
+    ~ARCReplacer();
+
+    bool victim(frame_id_t *frame_id);
+
+    void pin(frame_id_t frame_id);
+
+    void unpin(frame_id_t frame_id);
+
+    void record_access(frame_id_t frame_id, int64_t page_key);
+
+    size_t Size();
+
+    void peek_victims(std::vector<frame_id_t> *frame_ids, size_t max_frames);
+
+   private:
+    enum ListType { NONE = -1, T1 = 0, T2 = 1 };
+
+    /**
+     * @description: 一个帧的状态
+     */
+    struct FrameState {
+        ListType list = NONE;                 // 帧所在的链表
+        std::list<frame_id_t>::iterator pos;  // 帧在链表中的位置
+        bool evictable = false;               // 是否可以被淘汰
+        int64_t page_key = -1;                // 帧中的页面，-1表示未知
+        uint64_t last_access = 0;             // 最近一次访问的时间，用于识别相关引用
+    };
+
+    /**
+     * @description: 一个ghost页面所在的链表和位置
+     */
+    struct GhostEntry {
+        ListType list;                        // T1表示在B1中，T2表示在B2中
+        std::list<int64_t>::iterator pos;
+    };
+
+    void insert_frame(frame_id_t frame_id, ListType list);
+
+    void remove_frame(frame_id_t frame_id);
+
+    ListType victim_list() const;
+
+    void trim_ghosts();
+
+    std::mutex latch_;                                   // 互斥锁
+    size_t capacity_;                                    // 缓存的帧个数c
+    size_t p_ = 0;                                       // T1的目标大小
+    uint64_t current_timestamp_ = 0;                     // 逻辑时钟，每次访问加一
+    std::vector<FrameState> frames_;                     // 所有帧的状态，下标为frame_id
+    std::list<frame_id_t> lists_[2];                     // T1和T2，首部为最近被访问的帧
+    size_t num_evictable_[2] = {0, 0};                   // T1和T2中可以被淘汰的帧个数
+    std::list<int64_t> ghosts_[2];                       // B1和B2，首部为最近被淘汰的页面
+    std::unordered_map<int64_t, GhostEntry> ghost_index_;  // page_key -> ghost页面的位置
+};
@@ -0,0 +1,99 @@
+#include "clock_replacer.h"
+
+ClockReplacer::ClockReplacer(size_t num_pages) : frames_(num_pages) {}
+
+ClockReplacer::~ClockReplacer() = default;
+
+/**
+ * @description: 转动时钟指针选出一个victim frame：跳过不可淘汰的帧，引用位为1的帧清零引用位后跳过，淘汰第一个引用位为0的帧
+ * @param {frame_id_t*} frame_id 被移除的frame的id
+ * @return {bool} 如果成功淘汰了一个页面则返回true，否则返回false
+ */
+bool ClockReplacer::victim(frame_id_t *frame_id) {
+    std::scoped_lock lock{latch_};
+    if (frame_id == nullptr || num_evictable_ == 0) {
+        return false;
+    }
+    // 最多转两圈：第一圈清零所有引用位，第二圈一定能找到victim
+    while (true) {
+        FrameState &state = frames_[hand_];
+        size_t current = hand_;
+        hand_ = (hand_ + 1) % frames_.size();
+        if (!state.evictable) {
+            continue;
+        }
+        if (state.referenced) {
+            state.referenced = false;
+            continue;
+        }
+        state.evictable = false;
+        num_evictable_--;
+        *frame_id = static_cast<frame_id_t>(current);
+        return true;
+    }
+}
+
+/**
+ * @description: 固定指定的frame，即该页面无法被淘汰
+ * @param {frame_id_t} frame_id 需要固定的frame的id
+ */
+void ClockReplacer::pin(frame_id_t frame_id) {
+    std::scoped_lock lock{latch_};
+    FrameState &state = frames_[frame_id];
+    if (state.evictable) {
+        state.evictable = false;
+        num_evictable_--;
+    }
+}
+
+/**
+ * @description: 取消固定一个frame，代表该页面可以被淘汰，同时设置它的引用位
+ * @param {frame_id_t} frame_id 取消固定的frame的id
+ */
+void ClockReplacer::unpin(frame_id_t frame_id) {
+    std::scoped_lock lock{latch_};
+    FrameState &state = frames_[frame_id];
+    if (!state.evictable) {
+        state.evictable = true;
+        state.referenced = true;
+        num_evictable_++;
+    }
+}
+
+/**
+ * @description: 记录一次页面访问，设置该帧的引用位
+ * @param {frame_id_t} frame_id 被访问的frame的id
+ * @param {int64_t} page_key 帧中的页面
+ */
+void ClockReplacer::record_access(frame_id_t frame_id, int64_t page_key) {
+    std::scoped_lock lock{latch_};
+    frames_[frame_id].referenced = true;
+}
+
+/**
+ * @description: 获取当前replacer中可以被淘汰的页面数量
+ */
+size_t ClockReplacer::Size() {
+    std::scoped_lock lock{latch_};
+    return num_evictable_;
+}
+
+/**
+ * @description: 按淘汰顺序获取至多max_frames个可淘汰的frame，不转动时钟指针：
+ *               先是从指针开始引用位为0的帧，再是引用位为1的帧(它们在下一圈才会被淘汰)
+ * @param {vector<frame_id_t>*} frame_ids 获取的frame追加到其末尾
+ * @param {size_t} max_frames 最多获取的frame个数
+ */
+void ClockReplacer::peek_victims(std::vector<frame_id_t> *frame_ids, size_t max_frames) {
+    std::scoped_lock lock{latch_};
+    for (bool referenced : {false, true}) {
+        for (size_t i = 0; i < frames_.size() && max_frames > 0; i++) {
+            size_t current = (hand_ + i) % frames_.size();
+            const FrameState &state = frames_[current];
+            if (state.evictable && state.referenced == referenced) {
+                frame_ids->push_back(static_cast<frame_id_t>(current));
+                max_frames--;
+            }
+        }
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+#include "common/config.h"
+#include "replacer/replacer.h"
+
+/*
+ClockReplacer实现了CLOCK(second chance)替换策略
+*/
+class ClockReplacer : public Replacer {
+   public:
+    /**
+     * @description: 创建一个新的ClockReplacer
+     * @param {size_t} num_pages ClockReplacer最多需要存储的page数量
+     */
+    explicit ClockReplacer(size_t num_pages);
+
+    ~ClockReplacer();
+
+    bool victim(frame_id_t *frame_id);
+
+    void pin(frame_id_t frame_id);
+
+    void unpin(frame_id_t frame_id);
+
+    void record_access(frame_id_t frame_id, int64_t page_key);
+
+    size_t Size();
+
+    void peek_victims(std::vector<frame_id_t> *frame_ids, size_t max_frames);
+
+   private:
+    /**
+     * @description: 时钟上一个帧的状态
+     */
+    struct FrameState {
+        bool evictable = false;   // 是否可以被淘汰(在replacer中)
+        bool referenced = false;  // 引用位，时钟指针经过时为true则清零并跳过，给该帧第二次机会
+    };
+
+    std::mutex latch_;                 // 互斥锁
+    std::vector<FrameState> frames_;   // 所有帧的状态，下标为frame_id
+    size_t hand_ = 0;                  // 时钟指针，指向下一个要检查的帧
+    size_t num_evictable_ = 0;         // 可以被淘汰的帧个数
+};
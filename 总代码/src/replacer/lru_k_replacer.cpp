@@ -0,0 +1,135 @@
+#include "lru_k_replacer.h"
+
+LRUKReplacer::LRUKReplacer(size_t num_pages, size_t k) : k_(k), frames_(num_pages) {}
+
+LRUKReplacer::~LRUKReplacer() = default;
+
+/**
+ * @description: 淘汰K-distance最大的可淘汰帧，并清空它的引用历史。被固定的帧留在order_中，这里直接跳过，
+ *               因此pin和unpin都只需修改标记
+ * @param {frame_id_t*} frame_id 被移除的frame的id
+ * @return {bool} 如果成功淘汰了一个页面则返回true，否则返回false
+ */
+bool LRUKReplacer::victim(frame_id_t *frame_id) {
+    std::scoped_lock lock{latch_};
+    if (frame_id == nullptr || num_evictable_ == 0) {
+        return false;
+    }
+    for (const OrderKey &key : order_) {
+        frame_id_t candidate = std::get<2>(key);
+        if (frames_[candidate].evictable) {
+            untrack(candidate);
+            *frame_id = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @description: 固定指定的frame，即该页面无法被淘汰
+ * @param {frame_id_t} frame_id 需要固定的frame的id
+ */
+void LRUKReplacer::pin(frame_id_t frame_id) {
+    std::scoped_lock lock{latch_};
+    FrameState &state = frames_[frame_id];
+    if (state.evictable) {
+        state.evictable = false;
+        num_evictable_--;
+    }
+}
+
+/**
+ * @description: 取消固定一个frame，代表该页面可以被淘汰。没有引用历史的帧K-distance为无穷大，最先被淘汰
+ * @param {frame_id_t} frame_id 取消固定的frame的id
+ */
+void LRUKReplacer::unpin(frame_id_t frame_id) {
+    std::scoped_lock lock{latch_};
+    FrameState &state = frames_[frame_id];
+    if (!state.tracked) {
+        state.tracked = true;
+        order_.insert(order_key(frame_id));
+    }
+    if (!state.evictable) {
+        state.evictable = true;
+        num_evictable_++;
+    }
+}
+
+/**
+ * @description: 记录一次页面访问。帧中换成了其他页面时引用历史重新开始；
+ *               距上次访问不超过REPLACER_CORRELATED_PERIOD的访问是相关引用，不计入引用次数
+ * @param {frame_id_t} frame_id 被访问的frame的id
+ * @param {int64_t} page_key 帧中的页面
+ */
+void LRUKReplacer::record_access(frame_id_t frame_id, int64_t page_key) {
+    std::scoped_lock lock{latch_};
+    uint64_t now = ++current_timestamp_;
+    FrameState &state = frames_[frame_id];
+    if (state.tracked && state.page_key == page_key && !state.history.empty() &&
+        now - state.last_access <= static_cast<uint64_t>(REPLACER_CORRELATED_PERIOD)) {
+        state.last_access = now;
+        return;
+    }
+    if (state.tracked) {
+        order_.erase(order_key(frame_id));
+    }
+    if (state.page_key != page_key) {
+        state.history.clear();
+        state.page_key = page_key;
+    }
+    state.history.push_back(now);
+    if (state.history.size() > k_) {
+        state.history.pop_front();
+    }
+    state.last_access = now;
+    state.tracked = true;
+    order_.insert(order_key(frame_id));
+}
+
+/**
+ * @description: 获取当前replacer中可以被淘汰的页面数量
+ */
+size_t LRUKReplacer::Size() {
+    std::scoped_lock lock{latch_};
+    return num_evictable_;
+}
+
+/**
+ * @description: 按淘汰顺序(K-distance从大到小)获取至多max_frames个可淘汰的frame，不把它们移出replacer
+ * @param {vector<frame_id_t>*} frame_ids 获取的frame追加到其末尾
+ * @param {size_t} max_frames 最多获取的frame个数
+ */
+void LRUKReplacer::peek_victims(std::vector<frame_id_t> *frame_ids, size_t max_frames) {
+    std::scoped_lock lock{latch_};
+    for (auto it = order_.begin(); it != order_.end() && max_frames > 0; ++it) {
+        frame_id_t candidate = std::get<2>(*it);
+        if (frames_[candidate].evictable) {
+            frame_ids->push_back(candidate);
+            max_frames--;
+        }
+    }
+}
+
+/**
+ * @description: 帧在order_中的键。引用满K次的帧按倒数第K次引用的时间排序，不足K次的按第一次引用的时间排序并排在前面
+ * @param {frame_id_t} frame_id 目标帧
+ */
+LRUKReplacer::OrderKey LRUKReplacer::order_key(frame_id_t frame_id) const {
+    const FrameState &state = frames_[frame_id];
+    uint64_t oldest = state.history.empty() ? 0 : state.history.front();
+    return OrderKey{state.history.size() >= k_, oldest, frame_id};
+}
+
+/**
+ * @description: 把帧移出replacer并清空引用历史，调用者需持有latch_
+ * @param {frame_id_t} frame_id 目标帧
+ */
+void LRUKReplacer::untrack(frame_id_t frame_id) {
+    FrameState &state = frames_[frame_id];
+    order_.erase(order_key(frame_id));
+    if (state.evictable) {
+        num_evictable_--;
+    }
+    state = FrameState{};
+}
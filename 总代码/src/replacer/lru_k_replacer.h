@@ -0,0 +1,64 @@
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <set>
+#include <tuple>
+#include <vector>
+
+#include "common/config.h"
+#include "replacer/replacer.h"
+
+/*
+LRUKReplacer实现了LRU-K替换策略：淘汰backward K-distance(当前时间与倒数第K次引用的时间差)最大的帧，
+引用不足K次的帧K-distance为无穷大，优先淘汰，其中最早被引用的先淘汰。只被扫描过一次的页面因此不会挤掉热点页面
+*/
+class LRUKReplacer : public Replacer {
+   public:
+    /**
+     * @description: 创建一个新的LRUKReplacer
+     * @param {size_t} num_pages LRUKReplacer最多需要存储的page数量
+     * @param {size_t} k 计算K-distance时使用的引用次数
+     */
+    explicit LRUKReplacer(size_t num_pages, size_t k = REPLACER_LRU_K);
+
+    ~LRUKReplacer();
+
+    bool victim(frame_id_t *frame_id);
+
+    void pin(frame_id_t frame_id);
+
+    void unpin(frame_id_t frame_id);
+
+    void record_access(frame_id_t frame_id, int64_t page_key);
+
+    size_t Size();
+
+    void peek_victims(std::vector<frame_id_t> *frame_ids, size_t max_frames);
+
+   private:
+    // 淘汰顺序的键：(是否已有K次引用, 最早保留的引用时间, frame_id)，越小越先被淘汰
+    using OrderKey = std::tuple<bool, uint64_t, frame_id_t>;
+
+    /**
+     * @description: 一个帧的引用历史
+     */
+    struct FrameState {
+        bool tracked = false;           // 是否在order_中
+        bool evictable = false;         // 是否可以被淘汰
+        int64_t page_key = -1;          // 帧中的页面，换成其他页面时引用历史重新开始
+        uint64_t last_access = 0;       // 最近一次访问的时间，用于识别相关引用
+        std::deque<uint64_t> history;   // 最近至多K次引用的时间，从旧到新
+    };
+
+    OrderKey order_key(frame_id_t frame_id) const;
+
+    void untrack(frame_id_t frame_id);
+
+    std::mutex latch_;                 // 互斥锁
+    size_t k_;                         // LRU-K中的K
+    uint64_t current_timestamp_ = 0;   // 逻辑时钟，每次访问加一
+    std::vector<FrameState> frames_;   // 所有帧的引用历史，下标为frame_id
+    std::set<OrderKey> order_;         // 所有有引用历史的帧(包括被固定的)，按淘汰顺序排列
+    size_t num_evictable_ = 0;         // 可以被淘汰的帧个数
+};
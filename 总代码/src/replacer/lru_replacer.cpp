@@ -37,7 +37,7 @@ void LRUReplacer::pin(frame_id_t frame_id) {
     // 在数据结构中移除该frame
     auto it=LRUhash_.find(frame_id);
     if (it!=LRUhash_.end()) {
-        LRUlist_.remove(frame_id);
+        LRUlist_.erase(it->second);
         LRUhash_.erase(it);
     }
 }
@@ -62,3 +62,15 @@ void LRUReplacer::unpin(frame_id_t frame_id) {
  * @description: 获取当前replacer中可以被淘汰的页面数量
  */
 size_t LRUReplacer::Size() { return LRUlist_.size(); }
+
+/**
+ * @description: 按淘汰顺序(从最久未被访问的开始)获取至多max_frames个可淘汰的frame，不把它们移出replacer
+ * @param {vector<frame_id_t>*} frame_ids 获取的frame追加到其末尾
+ * @param {size_t} max_frames 最多获取的frame个数
+ */
+void LRUReplacer::peek_victims(std::vector<frame_id_t> *frame_ids, size_t max_frames) {
+    std::scoped_lock lock{latch_};
+    for (auto it = LRUlist_.rbegin(); it != LRUlist_.rend() && max_frames > 0; ++it, --max_frames) {
+        frame_ids->push_back(*it);
+    }
+}
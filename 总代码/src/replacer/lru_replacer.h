@@ -29,6 +29,8 @@ class LRUReplacer : public Replacer {
 
     size_t Size();
 
+    void peek_victims(std::vector<frame_id_t> *frame_ids, size_t max_frames);
+
    private:
     std::mutex latch_;                  // 互斥锁
     std::list<frame_id_t> LRUlist_;     // 按加入的时间顺序存放unpinned pages的frame id，首部表示最近被访问
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstdint>
+#include <vector>
+
 #include "common/config.h"
 
 /**
@@ -29,6 +32,22 @@ class Replacer {
      */
     virtual void unpin(frame_id_t frame_id) = 0;
 
+    /**
+     * Records an access to the page held in a frame. Policies that look at access history (LRU-K, ARC, CLOCK) use
+     * it; the default ignores it, so the order of unpins alone decides the victim.
+     * @param frame_id the id of the frame that was accessed
+     * @param page_key identifies the page now held in the frame; a different key than last time means the frame
+     *        was reused for another page
+     */
+    virtual void record_access(frame_id_t frame_id, int64_t page_key) {}
+
     /** @return the number of elements in the replacer that can be victimized */
     virtual size_t Size() = 0;
+
+    /**
+     * Collects the frames that would be victimized next, in eviction order, without removing them.
+     * @param[out] frame_ids the candidate frames are appended here
+     * @param max_frames the maximum number of frames to collect
+     */
+    virtual void peek_victims(std::vector<frame_id_t> *frame_ids, size_t max_frames) = 0;
 };
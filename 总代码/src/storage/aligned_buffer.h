@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>  // for posix_memalign
+#include <new>
+
+#include "common/config.h"
+
+/**
+ * @description: 起始地址和长度都按DIRECT_IO_ALIGNMENT对齐的临时缓冲区，长度向上取整，
+ *               用于O_DIRECT模式下中转未对齐的读写，以及写回前复制页面
+ */
+class AlignedBuffer {
+   public:
+    explicit AlignedBuffer(size_t len) : size_((len + DIRECT_IO_ALIGNMENT - 1) / DIRECT_IO_ALIGNMENT * DIRECT_IO_ALIGNMENT) {
+        void *ptr = nullptr;
+        if (posix_memalign(&ptr, DIRECT_IO_ALIGNMENT, size_) != 0) {
+            throw std::bad_alloc();
+        }
+        data_ = static_cast<char *>(ptr);
+    }
+
+    ~AlignedBuffer() { free(data_); }
+
+    AlignedBuffer(const AlignedBuffer &) = delete;
+    AlignedBuffer &operator=(const AlignedBuffer &) = delete;
+
+    char *data() { return data_; }
+
+    size_t size() const { return size_; }
+
+   private:
+    char *data_ = nullptr;
+    size_t size_;
+};
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "common/config.h"
+#include "storage/page.h"
+
+/**
+ * @description: 缓冲池访问策略的类型
+ */
+enum class BufferAccessType {
+    BULK_READ,   // 大表的顺序扫描
+    BULK_WRITE   // 批量写入，如导入数据、建索引
+};
+
+/**
+ * @description: 缓冲池访问策略。大表扫描、批量写入等一次性访问大量页面的操作持有一个私有的环，
+ *               缺页时优先重新使用环中自己之前读入、现在已不再被使用的帧，而不是从整个缓冲池中淘汰页面，
+ *               因此最多只占用环大小的帧，不会把热点页面挤出缓冲池。
+ *               环按缓冲池分片分开记录，因为一个帧只能存放属于其分片的页面。
+ *               一个策略只能由一个线程使用，通常随一次扫描创建和销毁
+ */
+class BufferAccessStrategy {
+    friend class BufferPoolManager;
+
+   public:
+    /**
+     * @param {BufferAccessType} type 访问策略的类型，决定环的大小
+     */
+    explicit BufferAccessStrategy(BufferAccessType type)
+        : type_(type),
+          ring_size_(type == BufferAccessType::BULK_READ ? BAS_BULK_READ_RING_PAGES : BAS_BULK_WRITE_RING_PAGES) {}
+
+    BufferAccessType get_type() const { return type_; }
+
+    size_t get_ring_size() const { return ring_size_; }
+
+    /**
+     * @description: 获得重新使用环中的帧的次数
+     */
+    size_t get_num_reused_frames() const { return num_reused_frames_; }
+
+   private:
+    /**
+     * @description: 环中的一个位置：策略在该帧中放入的页面。帧中的页面已经变化时，说明它已被其他操作淘汰并重新使用
+     */
+    struct RingSlot {
+        frame_id_t frame_id;
+        PageId page_id;
+    };
+
+    /**
+     * @description: 一个分片上的环，next指向下一次要重新使用的位置
+     */
+    struct Ring {
+        std::vector<RingSlot> slots;
+        size_t next = 0;
+    };
+
+    BufferAccessType type_;
+    size_t ring_size_;                        // 每个分片上环的大小
+    std::unordered_map<size_t, Ring> rings_;  // 分片下标 -> 该分片上的环
+    size_t num_reused_frames_ = 0;            // 重新使用环中的帧的次数
+};
@@ -1,11 +1,24 @@
 #include "buffer_pool_manager.h"
 
+#include <climits>
+
+#include "aligned_buffer.h"
+
+/**
+ * @description: 页面在replacer中的标识，用于识别帧中的页面是否变化以及被淘汰后再次访问的页面
+ * @param {PageId} page_id 目标页面
+ */
+static int64_t page_key(PageId page_id) {
+    return (static_cast<int64_t>(page_id.fd) << 32) | static_cast<uint32_t>(page_id.page_no);
+}
+
 /**
- * @description: 从free_list或replacer中得到可淘汰帧页的 *frame_id
+ * @description: 从分片的free_list或replacer中得到可淘汰帧页的 *frame_id，调用者需持有分片的latch
  * @return {bool} true: 可替换帧查找成功 , false: 可替换帧查找失败
+ * @param {Shard&} shard 目标分片
  * @param {frame_id_t*} frame_id 帧页id指针,返回成功找到的可替换帧id
  */
-bool BufferPoolManager::find_victim_page(frame_id_t* frame_id) {
+bool BufferPoolManager::find_victim_page(Shard& shard, frame_id_t* frame_id) {
     // Todo:
     // 1 使用BufferPoolManager::free_list_判断缓冲池是否已满需要淘汰页面
     // 1.1 未满获得frame
@@ -13,39 +26,414 @@ bool BufferPoolManager::find_victim_page(frame_id_t* frame_id) {
     if(frame_id==nullptr){
         return false;
     }
-    if(!free_list_.empty()){
-        *frame_id=free_list_.front();
-        free_list_.pop_front();
+    if(!shard.free_list.empty()){
+        *frame_id=shard.free_list.front();
+        shard.free_list.pop_front();
         return true;
     }
-    else if(replacer_->victim(frame_id)){
+    // 缩小缓冲池期间，被移除的帧中的页面由resize()腾空，不再用来存放新页面
+    while (shard.replacer->victim(frame_id)) {
+        if (*frame_id >= static_cast<frame_id_t>(shard.num_active)) {
+            continue;
+        }
+        // 通过swizzle引用的访问不经过replacer，被选中的swizzle页面可能仍然很热：先冷却它，清空引用后按一次新的访问
+        // 放回replacer，之后的访问经过页表并重新swizzle；冷却期间没有被访问的页面下一次被选中时才淘汰
+        Page *page = &shard.pages[*frame_id];
+        if (page->swip_ != nullptr) {
+            unswizzle(page);
+            shard.replacer->record_access(*frame_id, page_key(page->id_));
+            shard.replacer->unpin(*frame_id);
+            continue;
+        }
         return true;
     }
 
     return false;
 }
 
+/**
+ * @description: 按访问策略获得可替换帧。策略的环已满时先尝试重新使用环中下一个位置的帧：
+ *               帧中仍是策略之前放入的页面且未被固定时直接淘汰它，批量读不重新使用被其他操作改脏的帧；
+ *               否则(包括没有策略时)从分片的free_list或replacer中获得。调用者需持有分片的latch
+ * @return {bool} true: 可替换帧查找成功 , false: 可替换帧查找失败
+ * @param {Shard&} shard 目标分片
+ * @param {frame_id_t*} frame_id 帧页id指针,返回成功找到的可替换帧id
+ * @param {BufferAccessStrategy*} strategy 访问策略，可以为nullptr
+ */
+bool BufferPoolManager::find_victim_page(Shard& shard, frame_id_t* frame_id, BufferAccessStrategy* strategy) {
+    if (strategy != nullptr && frame_id != nullptr) {
+        BufferAccessStrategy::Ring &ring = strategy->rings_[static_cast<size_t>(&shard - shards_)];
+        if (ring.slots.size() >= ring_capacity(shard, strategy)) {
+            const BufferAccessStrategy::RingSlot &slot = ring.slots[ring.next];
+            Page *page = &shard.pages[slot.frame_id];
+            if (slot.frame_id < static_cast<frame_id_t>(shard.num_active) && page->id_ == slot.page_id &&
+                page->pin_count_ == 0 && !page->io_in_progress_ &&
+                shard.page_table->find(slot.page_id) == slot.frame_id &&
+                !(page->is_dirty_ && strategy->type_ == BufferAccessType::BULK_READ)) {
+                shard.replacer->pin(slot.frame_id);
+                *frame_id = slot.frame_id;
+                strategy->num_reused_frames_++;
+                return true;
+            }
+        }
+    }
+    return find_victim_page(shard, frame_id);
+}
+
+/**
+ * @description: 策略在一个分片上的环的大小，不超过分片帧个数的1/8，避免小缓冲池中环占满整个分片
+ * @param {Shard&} shard 目标分片
+ * @param {BufferAccessStrategy*} strategy 访问策略
+ */
+size_t BufferPoolManager::ring_capacity(const Shard& shard, const BufferAccessStrategy* strategy) const {
+    return std::max<size_t>(1, std::min(strategy->ring_size_, shard.num_active / 8));
+}
+
+/**
+ * @description: 把策略刚放入页面的帧记入它在该分片上的环：环未满时追加，否则覆盖刚被重新使用(或已失效)的位置。
+ *               调用者需持有分片的latch
+ * @param {Shard&} shard 帧所在的分片
+ * @param {BufferAccessStrategy*} strategy 访问策略
+ * @param {frame_id_t} frame_id 目标帧
+ * @param {PageId} page_id 放入帧中的页面
+ */
+void BufferPoolManager::add_to_ring(Shard& shard, BufferAccessStrategy* strategy, frame_id_t frame_id,
+                                    PageId page_id) {
+    BufferAccessStrategy::Ring &ring = strategy->rings_[static_cast<size_t>(&shard - shards_)];
+    if (ring.slots.size() < ring_capacity(shard, strategy)) {
+        ring.slots.push_back({frame_id, page_id});
+        return;
+    }
+    ring.slots[ring.next] = {frame_id, page_id};
+    ring.next = (ring.next + 1) % ring.slots.size();
+}
+
+/**
+ * @description: 把页面放入帧后登记到页表和所属文件的帧集合中。调用者需持有分片的latch
+ * @param {Shard&} shard 帧所在的分片
+ * @param {PageId} page_id 放入帧中的页面
+ * @param {frame_id_t} frame_id 目标帧
+ */
+void BufferPoolManager::map_page(Shard& shard, PageId page_id, frame_id_t frame_id) {
+    shard.page_table->insert(page_id, frame_id);
+    FileFrames &file = shard.files[page_id.fd];
+    file.resident.insert(frame_id);
+    if (shared_segment_ != nullptr) {
+        if (file.shared_file < 0) {
+            file.shared_file = shared_segment_->register_file(disk_manager_->get_file_name(page_id.fd));
+        }
+        Page *page = &shard.pages[frame_id];
+        SharedFrameSegment::FrameDesc &desc = shared_segment_->desc(static_cast<size_t>(page - pages_));
+        desc.file = file.shared_file;
+        desc.page_no = page_id.page_no;
+        desc.flags = file.shared_file < 0 ? 0 : SharedFrameSegment::FRAME_VALID;
+        sync_shared_frame(page);
+    }
+}
+
+/**
+ * @description: 把页面从页表和所属文件的帧集合中移除，页面被丢弃时脏页也不再需要写回。调用者需持有分片的latch
+ * @param {Shard&} shard 帧所在的分片
+ * @param {PageId} page_id 帧中的页面
+ * @param {frame_id_t} frame_id 目标帧
+ */
+void BufferPoolManager::unmap_page(Shard& shard, PageId page_id, frame_id_t frame_id) {
+    shard.page_table->erase(page_id);
+    Page *page = &shard.pages[frame_id];
+    clear_shared_frame(page);
+    page->is_dirty_ = false;
+    if (page->swip_ != nullptr) {
+        unswizzle(page);
+    }
+    // 通过swizzle引用读取该帧且没有固定页面的读者据此发现帧中已不是原来的页面
+    page->version_.fetch_add(2, std::memory_order_release);
+    auto it = shard.files.find(page_id.fd);
+    if (it == shard.files.end()) {
+        return;
+    }
+    it->second.resident.erase(frame_id);
+    it->second.dirty.erase(frame_id);
+    if (it->second.resident.empty()) {
+        shard.files.erase(it);
+    }
+}
+
+/**
+ * @description: 设置帧的脏标记，同时维护所属文件的脏帧集合。调用者需持有分片的latch，帧中需存放着页面
+ * @param {Shard&} shard 帧所在的分片
+ * @param {frame_id_t} frame_id 目标帧
+ * @param {bool} is_dirty 是否为脏页
+ */
+void BufferPoolManager::set_dirty(Shard& shard, frame_id_t frame_id, bool is_dirty) {
+    Page *page = &shard.pages[frame_id];
+    page->is_dirty_ = is_dirty;
+    sync_shared_frame(page);
+    if (is_dirty) {
+        shard.files[page->id_.fd].dirty.insert(frame_id);
+        return;
+    }
+    auto it = shard.files.find(page->id_.fd);
+    if (it != shard.files.end()) {
+        it->second.dirty.erase(frame_id);
+    }
+}
+
+/**
+ * @description: 让swizzle引用指向帧中的页面，页面已经被swizzle时不变。调用者需持有分片的latch，页面需被固定
+ * @param {Page*} page 目标页面
+ * @param {atomic<Page*>*} swip 页面在SwipTable中的引用
+ */
+void BufferPoolManager::swizzle(Page* page, std::atomic<Page*>* swip) {
+    if (page->swip_ == nullptr) {
+        page->swip_ = swip;
+        swip->store(page, std::memory_order_release);
+    }
+}
+
+/**
+ * @description: 清空指向页面的swizzle引用，页面仍留在帧中。调用者需持有分片的latch，页面需已被swizzle
+ * @param {Page*} page 目标页面
+ */
+void BufferPoolManager::unswizzle(Page* page) {
+    page->swip_->store(nullptr, std::memory_order_release);
+    page->swip_ = nullptr;
+}
+
+/**
+ * @description: 把不再存放页面的帧放回free_list，缩小缓冲池时被移除的帧不放回。调用者需持有分片的latch
+ * @param {Shard&} shard 帧所在的分片
+ * @param {frame_id_t} frame_id 目标帧，不在replacer中
+ */
+void BufferPoolManager::release_frame(Shard& shard, frame_id_t frame_id) {
+    if (frame_id < static_cast<frame_id_t>(shard.num_active)) {
+        shard.free_list.push_back(frame_id);
+    }
+}
+
+/**
+ * @description: 丢弃帧中未被固定的页面，帧放回free_list，脏页不写回。调用者需持有分片的latch
+ * @param {Shard&} shard 帧所在的分片
+ * @param {frame_id_t} frame_id 目标帧
+ */
+void BufferPoolManager::discard_frame(Shard& shard, frame_id_t frame_id) {
+    Page *page = &shard.pages[frame_id];
+    unmap_page(shard, page->id_, frame_id);
+    shard.replacer->pin(frame_id);
+    page->id_.page_no = INVALID_PAGE_ID;
+    release_frame(shard, frame_id);
+}
+
+/**
+ * @description: 把未被固定的页面从一个帧移动到另一个空闲帧，连同脏标记，并在replacer中作为新帧重新记录。调用者需持有分片的latch
+ * @param {Shard&} shard 帧所在的分片
+ * @param {frame_id_t} src_frame_id 页面所在的帧
+ * @param {frame_id_t} dst_frame_id 已从free_list中取出的空闲帧
+ */
+void BufferPoolManager::relocate_frame(Shard& shard, frame_id_t src_frame_id, frame_id_t dst_frame_id) {
+    Page *src = &shard.pages[src_frame_id];
+    Page *dst = &shard.pages[dst_frame_id];
+    PageId page_id = src->id_;
+    bool is_dirty = src->is_dirty_;
+    clear_shared_frame(dst);
+    memcpy(dst->data_, src->data_, PAGE_SIZE);
+    unmap_page(shard, page_id, src_frame_id);
+    shard.replacer->pin(src_frame_id);
+    src->id_.page_no = INVALID_PAGE_ID;
+    dst->id_ = page_id;
+    dst->pin_count_ = 0;
+    map_page(shard, page_id, dst_frame_id);
+    set_dirty(shard, dst_frame_id, is_dirty);
+    shard.replacer->record_access(dst_frame_id, page_key(page_id));
+    shard.replacer->unpin(dst_frame_id);
+}
+
+/**
+ * @description: 将目标页面标记为脏页
+ * @param {Page*} page 缓冲池中被固定的页面
+ */
+void BufferPoolManager::mark_dirty(Page* page) {
+    Shard &shard = shard_of(page->id_);
+    std::lock_guard<std::mutex> lock(shard.latch);
+    set_dirty(shard, static_cast<frame_id_t>(page - shard.pages), true);
+}
+
+/**
+ * @description: 淘汰帧中原有的页面：等待帧上正在进行的写回完成，脏页先写回磁盘，再从页表中删除。
+ *               调用者需持有分片的latch，写回期间会暂时释放它；帧已经被调用者申请，不会被其他线程使用
+ * @param {Shard&} shard 帧所在的分片
+ * @param {Page*} page 即将放入新页面的帧
+ * @param {unique_lock<mutex>&} lock 已持有的分片latch
+ */
+void BufferPoolManager::evict_frame(Shard& shard, Page* page, std::unique_lock<std::mutex>& lock) {
+    // 帧即将放入新的内容，共享内存中保留的旧页面描述(关闭文件时保留的)随之失效
+    clear_shared_frame(page);
+    wait_for_io(shard, page, lock);
+    if (page->is_dirty_) {
+        // 遇到了脏的淘汰页，说明后台写线程没有跟上，唤醒它
+        writer_cv_.notify_one();
+        write_back_victim(shard, page, lock);
+    }
+    if (page->id_.page_no != INVALID_PAGE_ID) {
+        unmap_page(shard, page->id_, static_cast<frame_id_t>(page - shard.pages));
+    }
+    page->id_.page_no = INVALID_PAGE_ID;
+}
+
+/**
+ * @description: 等待帧上正在进行的写回完成，只等待这一个帧，其他帧上的I/O完成时被唤醒后继续等待
+ * @param {Shard&} shard 帧所在的分片
+ * @param {Page*} page 目标帧
+ * @param {unique_lock<mutex>&} lock 已持有的分片latch
+ */
+void BufferPoolManager::wait_for_io(Shard& shard, Page* page, std::unique_lock<std::mutex>& lock) {
+    shard.io_cv.wait(lock, [page] { return !page->io_in_progress_; });
+}
+
+/**
+ * @description: 使用私有环的顺序扫描缺页时，为目标页面之后至多BAS_READ_BATCH_PAGES - 1个同一分片中、
+ *               不在缓冲池中的页面申请环中的帧，之后与目标页面一起用一次向量化读读入。
+ *               扫描不经过共享的预读，这样预读的页面也只占用环中的帧。调用者需持有分片的latch
+ * @param {Shard&} shard 目标页面所在的分片
+ * @param {BufferAccessStrategy*} strategy 访问策略
+ * @param {PageId} page_id 目标页面
+ * @param {vector<frame_id_t>*} frames 已含目标页面的帧，申请到的帧按页号顺序追加到其末尾
+ * @param {unique_lock<mutex>&} lock 已持有的分片latch
+ */
+void BufferPoolManager::claim_ring_batch(Shard& shard, BufferAccessStrategy* strategy, PageId page_id,
+                                         std::vector<frame_id_t>* frames, std::unique_lock<std::mutex>& lock) {
+    page_id_t num_pages = disk_manager_->get_fd2pageno(page_id.fd);
+    for (page_id_t page_no = page_id.page_no + 1;
+         page_no < num_pages && frames->size() < static_cast<size_t>(BAS_READ_BATCH_PAGES); page_no++) {
+        PageId next_page_id{page_id.fd, page_no};
+        frame_id_t next_frame_id;
+        if (&shard_of(next_page_id) != &shard || shard.page_table->contains(next_page_id) ||
+            shard.loading.count(next_page_id) || !find_victim_page(shard, &next_frame_id, strategy)) {
+            break;
+        }
+        evict_frame(shard, &shard.pages[next_frame_id], lock);
+        // 写回淘汰页期间释放了latch，其他线程可能已经开始读入该页面
+        if (shard.page_table->contains(next_page_id) || shard.loading.count(next_page_id)) {
+            release_frame(shard, next_frame_id);
+            break;
+        }
+        add_to_ring(shard, strategy, next_frame_id, next_page_id);
+        frames->push_back(next_frame_id);
+    }
+}
+
+/**
+ * @description: 把文件中从start_page_id开始的连续页面读入已申请的帧frames，第i个帧读入页号start_page_id.page_no + i的页面。
+ *               读盘前把这些页面登记在分片的loading中并释放latch，同一页面的其他请求者等待读入完成，
+ *               访问其他页面的线程不受影响。各页面作为异步读请求同时在途，某个页面读取失败(已分配但还没有写入磁盘)
+ *               不影响其他页面。
+ *               没有读入或读入期间被取消的页面，其帧放回free_list；第一个页面也读取失败时抛出异常
+ * @return {vector<bool>} 每个帧是否成功读入了页面，由调用者把它们加入页表
+ * @param {Shard&} shard 帧所在的分片
+ * @param {PageId} start_page_id 第一个页面
+ * @param {vector<frame_id_t>&} frames 已申请的帧，不在free_list和replacer中
+ * @param {unique_lock<mutex>&} lock 已持有的分片latch，返回时仍持有
+ */
+std::vector<bool> BufferPoolManager::read_frames(Shard& shard, PageId start_page_id,
+                                                 const std::vector<frame_id_t>& frames,
+                                                 std::unique_lock<std::mutex>& lock) {
+    std::vector<std::pair<page_id_t, char *>> pages;
+    for (size_t i = 0; i < frames.size(); i++) {
+        page_id_t page_no = start_page_id.page_no + static_cast<page_id_t>(i);
+        shard.loading[PageId{start_page_id.fd, page_no}] = false;
+        pages.emplace_back(page_no, shard.pages[frames[i]].data_);
+    }
+    lock.unlock();
+    std::vector<bool> read_ok = read_pages_async(start_page_id.fd, pages);
+    std::exception_ptr error;
+    if (!read_ok[0]) {
+        // 重新同步读取第一个页面，失败时得到与read_page相同的异常
+        try {
+            disk_manager_->read_page(start_page_id.fd, start_page_id.page_no, pages[0].second, PAGE_SIZE);
+            read_ok[0] = true;
+        } catch (UniBaseError &) {
+            error = std::current_exception();
+        }
+    }
+    lock.lock();
+    std::vector<bool> loaded(frames.size());
+    for (size_t i = 0; i < frames.size(); i++) {
+        PageId page_id{start_page_id.fd, start_page_id.page_no + static_cast<page_id_t>(i)};
+        loaded[i] = read_ok[i] && !shard.loading[page_id];
+        shard.loading.erase(page_id);
+        if (!loaded[i]) {
+            release_frame(shard, frames[i]);
+        }
+    }
+    shard.io_cv.notify_all();
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    return loaded;
+}
+
+/**
+ * @description: 把每个页面作为一个异步读请求通过DiskManager::submit_read提交，至多ASYNC_IO_QUEUE_DEPTH个请求同时在途，
+ *               再用poll_completions收割结果。调用时当前线程的I/O队列中不能有其他在途请求，不需要持有任何latch
+ * @return {vector<bool>} 每个页面是否完整读入
+ * @param {int} fd 页面所在文件
+ * @param {vector<pair<page_id_t, char*>>&} pages 页号和读入的目标缓冲区
+ */
+std::vector<bool> BufferPoolManager::read_pages_async(int fd, const std::vector<std::pair<page_id_t, char *>> &pages) {
+    std::vector<bool> loaded(pages.size(), false);
+    std::vector<IoCompletion> completions;
+    size_t submitted = 0;
+    size_t completed = 0;
+    while (completed < pages.size()) {
+        while (submitted < pages.size() && submitted - completed < ASYNC_IO_QUEUE_DEPTH) {
+            try {
+                disk_manager_->submit_read(fd, pages[submitted].first, pages[submitted].second, PAGE_SIZE, submitted);
+            } catch (UniBaseError &) {
+                // 文件已被关闭，该页面不读入
+                completed++;
+            }
+            submitted++;
+        }
+        if (completed == submitted) {
+            continue;
+        }
+        completions.clear();
+        completed += disk_manager_->poll_completions(&completions, 1);
+        for (auto &completion : completions) {
+            loaded[completion.user_data] = completion.result == PAGE_SIZE;
+            // 内核拒绝了该请求(如不支持的操作)时改为同步读，不因此丢掉整批页面
+            if (completion.result == -EINVAL) {
+                try {
+                    const auto &page = pages[completion.user_data];
+                    disk_manager_->read_page(fd, page.first, page.second, PAGE_SIZE);
+                    loaded[completion.user_data] = true;
+                } catch (UniBaseError &) {
+                }
+            }
+        }
+    }
+    return loaded;
+}
+
 /**
  * @description: 更新页面数据, 如果为脏页则需写入磁盘，再更新为新页面，更新page元数据(data, is_dirty, page_id)和page table
+ * @param {Shard&} shard 页面所在的分片
  * @param {Page*} page 写回页指针
  * @param {PageId} new_page_id 新的page_id
  * @param {frame_id_t} new_frame_id 新的帧frame_id
+ * @param {unique_lock<mutex>&} lock 已持有的分片latch，写回期间会暂时释放
  */
-void BufferPoolManager::update_page(Page *page, PageId new_page_id, frame_id_t new_frame_id) {
+void BufferPoolManager::update_page(Shard& shard, Page *page, PageId new_page_id, frame_id_t new_frame_id,
+                                    std::unique_lock<std::mutex>& lock) {
     // Todo:
     // 1 如果是脏页，写回磁盘，并且把dirty置为false
     // 2 更新page table
     // 3 重置page的data，更新page id
-    if(page->is_dirty_){
-        disk_manager_->write_page(page->id_.fd,page->id_.page_no,page->data_,PAGE_SIZE);
-        page->is_dirty_=false;
-    }
-    page_table_.erase(page->id_);
-    page_table_[new_page_id]=new_frame_id;
+    evict_frame(shard, page, lock);
     memset(page->data_, 0, PAGE_SIZE);
     page->id_ = new_page_id;
     page->is_dirty_ = false;
     page->pin_count_ = 0;
+    map_page(shard, new_page_id, new_frame_id);
 
 }
 
@@ -53,10 +441,13 @@ void BufferPoolManager::update_page(Page *page, PageId new_page_id, frame_id_t n
  * @description: 从buffer pool获取需要的页。
  *              如果页表中存在page_id（说明该page在缓冲池中），并且pin_count++。
  *              如果页表不存在page_id（说明该page在磁盘中），则找缓冲池victim page，将其替换为磁盘中读取的page，pin_count置1。
+ *              传入访问策略时缺页只在策略的私有环中循环使用帧，不触发共享的预读，改为批量读入后续页面。
+ *              读写磁盘期间不持有分片的latch，命中缓冲池的访问不会被其他线程的缺页阻塞
  * @return {Page*} 若获得了需要的页则将其返回，否则返回nullptr
  * @param {PageId} page_id 需要获取的页的PageId
+ * @param {BufferAccessStrategy*} strategy 大表扫描等使用的访问策略，为nullptr时使用整个缓冲池
  */
-Page* BufferPoolManager::fetch_page(PageId page_id) {
+Page* BufferPoolManager::fetch_page(PageId page_id, BufferAccessStrategy* strategy) {
     //Todo:
     // 1.     从page_table_中搜寻目标页
     // 1.1    若目标页有被page_table_记录，则将其所在frame固定(pin)，并返回目标页。
@@ -65,34 +456,85 @@ Page* BufferPoolManager::fetch_page(PageId page_id) {
     // 3.     调用disk_manager_的read_page读取目标页到frame
     // 4.     固定目标页，更新pin_count_
     // 5.     返回目标页
-    std::lock_guard<std::mutex> lock(latch_);
-    auto it = page_table_.find(page_id);
-    if (it != page_table_.end()) {
-        frame_id_t frame_id = it->second;
-        Page* page = &pages_[frame_id];
-        page->pin_count_++;
-        replacer_->pin(frame_id);
-        return page;
-    }
-    frame_id_t frame_id;
-    if (!find_victim_page(&frame_id)) {
-        return nullptr;
-    }
-    Page* page = &pages_[frame_id];
-    if (page->is_dirty_) {
-        disk_manager_->write_page(page->id_.fd, page->id_.page_no, page->data_, PAGE_SIZE);
+    // 只需持有目标页所在分片的latch
+    Shard& shard = shard_of(page_id);
+    std::unique_lock<std::mutex> lock(shard.latch);
+    while (true) {
+        frame_id_t frame_id = shard.page_table->find(page_id);
+        if (frame_id != INVALID_FRAME_ID) {
+            Page* page = &shard.pages[frame_id];
+            // 页面正在被写回时内容不能被修改，等待写回完成后重新查找
+            if (page->io_in_progress_) {
+                wait_for_io(shard, page, lock);
+                continue;
+            }
+            page->pin_count_++;
+            sync_shared_frame(page);
+            shard.replacer->pin(frame_id);
+            record_access(shard, frame_id, page_id);
+            lock.unlock();
+            if (strategy == nullptr) {
+                on_page_access(page_id);
+            }
+            return page;
+        }
+        // 目标页正在被其他线程读入时等待读入完成，避免重复读盘
+        if (shard.loading.count(page_id)) {
+            shard.io_cv.wait(lock);
+            continue;
+        }
+        if (!find_victim_page(shard, &frame_id, strategy)) {
+            // 没有可用的帧时，只要还有读写在进行，它占用的帧很快会变为可淘汰，等待后重试
+            if (shard.loading.empty() && shard.num_writing == 0) {
+                return nullptr;
+            }
+            shard.io_cv.wait(lock);
+            continue;
+        }
+        evict_frame(shard, &shard.pages[frame_id], lock);
+        // 写回淘汰页期间释放了latch，其他线程可能已经开始读入目标页面
+        if (shard.page_table->contains(page_id) || shard.loading.count(page_id)) {
+            release_frame(shard, frame_id);
+            continue;
+        }
+        std::vector<frame_id_t> frames{frame_id};
+        if (strategy != nullptr) {
+            add_to_ring(shard, strategy, frame_id, page_id);
+            if (strategy->type_ == BufferAccessType::BULK_READ) {
+                claim_ring_batch(shard, strategy, page_id, &frames, lock);
+            }
+        }
+        std::vector<bool> loaded = read_frames(shard, page_id, frames, lock);
+        for (size_t i = 1; i < frames.size(); i++) {
+            if (!loaded[i]) {
+                continue;
+            }
+            PageId next_page_id{page_id.fd, page_id.page_no + static_cast<page_id_t>(i)};
+            Page* page = &shard.pages[frames[i]];
+            page->id_ = next_page_id;
+            page->is_dirty_ = false;
+            page->pin_count_ = 0;
+            map_page(shard, next_page_id, frames[i]);
+            shard.replacer->record_access(frames[i], page_key(next_page_id));
+            shard.replacer->unpin(frames[i]);
+        }
+        // 读盘期间页面被删除或重新分配，读入的内容已经失效，重新查找
+        if (!loaded[0]) {
+            continue;
+        }
+        Page* page = &shard.pages[frame_id];
+        page->id_ = page_id;
         page->is_dirty_ = false;
+        page->pin_count_ = 1;
+        shard.replacer->pin(frame_id);
+        map_page(shard, page_id, frame_id);
+        record_access(shard, frame_id, page_id);
+        lock.unlock();
+        if (strategy == nullptr) {
+            on_page_access(page_id);
+        }
+        return page;
     }
-    if (page->id_.page_no != INVALID_PAGE_ID) {
-        page_table_.erase(page->id_);
-    }
-    disk_manager_->read_page(page_id.fd, page_id.page_no, page->data_, PAGE_SIZE);
-    page->id_ = page_id;
-    page->is_dirty_ = false;
-    page->pin_count_ = 1;
-    replacer_->pin(frame_id);
-    page_table_[page_id] = frame_id;
-    return page;
 }
 
 /**
@@ -111,28 +553,34 @@ bool BufferPoolManager::unpin_page(PageId page_id, bool is_dirty) {
     // 2.2 若pin_count_大于0，则pin_count_自减一
     // 2.2.1 若自减后等于0，则调用replacer_的Unpin
     // 3 根据参数is_dirty，更改P的is_dirty_
-    std::lock_guard<std::mutex> lock(latch_);
-    auto it = page_table_.find(page_id);
-    if (it == page_table_.end()){
+    Shard &shard = shard_of(page_id);
+    std::lock_guard<std::mutex> lock(shard.latch);
+    frame_id_t frame_id = shard.page_table->find(page_id);
+    if (frame_id == INVALID_FRAME_ID){
         return false;
     }
-    frame_id_t frame_id = it->second;
-    Page *page = &pages_[frame_id];
+    Page *page = &shard.pages[frame_id];
     if (page->pin_count_ <= 0){
         return false;
     }
     page->pin_count_--;
     if (page->pin_count_ == 0) {
-        replacer_->unpin(frame_id);
+        shard.replacer->unpin(frame_id);
+        // 缩小缓冲池时被固定的页面阻止腾空被移除的帧，它们被取消固定后唤醒resize()重试
+        if (shard.shrinking) {
+            shard.io_cv.notify_all();
+        }
     }
     if (is_dirty){
-        page->is_dirty_ = true;
+        set_dirty(shard, frame_id, true);
     }
+    sync_shared_frame(page);
     return true;
 }
 
 /**
- * @description: 将目标页写回磁盘，不考虑当前页面是否正在被使用
+ * @description: 将目标页写回磁盘，不考虑当前页面是否正在被使用。页面被固定后释放分片的latch，
+ *               由write_pinned_run()在页面的读锁下复制页面再写盘，写入的不会是写到一半的页面
  * @return {bool} 成功则返回true，否则返回false(只有page_table_中没有目标页时)
  * @param {PageId} page_id 目标页的page_id，不能为INVALID_PAGE_ID
  */
@@ -143,15 +591,32 @@ bool BufferPoolManager::flush_page(PageId page_id) {
     // 1.1 目标页P没有被page_table_记录 ，返回false
     // 2. 无论P是否为脏都将其写回磁盘。
     // 3. 更新P的is_dirty_
-    std::lock_guard<std::mutex> lock(latch_);
-    auto it = page_table_.find(page_id);
-    if (it == page_table_.end()){
+    Shard &shard = shard_of(page_id);
+    std::unique_lock<std::mutex> lock(shard.latch);
+    frame_id_t frame_id = shard.page_table->find(page_id);
+    // 页面正在被写回时等待写回完成，之后它可能已经被淘汰
+    while (frame_id != INVALID_FRAME_ID && shard.pages[frame_id].io_in_progress_) {
+        wait_for_io(shard, &shard.pages[frame_id], lock);
+        frame_id = shard.page_table->find(page_id);
+    }
+    if (frame_id == INVALID_FRAME_ID){
         return false;
     }
-    Page *page = &pages_[it->second];
-    disk_manager_->write_page(page->id_.fd,page->id_.page_no,page->data_,PAGE_SIZE);
-    page->is_dirty_ = false;
-
+    Page *page = &shard.pages[frame_id];
+    page->pin_count_++;
+    sync_shared_frame(page);
+    shard.replacer->pin(frame_id);
+    lock.unlock();
+    std::exception_ptr error;
+    try {
+        write_pinned_run(shard, {page});
+    } catch (UniBaseError &) {
+        error = std::current_exception();
+    }
+    unpin_page(page_id, false);
+    if (error) {
+        std::rethrow_exception(error);
+    }
     return true;
 }
 
@@ -159,38 +624,51 @@ bool BufferPoolManager::flush_page(PageId page_id) {
  * @description: 创建一个新的page，即从磁盘中移动一个新建的空page到缓冲池某个位置。
  * @return {Page*} 返回新创建的page，若创建失败则返回nullptr
  * @param {PageId*} page_id 当成功创建一个新的page时存储其page_id
+ * @param {BufferAccessStrategy*} strategy 批量写入使用的访问策略，为nullptr时使用整个缓冲池
  */
-Page* BufferPoolManager::new_page(PageId* page_id) {
-    // 1.   获得一个可用的frame，若无法获得则返回nullptr
-    // 2.   在fd对应的文件分配一个新的page_id
+Page* BufferPoolManager::new_page(PageId* page_id, BufferAccessStrategy* strategy) {
+    // 1.   在fd对应的文件分配一个新的page_id，它决定了页面所在的分片
+    // 2.   在分片中获得一个可用的frame，若无法获得则释放刚分配的页面并返回nullptr
     // 3.   将frame的数据写回磁盘
     // 4.   固定frame，更新pin_count_
     // 5.   返回获得的page
-    std::lock_guard<std::mutex> lock(latch_);
-    frame_id_t frame_id;
-    if (!find_victim_page(&frame_id)){
-        return nullptr;
-    }
-    Page *page = &pages_[frame_id];
-    if (page->is_dirty_) {
-        disk_manager_->write_page(page->id_.fd,page->id_.page_no,page->data_,PAGE_SIZE);
-        page->is_dirty_ = false;
-    }
-    if (page->id_.page_no != INVALID_PAGE_ID) {
-        page_table_.erase(page->id_);
-    }
     int use_fd = page_id->fd;
     // if (use_fd < 0) {
     //     use_fd = this->fd;  
     // }
-    page_id->page_no = disk_manager_->allocate_page(use_fd);
-    page_id->fd = use_fd;
+    PageId new_page_id{use_fd, disk_manager_->allocate_page(use_fd)};
+    Shard &shard = shard_of(new_page_id);
+    std::unique_lock<std::mutex> lock(shard.latch);
+    frame_id_t frame_id;
+    while (!find_victim_page(shard, &frame_id, strategy)) {
+        if (shard.loading.empty() && shard.num_writing == 0) {
+            disk_manager_->deallocate_page(use_fd, new_page_id.page_no);
+            return nullptr;
+        }
+        shard.io_cv.wait(lock);
+    }
+    Page *page = &shard.pages[frame_id];
+    evict_frame(shard, page, lock);
+    *page_id = new_page_id;
+    if (strategy != nullptr) {
+        add_to_ring(shard, strategy, frame_id, *page_id);
+    }
+    // 预读或其他线程的fetch_page可能已经把这个之前被释放的页面读入了缓冲池，页面被重新分配后这份旧内容不再有意义
+    cancel_readahead(shard, *page_id);
+    frame_id_t stale_frame_id = shard.page_table->find(*page_id);
+    if (stale_frame_id != INVALID_FRAME_ID) {
+        unmap_page(shard, *page_id, stale_frame_id);
+        shard.replacer->pin(stale_frame_id);
+        shard.pages[stale_frame_id].id_.page_no = INVALID_PAGE_ID;
+        release_frame(shard, stale_frame_id);
+    }
     memset(page->data_, 0, PAGE_SIZE);
     page->id_ = *page_id;
     page->pin_count_ = 1;
     page->is_dirty_ = false;
-    replacer_->pin(frame_id);
-    page_table_[*page_id] = frame_id;
+    shard.replacer->pin(frame_id);
+    map_page(shard, *page_id, frame_id);
+    record_access(shard, frame_id, *page_id);
     return page;
 }
 
@@ -200,45 +678,1238 @@ Page* BufferPoolManager::new_page(PageId* page_id) {
  * @param {PageId} page_id 目标页
  */
 bool BufferPoolManager::delete_page(PageId page_id) {
-    // 1.   在page_table_中查找目标页，若不存在返回true
+    // 1.   在page_table_中查找目标页，若不存在则直接在磁盘上释放该页面，返回true
     // 2.   若目标页的pin_count不为0，则返回false
-    // 3.   将目标页数据写回磁盘，从页表中删除目标页，重置其元数据，将其加入free_list_，返回true
-    std::lock_guard<std::mutex> lock(latch_);
-    auto it = page_table_.find(page_id);
-    if (it == page_table_.end()) {
-        disk_manager_->deallocate_page(page_id.page_no);
+    // 3.   从页表中删除目标页，重置其元数据，将其加入free_list_，并在磁盘上释放该页面，返回true
+    //      页面被释放后其内容不再有意义，脏页不需要写回
+    Shard &shard = shard_of(page_id);
+    std::unique_lock<std::mutex> lock(shard.latch);
+    cancel_readahead(shard, page_id);
+    frame_id_t frame_id = shard.page_table->find(page_id);
+    while (frame_id != INVALID_FRAME_ID && shard.pages[frame_id].io_in_progress_) {
+        wait_for_io(shard, &shard.pages[frame_id], lock);
+        frame_id = shard.page_table->find(page_id);
+    }
+    if (frame_id == INVALID_FRAME_ID) {
+        disk_manager_->deallocate_page(page_id.fd, page_id.page_no);
         return true;
     }
-    frame_id_t frame_id = it->second;
-    Page *page = &pages_[frame_id];
+    Page *page = &shard.pages[frame_id];
     if (page->pin_count_ > 0){
         return false;
     }
-    if (page->is_dirty_) {
-        disk_manager_->write_page(page->id_.fd,page->id_.page_no,page->data_,PAGE_SIZE);
-        page->is_dirty_ = false;
-    }
-    page_table_.erase(page_id);
-    disk_manager_->deallocate_page(page_id.page_no);
+    unmap_page(shard, page_id, frame_id);
+    shard.replacer->pin(frame_id);
+    disk_manager_->deallocate_page(page_id.fd, page_id.page_no);
     memset(page->data_, 0, PAGE_SIZE);
     page->id_.page_no = INVALID_PAGE_ID;
     page->pin_count_ = 0;
     page->is_dirty_ = false;
-    free_list_.push_back(frame_id);
+    release_frame(shard, frame_id);
     return true;
 }
 
 /**
- * @description: 将buffer_pool中的所有页写回到磁盘
+ * @description: 将buffer_pool中文件fd的所有脏页写回到磁盘
+ * 逐个分片处理：等待分片中正在进行的写回完成，只取出该文件在分片中的脏帧，按page_no排序后把页号连续的页面合并成一段，
+ * 每段只需一次pwritev。开销与该文件的脏页个数成正比，与缓冲池大小和其他文件无关。
+ * 脏页被固定后释放分片的latch，由write_pinned_run()逐段写回，不访问这些页面的线程照常使用该分片
  * @param {int} fd 文件句柄
  */
 void BufferPoolManager::flush_all_pages(int fd) {
-    std::unique_lock<std::mutex> lock(latch_);
-    for (size_t frame_id = 0; frame_id < pool_size_; frame_id++) {
-        Page *page = &pages_[frame_id];
-        if (page->id_.page_no != INVALID_PAGE_ID) {
-            disk_manager_->write_page(page->id_.fd,page->id_.page_no,page->data_,PAGE_SIZE);
-            page->is_dirty_ = false;
+    for (size_t i = 0; i < num_shards_; i++) {
+        Shard &shard = shards_[i];
+        std::unique_lock<std::mutex> lock(shard.latch);
+        shard.io_cv.wait(lock, [&shard] { return shard.num_writing == 0; });
+        auto file = shard.files.find(fd);
+        if (file == shard.files.end() || file->second.dirty.empty()) {
+            continue;
+        }
+        std::vector<Page *> dirty;
+        for (frame_id_t frame_id : file->second.dirty) {
+            dirty.push_back(&shard.pages[frame_id]);
+        }
+        std::sort(dirty.begin(), dirty.end(),
+                  [](const Page *a, const Page *b) { return a->id_.page_no < b->id_.page_no; });
+        for (Page *page : dirty) {
+            page->pin_count_++;
+            sync_shared_frame(page);
+            shard.replacer->pin(static_cast<frame_id_t>(page - shard.pages));
+        }
+        lock.unlock();
+        std::exception_ptr error;
+        try {
+            std::vector<Page *> run;
+            for (Page *page : dirty) {
+                if (!run.empty() && (run.back()->id_.page_no + 1 != page->id_.page_no ||
+                                     run.size() >= static_cast<size_t>(IO_BATCH_MAX_PAGES))) {
+                    write_pinned_run(shard, run);
+                    run.clear();
+                }
+                run.push_back(page);
+            }
+            if (!run.empty()) {
+                write_pinned_run(shard, run);
+            }
+        } catch (UniBaseError &) {
+            error = std::current_exception();
+        }
+        for (Page *page : dirty) {
+            unpin_page(page->id_, false);
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+/**
+ * @description: 将文件fd的所有页面移出缓冲池，脏页不写回，用于删除表、删除索引以及关闭已刷盘的文件。
+ * 取消该文件正在进行的预读，只处理该文件在各分片中的帧，被释放的帧放回free_list。
+ * 调用者需保证该文件的页面都没有被固定，仍被固定的页面留在缓冲池中
+ * @param {int} fd 文件句柄
+ */
+void BufferPoolManager::drop_all_pages(int fd) {
+    for (size_t i = 0; i < num_shards_; i++) {
+        Shard &shard = shards_[i];
+        std::unique_lock<std::mutex> lock(shard.latch);
+        for (auto &entry : shard.loading) {
+            if (entry.first.fd == fd) {
+                entry.second = true;
+            }
+        }
+        auto file = shard.files.find(fd);
+        if (file == shard.files.end()) {
+            continue;
+        }
+        std::vector<frame_id_t> frames(file->second.resident.begin(), file->second.resident.end());
+        for (frame_id_t frame_id : frames) {
+            Page *page = &shard.pages[frame_id];
+            wait_for_io(shard, page, lock);
+            // 等待写回期间释放了latch，帧可能已被淘汰或重新使用
+            if (page->id_.fd != fd || page->id_.page_no == INVALID_PAGE_ID || page->pin_count_ > 0) {
+                continue;
+            }
+            // 正常关闭数据库时，已写回的页面留在共享内存的帧中，由下一个进程接管
+            bool retain = shared_segment_ != nullptr && retain_shared_frames_ && !page->is_dirty_;
+            SharedFrameSegment::FrameDesc retained{};
+            if (retain) {
+                retained = shared_segment_->desc(static_cast<size_t>(page - pages_));
+            }
+            unmap_page(shard, page->id_, frame_id);
+            if (retain) {
+                shared_segment_->desc(static_cast<size_t>(page - pages_)) = retained;
+            }
+            shard.replacer->pin(frame_id);
+            page->id_.page_no = INVALID_PAGE_ID;
+            release_frame(shard, frame_id);
+        }
+    }
+}
+
+/**
+ * @description: 在线调整缓冲池使用的帧个数，不超过创建时预留的帧个数。各分片依次调整，每个分片只在调整时持有它的latch，
+ *               调整期间其他分片以及该分片写回、等待期间的访问都照常进行。
+ *               扩大时把新增的帧放入free_list；缩小时分片先不再使用被移除的帧，再由shrink_shard()腾空它们，
+ *               被固定的页面等它们被取消固定后再处理，最后把被移除的帧的内存归还给操作系统
+ * @param {size_t} new_pool_size 新的帧个数，至少为分片个数
+ */
+void BufferPoolManager::resize(size_t new_pool_size) {
+    if (new_pool_size < num_shards_ || new_pool_size > max_pool_size_) {
+        throw InternalError("BufferPoolManager::resize: pool size must be between " + std::to_string(num_shards_) +
+                            " and " + std::to_string(max_pool_size_));
+    }
+    std::lock_guard<std::mutex> resize_lock(resize_latch_);
+    // 还没有接管的共享内存中的帧可能落在被移除的范围内，放弃接管它们
+    {
+        std::lock_guard<std::mutex> shared_lock(shared_latch_);
+        for (size_t frame : shared_candidates_) {
+            drop_shared_frame(frame);
+        }
+        shared_candidates_.clear();
+    }
+    size_t num_active_frames = 0;
+    for (size_t i = 0; i < num_shards_; i++) {
+        Shard &shard = shards_[i];
+        size_t target = shard_active_frames(i, new_pool_size);
+        std::unique_lock<std::mutex> lock(shard.latch);
+        size_t old_active = shard.num_active;
+        if (target >= old_active) {
+            for (size_t frame_id = old_active; frame_id < target; frame_id++) {
+                shard.free_list.push_back(static_cast<frame_id_t>(frame_id));
+            }
+            shard.num_active = target;
+        } else {
+            shard.num_active = target;
+            shard.free_list.remove_if([target](frame_id_t frame_id) { return frame_id >= static_cast<frame_id_t>(target); });
+            // 有页面被固定或正在读写时等待，页面被取消固定、读写完成时都会通知io_cv
+            shard.shrinking = true;
+            while (!shrink_shard(shard, lock)) {
+                shard.io_cv.wait(lock);
+            }
+            shard.shrinking = false;
+            arena_->release(shard.pages[target].data_, (old_active - target) * PAGE_SIZE);
+        }
+        shard.clean_target = std::max<size_t>(1, shard.num_active * BG_WRITER_CLEAN_PERCENT / 100);
+        num_active_frames += shard.num_active;
+    }
+    pool_size_ = num_active_frames;
+}
+
+/**
+ * @description: 腾空分片中被移除的帧[num_active, size)。分片中的页面多于保留的帧时，按replacer的淘汰顺序淘汰页面，
+ *               先淘汰干净页，不够时才写回并淘汰脏页；被移除的帧中剩下的页面移动到保留的空闲帧中。
+ *               调用者需持有分片的latch，写回期间会暂时释放它
+ * @return {bool} 被移除的帧都已腾空，且没有在此之前申请的帧仍在读写中时返回true；有页面被固定或正在读写时返回false，调用者等待io_cv后重试
+ * @param {Shard&} shard 目标分片，num_active已经设为新的大小
+ * @param {unique_lock<mutex>&} lock 已持有的分片latch，返回时仍持有
+ */
+bool BufferPoolManager::shrink_shard(Shard& shard, std::unique_lock<std::mutex>& lock) {
+    frame_id_t target = static_cast<frame_id_t>(shard.num_active);
+    auto num_retiring_pages = [&shard, target]() {
+        size_t count = 0;
+        for (size_t frame_id = target; frame_id < shard.size; frame_id++) {
+            count += shard.pages[frame_id].id_.page_no != INVALID_PAGE_ID;
+        }
+        return count;
+    };
+    size_t num_retiring = num_retiring_pages();
+    // 脏页写回后在下一轮才作为干净页被淘汰，一直重复到没有页面可以淘汰为止
+    bool progress = true;
+    while (progress && num_retiring > shard.free_list.size()) {
+        progress = false;
+        for (bool evict_dirty : {false, true}) {
+            std::vector<frame_id_t> candidates;
+            shard.replacer->peek_victims(&candidates, shard.size);
+            // find_victim_page()会把replacer选出的被移除的帧丢弃，其中的页面不再在replacer中，也作为候选
+            std::vector<bool> is_candidate(shard.size, false);
+            for (frame_id_t frame_id : candidates) {
+                is_candidate[frame_id] = true;
+            }
+            for (frame_id_t frame_id = target; frame_id < static_cast<frame_id_t>(shard.size); frame_id++) {
+                if (!is_candidate[frame_id]) {
+                    candidates.push_back(frame_id);
+                }
+            }
+            for (frame_id_t frame_id : candidates) {
+                if (num_retiring <= shard.free_list.size()) {
+                    break;
+                }
+                Page *page = &shard.pages[frame_id];
+                if (page->id_.page_no == INVALID_PAGE_ID || page->pin_count_ > 0 || page->io_in_progress_ ||
+                    page->is_dirty_ != evict_dirty) {
+                    continue;
+                }
+                if (page->is_dirty_) {
+                    try {
+                        write_back_victim(shard, page, lock);
+                    } catch (UniBaseError &) {
+                        continue;
+                    }
+                    // 写回期间释放了latch，帧可能已被固定、淘汰或再次改脏
+                    num_retiring = num_retiring_pages();
+                    if (page->id_.page_no == INVALID_PAGE_ID || page->pin_count_ > 0 || page->io_in_progress_ ||
+                        page->is_dirty_) {
+                        continue;
+                    }
+                }
+                if (frame_id >= target) {
+                    num_retiring--;
+                }
+                discard_frame(shard, frame_id);
+                progress = true;
+            }
+        }
+    }
+    bool done = true;
+    for (frame_id_t frame_id = target; frame_id < static_cast<frame_id_t>(shard.size); frame_id++) {
+        Page *page = &shard.pages[frame_id];
+        if (page->id_.page_no == INVALID_PAGE_ID) {
+            continue;
+        }
+        if (page->pin_count_ > 0 || page->io_in_progress_ || shard.free_list.empty()) {
+            done = false;
+            continue;
+        }
+        frame_id_t dst_frame_id = shard.free_list.front();
+        shard.free_list.pop_front();
+        relocate_frame(shard, frame_id, dst_frame_id);
+    }
+    // 缩小之前申请的帧可能仍在读入或写回，完成后才会出现在页表中或回到free_list
+    return done && shard.loading.empty() && shard.num_writing == 0;
+}
+
+/**
+ * @description: 获取页面并加共享锁，返回的读保护在析构时自动释放锁并取消固定。
+ *               页面锁在固定页面之后、不持有分片latch时获取，等待页面锁不会阻塞分片上的其他操作
+ * @return {ReadPageGuard} 页面的读保护，无法获得页面时不持有页面(is_valid()为false)
+ * @param {PageId} page_id 目标页面
+ * @param {BufferAccessStrategy*} strategy 大表扫描等使用的访问策略，为nullptr时使用整个缓冲池
+ */
+ReadPageGuard BufferPoolManager::fetch_page_read(PageId page_id, BufferAccessStrategy* strategy) {
+    Page *page = fetch_page(page_id, strategy);
+    if (page == nullptr) {
+        return ReadPageGuard();
+    }
+    page->rlatch();
+    return ReadPageGuard(this, page);
+}
+
+/**
+ * @description: 获取页面并加独占锁，返回的写保护在析构时自动释放锁并以脏页取消固定
+ * @return {WritePageGuard} 页面的写保护，无法获得页面时不持有页面(is_valid()为false)
+ * @param {PageId} page_id 目标页面
+ * @param {BufferAccessStrategy*} strategy 批量写入使用的访问策略，为nullptr时使用整个缓冲池
+ */
+WritePageGuard BufferPoolManager::fetch_page_write(PageId page_id, BufferAccessStrategy* strategy) {
+    Page *page = fetch_page(page_id, strategy);
+    if (page == nullptr) {
+        return WritePageGuard();
+    }
+    page->wlatch();
+    return WritePageGuard(this, page);
+}
+
+/**
+ * @description: 创建一个新页面并加独占锁，返回的写保护在析构时自动释放锁并以脏页取消固定
+ * @return {WritePageGuard} 新页面的写保护，创建失败时不持有页面(is_valid()为false)
+ * @param {PageId*} page_id 成功创建新页面时存储其page_id
+ * @param {BufferAccessStrategy*} strategy 批量写入使用的访问策略，为nullptr时使用整个缓冲池
+ */
+WritePageGuard BufferPoolManager::new_page_guarded(PageId* page_id, BufferAccessStrategy* strategy) {
+    Page *page = new_page(page_id, strategy);
+    if (page == nullptr) {
+        return WritePageGuard();
+    }
+    page->wlatch();
+    return WritePageGuard(this, page);
+}
+
+/**
+ * @description: 获取页面用于乐观读：只固定页面不加页面锁，读取后需用OptimisticPageGuard::validate()验证
+ * @return {OptimisticPageGuard} 页面的乐观读保护，无法获得页面时不持有页面(is_valid()为false)
+ * @param {PageId} page_id 目标页面
+ * @param {BufferAccessStrategy*} strategy 大表扫描等使用的访问策略，为nullptr时使用整个缓冲池
+ */
+OptimisticPageGuard BufferPoolManager::fetch_page_optimistic(PageId page_id, BufferAccessStrategy* strategy) {
+    Page *page = fetch_page(page_id, strategy);
+    if (page == nullptr) {
+        return OptimisticPageGuard();
+    }
+    return OptimisticPageGuard(this, page);
+}
+
+/**
+ * @description: 通过swizzle引用获取页面用于乐观读。页面已被swizzle时直接得到它所在的帧，不查页表、不加分片的latch、
+ *               不固定页面：取得版本号后引用仍指向该帧，说明此时帧中就是该页面，之后页面离开帧时版本号会变化，
+ *               validate()失败。否则经过页表获取并固定页面，同时swizzle它，之后的访问走上面的路径
+ * @return {OptimisticPageGuard} 页面的乐观读保护，缓冲池没有可用的帧时不持有页面
+ * @param {PageId} page_id 目标页面
+ * @param {SwipTable*} swips 页面所在文件的引用表
+ */
+OptimisticPageGuard BufferPoolManager::fetch_page_swizzled(PageId page_id, const SwipTable* swips) {
+    std::atomic<Page*>* swip = ENABLE_POINTER_SWIZZLING ? swips->slot(page_id.page_no) : nullptr;
+    if (swip == nullptr) {
+        return fetch_page_optimistic(page_id);
+    }
+    Page *page = swip->load(std::memory_order_acquire);
+    if (page != nullptr) {
+        uint64_t version = page->begin_optimistic_read();
+        if (swip->load(std::memory_order_acquire) == page) {
+            return OptimisticPageGuard(page, version);
+        }
+    }
+    OptimisticPageGuard guard = fetch_page_optimistic(page_id);
+    if (guard.is_valid()) {
+        Shard &shard = shard_of(page_id);
+        std::lock_guard<std::mutex> lock(shard.latch);
+        swizzle(guard.get_page(), swip);
+    }
+    return guard;
+}
+
+/**
+ * @description: 清空文件fd中所有页面的swizzle引用，页面仍留在缓冲池中，用于文件的SwipTable析构之前
+ * @param {int} fd 文件句柄
+ */
+void BufferPoolManager::unswizzle_file(int fd) {
+    for (size_t i = 0; i < num_shards_; i++) {
+        Shard &shard = shards_[i];
+        std::lock_guard<std::mutex> lock(shard.latch);
+        auto file = shard.files.find(fd);
+        if (file == shard.files.end()) {
+            continue;
+        }
+        for (frame_id_t frame_id : file->second.resident) {
+            if (shard.pages[frame_id].swip_ != nullptr) {
+                unswizzle(&shard.pages[frame_id]);
+            }
+        }
+    }
+}
+
+/**
+ * @description: 写回一个脏的淘汰页。顺带把同一文件中与其页号相邻、同样为脏且未被固定的页面合并成一段连续页面，
+ *               用一次pwritev写回，这些邻居页面变为干净页，之后被淘汰时就不用再写盘。只合并同一分片中的页面。
+ *               写盘期间释放分片的latch，这些页面标记为io_in_progress_，访问它们的线程等待写回完成
+ * @return {size_t} 写回的页面个数
+ * @param {Shard&} shard 淘汰页所在的分片
+ * @param {Page*} victim 即将被替换的脏页
+ * @param {unique_lock<mutex>&} lock 已持有的分片latch，返回时仍持有
+ */
+size_t BufferPoolManager::write_back_victim(Shard &shard, Page *victim, std::unique_lock<std::mutex> &lock) {
+    PageId victim_id = victim->id_;
+    std::vector<Page *> before;
+    std::vector<Page *> after;
+    for (page_id_t page_no = victim_id.page_no - 1;
+         page_no >= 0 && 1 + before.size() < static_cast<size_t>(IO_BATCH_MAX_PAGES); page_no--) {
+        Page *page = find_dirty_unpinned_page(shard, PageId{victim_id.fd, page_no});
+        if (page == nullptr) break;
+        before.push_back(page);
+    }
+    for (page_id_t page_no = victim_id.page_no + 1;
+         1 + before.size() + after.size() < static_cast<size_t>(IO_BATCH_MAX_PAGES); page_no++) {
+        Page *page = find_dirty_unpinned_page(shard, PageId{victim_id.fd, page_no});
+        if (page == nullptr) break;
+        after.push_back(page);
+    }
+    std::vector<Page *> run(before.rbegin(), before.rend());
+    run.push_back(victim);
+    run.insert(run.end(), after.begin(), after.end());
+    for (Page *page : run) {
+        page->io_in_progress_ = true;
+    }
+    shard.num_writing += run.size();
+    lock.unlock();
+    std::exception_ptr error;
+    try {
+        write_page_run(run);
+    } catch (UniBaseError &) {
+        error = std::current_exception();
+    }
+    lock.lock();
+    for (Page *page : run) {
+        page->io_in_progress_ = false;
+        if (!error) {
+            set_dirty(shard, static_cast<frame_id_t>(page - shard.pages), false);
+        }
+    }
+    shard.num_writing -= run.size();
+    shard.io_cv.notify_all();
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    return run.size();
+}
+
+/**
+ * @description: 在分片的页表中查找一个脏、未被固定且没有正在写回的页面，用于合并写回
+ * @return {Page*} 满足条件的页面，否则返回nullptr
+ * @param {Shard&} shard 已持有latch的分片，属于其他分片的页面不合并
+ * @param {PageId} page_id 目标页面的PageId
+ */
+Page *BufferPoolManager::find_dirty_unpinned_page(Shard &shard, PageId page_id) {
+    if (&shard_of(page_id) != &shard) {
+        return nullptr;
+    }
+    frame_id_t frame_id = shard.page_table->find(page_id);
+    if (frame_id == INVALID_FRAME_ID) {
+        return nullptr;
+    }
+    Page *page = &shard.pages[frame_id];
+    return (page->is_dirty_ && page->pin_count_ == 0 && !page->io_in_progress_) ? page : nullptr;
+}
+
+/**
+ * @description: 将同一文件中页号连续的一组页面用一次向量化I/O写回磁盘，由调用者把它们标记为干净页。
+ *               设置了flush_log_时先把日志持久化到这些页面中最大的page_lsn(WAL)
+ * @param {vector<Page*>&} run 按页号升序排列的连续页面
+ */
+void BufferPoolManager::write_page_run(const std::vector<Page *> &run) {
+    std::vector<const char *> pages_data;
+    pages_data.reserve(run.size());
+    for (Page *page : run) {
+        pages_data.push_back(page->data_);
+    }
+    write_pages_logged(run.front()->id_.fd, run.front()->id_.page_no, pages_data);
+}
+
+/**
+ * @description: 把页号连续的一组页面内容写回磁盘，设置了flush_log_时先把日志持久化到这些页面中最大的page_lsn(WAL)
+ * @param {int} fd 文件句柄
+ * @param {page_id_t} start_page_no 第一个页面的页号
+ * @param {vector<const char*>&} pages_data 按页号顺序排列的页面内容，可以是帧本身或它的副本
+ */
+void BufferPoolManager::write_pages_logged(int fd, page_id_t start_page_no, const std::vector<const char *> &pages_data) {
+    std::shared_ptr<const std::function<void(lsn_t)>> flush_log = std::atomic_load(&flush_log_);
+    if (flush_log != nullptr) {
+        // 只有登记过的文件中保存page_lsn的页面参与计算，其他页面在OFFSET_LSN处存放的不是lsn
+        page_id_t first_page_no = first_lsn_page(fd);
+        lsn_t max_lsn = INVALID_LSN;
+        for (size_t i = 0; i < pages_data.size(); i++) {
+            if (start_page_no + static_cast<page_id_t>(i) < first_page_no) {
+                continue;
+            }
+            lsn_t page_lsn;
+            memcpy(&page_lsn, pages_data[i] + Page::OFFSET_LSN, sizeof(lsn_t));
+            max_lsn = std::max(max_lsn, page_lsn);
+        }
+        if (max_lsn != INVALID_LSN) {
+            (*flush_log)(max_lsn);
+        }
+    }
+    disk_manager_->write_pages(fd, start_page_no, pages_data.data(), pages_data.size());
+}
+
+/**
+ * @description: 文件中第一个在Page::OFFSET_LSN处保存page_lsn的页号
+ * @return {page_id_t} 文件没有登记时返回INT_MAX，即所有页面都不保存page_lsn
+ * @param {int} fd 文件句柄
+ */
+page_id_t BufferPoolManager::first_lsn_page(int fd) {
+    std::lock_guard<std::mutex> lock(lsn_files_latch_);
+    auto it = lsn_files_.find(fd);
+    return it == lsn_files_.end() ? INT_MAX : it->second;
+}
+
+/**
+ * @description: 写回一段可能正在被使用的连续页面，页面需已被调用者固定，调用时不持有分片的latch。
+ *               逐个页面获取读锁，把页面连同它的版本号复制出来后立即释放读锁：一次只持有一个页面的读锁，
+ *               不会与按其他顺序获取多个页面写锁的线程(如B+树的分裂)死锁，写入的也不会是写到一半的页面。
+ *               之后把这些页面标记为io_in_progress_再写副本，同一页面的写回依次进行；写完后只有复制之后没有被修改过
+ *               的页面变为干净页，被修改过的页面仍为脏页
+ * @param {Shard&} shard 页面所在的分片
+ * @param {vector<Page*>&} run 按页号升序排列的连续页面
+ */
+void BufferPoolManager::write_pinned_run(Shard &shard, const std::vector<Page *> &run) {
+    // 副本按DIRECT_IO_ALIGNMENT对齐，O_DIRECT下整段仍能用一次pwritev写出，不会退化为逐页中转
+    AlignedBuffer buffer(run.size() * PAGE_SIZE);
+    std::vector<const char *> pages_data(run.size());
+    std::vector<uint64_t> versions(run.size());
+    for (size_t i = 0; i < run.size(); i++) {
+        Page *page = run[i];
+        page->rlatch();
+        memcpy(buffer.data() + i * PAGE_SIZE, page->data_, PAGE_SIZE);
+        versions[i] = page->version_.load(std::memory_order_relaxed);
+        page->runlatch();
+        pages_data[i] = buffer.data() + i * PAGE_SIZE;
+    }
+    std::unique_lock<std::mutex> lock(shard.latch);
+    shard.io_cv.wait(lock, [&run] {
+        return std::none_of(run.begin(), run.end(), [](const Page *page) { return page->io_in_progress_; });
+    });
+    for (Page *page : run) {
+        page->io_in_progress_ = true;
+    }
+    shard.num_writing += run.size();
+    lock.unlock();
+    std::exception_ptr error;
+    try {
+        write_pages_logged(run.front()->id_.fd, run.front()->id_.page_no, pages_data);
+    } catch (UniBaseError &) {
+        error = std::current_exception();
+    }
+    lock.lock();
+    for (size_t i = 0; i < run.size(); i++) {
+        Page *page = run[i];
+        page->io_in_progress_ = false;
+        if (!error) {
+            // 版本号变化说明复制之后页面被修改过，即使之前被其他写回标记为干净也要重新变为脏页
+            bool modified = page->version_.load(std::memory_order_acquire) != versions[i];
+            set_dirty(shard, static_cast<frame_id_t>(page - shard.pages), modified);
+        }
+    }
+    shard.num_writing -= run.size();
+    shard.io_cv.notify_all();
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+/**
+ * @description: 把一次页面访问告知replacer，正在记录访问序列时同时写入访问序列文件。调用者需持有分片的latch
+ * @param {Shard&} shard 页面所在的分片
+ * @param {frame_id_t} frame_id 页面所在的帧
+ * @param {PageId} page_id 被访问的页面
+ */
+void BufferPoolManager::record_access(Shard &shard, frame_id_t frame_id, PageId page_id) {
+    shard.replacer->record_access(frame_id, page_key(page_id));
+    if (tracing_.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(trace_latch_);
+        if (trace_.is_open()) {
+            trace_ << page_id.fd << ' ' << page_id.page_no << '\n';
+        }
+    }
+}
+
+/**
+ * @description: 开始把缓冲池的页面访问序列(fetch_page和new_page)写入文件，供置换策略的回放工具比较不同策略的命中率
+ * @param {string&} path 访问序列文件的路径
+ */
+void BufferPoolManager::start_access_trace(const std::string &path) {
+    std::lock_guard<std::mutex> lock(trace_latch_);
+    trace_.close();
+    trace_.clear();
+    trace_.open(path, std::ios::out | std::ios::trunc);
+    if (!trace_.is_open()) {
+        throw UnixError();
+    }
+    tracing_ = true;
+}
+
+/**
+ * @description: 停止记录页面访问序列并关闭文件
+ */
+void BufferPoolManager::stop_access_trace() {
+    std::lock_guard<std::mutex> lock(trace_latch_);
+    tracing_ = false;
+    trace_.close();
+}
+
+/**
+ * @description: 后台写线程，每隔BG_WRITER_INTERVAL_MS毫秒或被前台唤醒时依次清理各分片淘汰端的脏页，直到缓冲池析构
+ */
+void BufferPoolManager::background_writer() {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(writer_latch_);
+            if (stop_background_writer_) {
+                return;
+            }
+            writer_cv_.wait_for(lock, std::chrono::milliseconds(BG_WRITER_INTERVAL_MS));
+        }
+        for (size_t i = 0; i < num_shards_ && !stop_background_writer_; i++) {
+            std::unique_lock<std::mutex> lock(shards_[i].latch);
+            clean_victim_frames(shards_[i], lock);
+        }
+    }
+}
+
+/**
+ * @description: 让分片replacer淘汰端的clean_target个帧(连同free_list中的空闲帧)保持干净：
+ *               依次取出即将被淘汰的帧，把其中的脏页连同相邻脏页一起写回，前台淘汰它们时就不用再同步写盘。
+ *               写盘期间不持有latch，每写回一段后让出CPU，避免长时间占用latch
+ * @param {Shard&} shard 目标分片
+ * @param {unique_lock<mutex>&} lock 已持有的分片latch
+ */
+void BufferPoolManager::clean_victim_frames(Shard &shard, std::unique_lock<std::mutex> &lock) {
+    if (shard.free_list.size() >= shard.clean_target) {
+        return;
+    }
+    std::vector<frame_id_t> candidates;
+    shard.replacer->peek_victims(&candidates, std::min(shard.clean_target - shard.free_list.size(),
+                                                       static_cast<size_t>(BG_WRITER_MAX_PAGES)));
+    size_t written = 0;
+    for (frame_id_t frame_id : candidates) {
+        if (stop_background_writer_ || written >= static_cast<size_t>(BG_WRITER_MAX_PAGES)) {
+            return;
+        }
+        // 释放latch期间帧可能已被淘汰、固定或写回，重新检查
+        Page *page = &shard.pages[frame_id];
+        if (page->id_.page_no == INVALID_PAGE_ID || !page->is_dirty_ || page->pin_count_ > 0 ||
+            page->io_in_progress_) {
+            continue;
+        }
+        try {
+            size_t num_pages = write_back_victim(shard, page, lock);
+            written += num_pages;
+            num_background_written_pages_ += num_pages;
+        } catch (UniBaseError &) {
+            // 文件已被关闭等情况下跳过该页，之后由前台淘汰时处理
+        }
+        lock.unlock();
+        std::this_thread::yield();
+        lock.lock();
+    }
+}
+
+/**
+ * @description: 告知缓冲池当前线程接下来将从start_page_no开始顺序访问文件(如全表扫描)，
+ *               不必等待检测到顺序访问，立即开始预读
+ * @param {int} fd 文件句柄
+ * @param {page_id_t} start_page_no 第一个将要访问的页号
+ */
+void BufferPoolManager::hint_sequential(int fd, page_id_t start_page_no) {
+    if (max_readahead_pages_ < READAHEAD_MIN_PAGES) {
+        return;
+    }
+    ReadaheadState &state = thread_readahead_state(fd);
+    state.last_page_no = start_page_no - 1;
+    state.window = READAHEAD_MIN_PAGES;
+    state.trigger_page_no = start_page_no;
+    state.next_page_no = start_page_no + state.window;
+    schedule_readahead(PageId{fd, start_page_no}, state.window);
+}
+
+/**
+ * @description: 在后台把文件中[start_page_id.page_no, start_page_id.page_no + num_pages)的页面读入缓冲池，不等待读入完成
+ * @param {PageId} start_page_id 第一个页面
+ * @param {int} num_pages 页面个数
+ */
+void BufferPoolManager::prefetch_pages(PageId start_page_id, int num_pages) {
+    if (max_readahead_pages_ < READAHEAD_MIN_PAGES) {
+        return;
+    }
+    for (int done = 0; done < num_pages; done += max_readahead_pages_) {
+        schedule_readahead(PageId{start_page_id.fd, start_page_id.page_no + done},
+                           std::min(num_pages - done, max_readahead_pages_));
+    }
+}
+
+/**
+ * @description: 当前线程对文件fd的顺序访问状态
+ * @param {int} fd 文件句柄
+ */
+BufferPoolManager::ReadaheadState &BufferPoolManager::thread_readahead_state(int fd) {
+    static thread_local std::unordered_map<uint64_t, ReadaheadState> states;
+    return states[(instance_id_ << 32) | static_cast<uint32_t>(fd)];
+}
+
+/**
+ * @description: 记录当前线程的一次页面访问，检测文件的顺序访问并发起预读。
+ *               连续两次访问相邻页面时开始预读READAHEAD_MIN_PAGES个页面；
+ *               之后每当访问到上一轮预读的第一页，说明预读的页面正在被使用，窗口翻倍并预读下一段；
+ *               出现非顺序访问时窗口归零
+ * @param {PageId} page_id 被访问的页面
+ */
+void BufferPoolManager::on_page_access(PageId page_id) {
+    if (max_readahead_pages_ < READAHEAD_MIN_PAGES) {
+        return;
+    }
+    ReadaheadState &state = thread_readahead_state(page_id.fd);
+    if (page_id.page_no == state.last_page_no) {
+        return;
+    }
+    bool sequential = state.last_page_no != INVALID_PAGE_ID && page_id.page_no == state.last_page_no + 1;
+    state.last_page_no = page_id.page_no;
+    if (!sequential) {
+        state.window = 0;
+        state.trigger_page_no = INVALID_PAGE_ID;
+        return;
+    }
+    if (state.window == 0) {
+        state.window = READAHEAD_MIN_PAGES;
+        state.next_page_no = page_id.page_no + 1;
+    } else if (page_id.page_no == state.trigger_page_no) {
+        state.window = std::min(state.window * 2, max_readahead_pages_);
+    } else {
+        return;
+    }
+    PageId start_page_id{page_id.fd, std::max(state.next_page_no, page_id.page_no + 1)};
+    schedule_readahead(start_page_id, state.window);
+    state.trigger_page_no = start_page_id.page_no;
+    state.next_page_no = start_page_id.page_no + state.window;
+}
+
+/**
+ * @description: 把一个预读请求交给后台线程，文件末尾之外的页面不预读
+ * @param {PageId} start_page_id 第一个页面
+ * @param {int} num_pages 页面个数
+ */
+void BufferPoolManager::schedule_readahead(PageId start_page_id, int num_pages) {
+    num_pages = std::min(num_pages, disk_manager_->get_fd2pageno(start_page_id.fd) - start_page_id.page_no);
+    if (num_pages <= 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(readahead_latch_);
+    readahead_queue_.push_back({start_page_id, num_pages});
+    if (!readahead_worker_.joinable()) {
+        readahead_worker_ = std::thread(&BufferPoolManager::readahead_worker, this);
+    }
+    readahead_cv_.notify_one();
+}
+
+/**
+ * @description: 页面被重新分配或删除时，取消对它正在进行的预读，读入的旧内容会被丢弃。调用者需持有分片的latch
+ * @param {Shard&} shard 页面所在的分片
+ * @param {PageId} page_id 目标页面
+ */
+void BufferPoolManager::cancel_readahead(Shard &shard, PageId page_id) {
+    auto it = shard.loading.find(page_id);
+    if (it != shard.loading.end()) {
+        it->second = true;
+    }
+}
+
+/**
+ * @description: 后台预读线程，依次处理readahead_queue_中的请求，直到缓冲池析构
+ */
+void BufferPoolManager::readahead_worker() {
+    std::unique_lock<std::mutex> lock(readahead_latch_);
+    while (true) {
+        readahead_cv_.wait(lock, [this] { return stop_readahead_ || !readahead_queue_.empty(); });
+        if (stop_readahead_) {
+            return;
         }
+        ReadaheadRequest request = readahead_queue_.front();
+        readahead_queue_.pop_front();
+        lock.unlock();
+        run_readahead(request);
+        lock.lock();
     }
-}
\ No newline at end of file
+}
+
+/**
+ * @description: 处理一个预读请求：持有页面所在分片的latch为不在缓冲池中的页面申请帧，释放latch后把这些页面
+ *               作为异步读请求一起提交、同时在途，再持有分片的latch把读入的页面作为未固定的页面加入页表。读入期间这些页面登记在
+ *               分片的loading中，fetch_page会等待它们读入完成；帧不在free_list和replacer中，不会被其他线程使用。
+ *               请求只使用空闲帧时，分片中没有空闲帧的页面不读入
+ * @param {ReadaheadRequest&} request 预读请求
+ */
+void BufferPoolManager::run_readahead(const ReadaheadRequest &request) {
+    struct Claimed {
+        page_id_t page_no;
+        Shard *shard;
+        frame_id_t frame_id;
+    };
+    int fd = request.start.fd;
+    std::vector<Claimed> claimed;
+    for (int i = 0; i < request.num_pages; i++) {
+        PageId page_id{fd, request.start.page_no + i};
+        Shard &shard = shard_of(page_id);
+        // 顺序扫描时预读窗口中的大部分页面往往已在缓冲池中，先不加latch查找页表跳过它们
+        if (shard.page_table->contains(page_id)) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(shard.latch);
+        if (shard.page_table->contains(page_id) || shard.loading.count(page_id)) {
+            continue;
+        }
+        frame_id_t frame_id;
+        if (request.free_frames_only ? shard.free_list.empty() : !find_victim_page(shard, &frame_id)) {
+            continue;
+        }
+        if (request.free_frames_only) {
+            frame_id = shard.free_list.front();
+            shard.free_list.pop_front();
+        }
+        Page *page = &shard.pages[frame_id];
+        evict_frame(shard, page, lock);
+        // 写回淘汰页期间释放了latch，其他线程可能已经开始读入该页面
+        if (shard.page_table->contains(page_id) || shard.loading.count(page_id)) {
+            release_frame(shard, frame_id);
+            continue;
+        }
+        page->is_dirty_ = false;
+        page->pin_count_ = 0;
+        shard.loading[page_id] = false;
+        claimed.push_back({page_id.page_no, &shard, frame_id});
+    }
+    if (claimed.empty()) {
+        return;
+    }
+
+    // 页面已分配但还没有写入磁盘、或文件已被关闭时放弃该页面，之后由fetch_page按需读取
+    std::vector<std::pair<page_id_t, char *>> pages;
+    for (auto &c : claimed) {
+        pages.emplace_back(c.page_no, c.shard->pages[c.frame_id].data_);
+    }
+    std::vector<bool> loaded = read_pages_async(fd, pages);
+
+    for (size_t i = 0; i < claimed.size(); i++) {
+        PageId page_id{fd, claimed[i].page_no};
+        Shard &shard = *claimed[i].shard;
+        frame_id_t frame_id = claimed[i].frame_id;
+        std::lock_guard<std::mutex> lock(shard.latch);
+        bool cancelled = shard.loading[page_id];
+        shard.loading.erase(page_id);
+        if (!loaded[i] || cancelled) {
+            release_frame(shard, frame_id);
+        } else {
+            shard.pages[frame_id].id_ = page_id;
+            map_page(shard, page_id, frame_id);
+            shard.replacer->record_access(frame_id, page_key(page_id));
+            shard.replacer->unpin(frame_id);
+            num_prefetched_pages_++;
+        }
+        shard.io_cv.notify_all();
+    }
+}
+
+/**
+ * @description: 把缓冲池中的页面及其热度转储到文件，重启后由warm_up()按热度重新读入。每行为"文件名 页号 热度"，
+ *               按热度从高到低排列。热度是页面在所在分片淘汰顺序中的相对位置，范围为(0, 1]，越大越晚被淘汰，
+ *               被固定的页面为1。先写入临时文件再改名，转储到一半时崩溃不会破坏上一次的转储文件
+ * @return {size_t} 转储的页面个数
+ * @param {string&} path 转储文件的路径
+ */
+size_t BufferPoolManager::dump_resident_pages(const std::string &path) {
+    struct ResidentPage {
+        PageId page_id;
+        double heat;
+    };
+    std::vector<ResidentPage> resident_pages;
+    for (size_t i = 0; i < num_shards_; i++) {
+        Shard &shard = shards_[i];
+        std::lock_guard<std::mutex> lock(shard.latch);
+        size_t num_resident = 0;
+        for (auto &entry : shard.files) {
+            num_resident += entry.second.resident.size();
+        }
+        // 未被固定的页面按淘汰顺序排列，越靠后越热
+        std::vector<frame_id_t> victims;
+        shard.replacer->peek_victims(&victims, shard.replacer->Size());
+        for (size_t rank = 0; rank < victims.size(); rank++) {
+            Page *page = &shard.pages[victims[rank]];
+            if (page->id_.page_no != INVALID_PAGE_ID) {
+                resident_pages.push_back({page->id_, static_cast<double>(rank + 1) / num_resident});
+            }
+        }
+        for (auto &entry : shard.files) {
+            for (frame_id_t frame_id : entry.second.resident) {
+                if (shard.pages[frame_id].pin_count_ > 0) {
+                    resident_pages.push_back({shard.pages[frame_id].id_, 1.0});
+                }
+            }
+        }
+    }
+    std::stable_sort(resident_pages.begin(), resident_pages.end(),
+                     [](const ResidentPage &a, const ResidentPage &b) { return a.heat > b.heat; });
+
+    std::string tmp_path = path + ".tmp";
+    std::ofstream ofs(tmp_path, std::ios::out | std::ios::trunc);
+    if (!ofs.is_open()) {
+        throw UnixError();
+    }
+    std::unordered_map<int, std::string> file_names;
+    size_t num_dumped = 0;
+    for (auto &resident_page : resident_pages) {
+        auto it = file_names.find(resident_page.page_id.fd);
+        if (it == file_names.end()) {
+            std::string file_name;
+            try {
+                file_name = disk_manager_->get_file_name(resident_page.page_id.fd);
+            } catch (UniBaseError &) {
+                // 转储期间文件已被关闭，跳过它的页面
+            }
+            it = file_names.emplace(resident_page.page_id.fd, file_name).first;
+        }
+        if (it->second.empty()) {
+            continue;
+        }
+        ofs << it->second << ' ' << resident_page.page_id.page_no << ' ' << resident_page.heat << '\n';
+        num_dumped++;
+    }
+    ofs.close();
+    if (ofs.fail() || rename(tmp_path.c_str(), path.c_str()) < 0) {
+        throw UnixError();
+    }
+    return num_dumped;
+}
+
+/**
+ * @description: 按dump_resident_pages()的转储文件在后台预热缓冲池，立即返回，客户端可以同时访问数据库。
+ *               转储文件中的文件需已经打开，其他文件的页面被忽略；最多读入缓冲池大小个最热的页面。
+ *               页面按热度每WARM_UP_BATCH_PAGES个分为一批，由WARM_UP_THREADS个线程按热度从高到低依次读入，
+ *               每批内按(fd, page_no)排序，连续的页面合并为一次向量化读。预热只使用空闲帧，
+ *               不会淘汰客户端已经读入的页面，缓冲池被占满后剩下的页面不再读入
+ * @return {size_t} 需要预热的页面个数，没有转储文件时为0
+ * @param {string&} path 转储文件的路径
+ */
+size_t BufferPoolManager::warm_up(const std::string &path) {
+    stop_warm_up();
+    // 共享内存中保留着上一个进程的页面，由reattach_shared_frames()接管，不需要按转储文件预热
+    {
+        std::lock_guard<std::mutex> shared_lock(shared_latch_);
+        if (!shared_candidates_.empty()) {
+            return 0;
+        }
+    }
+    std::ifstream ifs(path);
+    if (!ifs.is_open()) {
+        return 0;
+    }
+    std::vector<std::pair<double, PageId>> pages;
+    std::unordered_map<std::string, int> fds;
+    std::string file_name;
+    page_id_t page_no;
+    double heat;
+    while (ifs >> file_name >> page_no >> heat) {
+        auto it = fds.find(file_name);
+        if (it == fds.end()) {
+            it = fds.emplace(file_name, disk_manager_->find_open_file(file_name)).first;
+        }
+        int fd = it->second;
+        if (fd < 0 || page_no < 0 || page_no >= disk_manager_->get_fd2pageno(fd)) {
+            continue;
+        }
+        pages.emplace_back(heat, PageId{fd, page_no});
+    }
+    std::stable_sort(pages.begin(), pages.end(),
+                     [](const std::pair<double, PageId> &a, const std::pair<double, PageId> &b) {
+                         return a.first > b.first;
+                     });
+    pages.resize(std::min(pages.size(), pool_size_.load()));
+    if (pages.empty()) {
+        return 0;
+    }
+
+    warm_up_batches_.clear();
+    for (size_t begin = 0; begin < pages.size(); begin += WARM_UP_BATCH_PAGES) {
+        size_t end = std::min(pages.size(), begin + WARM_UP_BATCH_PAGES);
+        std::vector<PageId> batch;
+        for (size_t i = begin; i < end; i++) {
+            batch.push_back(pages[i].second);
+        }
+        std::sort(batch.begin(), batch.end());
+        warm_up_batches_.push_back(std::move(batch));
+    }
+    next_warm_up_batch_ = 0;
+    for (int i = 0; i < WARM_UP_THREADS; i++) {
+        warm_up_workers_.emplace_back(&BufferPoolManager::warm_up_worker, this);
+    }
+    return pages.size();
+}
+
+/**
+ * @description: 等待预热完成
+ */
+void BufferPoolManager::wait_for_warm_up() {
+    for (auto &worker : warm_up_workers_) {
+        worker.join();
+    }
+    warm_up_workers_.clear();
+}
+
+/**
+ * @description: 停止正在进行的预热，正在读入的一段页面读完后返回，用于关闭数据库和析构缓冲池
+ */
+void BufferPoolManager::stop_warm_up() {
+    stop_warm_up_ = true;
+    wait_for_warm_up();
+    stop_warm_up_ = false;
+}
+
+/**
+ * @description: 预热线程，按热度从高到低依次领取一批页面，把批内页号连续的页面作为一个只使用空闲帧的预读请求读入
+ */
+void BufferPoolManager::warm_up_worker() {
+    while (!stop_warm_up_) {
+        size_t batch_index = next_warm_up_batch_++;
+        if (batch_index >= warm_up_batches_.size()) {
+            return;
+        }
+        const std::vector<PageId> &batch = warm_up_batches_[batch_index];
+        for (size_t begin = 0; begin < batch.size() && !stop_warm_up_;) {
+            size_t end = begin + 1;
+            while (end < batch.size() && end - begin < static_cast<size_t>(IO_BATCH_MAX_PAGES) &&
+                   batch[end].fd == batch[begin].fd && batch[end].page_no == batch[end - 1].page_no + 1) {
+                end++;
+            }
+            ReadaheadRequest request{batch[begin], static_cast<int>(end - begin)};
+            request.free_frames_only = true;
+            run_readahead(request);
+            begin = end;
+        }
+    }
+}
+
+/**
+ * @description: 启动定期转储线程，每隔BUFFER_POOL_DUMP_INTERVAL_S秒把缓冲池中的页面转储到path，
+ *               进程意外退出时重启后也能用最近一次的转储预热。间隔为0时不启动
+ * @param {string&} path 转储文件的路径
+ */
+void BufferPoolManager::start_periodic_dump(const std::string &path) {
+    stop_periodic_dump();
+    if (BUFFER_POOL_DUMP_INTERVAL_S <= 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(dump_latch_);
+    stop_dump_ = false;
+    dump_worker_ = std::thread([this, path]() {
+        std::unique_lock<std::mutex> lock(dump_latch_);
+        auto interval = std::chrono::seconds(BUFFER_POOL_DUMP_INTERVAL_S);
+        while (!dump_cv_.wait_for(lock, interval, [this] { return stop_dump_; })) {
+            lock.unlock();
+            try {
+                dump_resident_pages(path);
+            } catch (UniBaseError &) {
+                // 转储失败只影响重启后的预热，下一轮再试
+            }
+            lock.lock();
+        }
+    });
+}
+
+/**
+ * @description: 停止定期转储线程
+ */
+void BufferPoolManager::stop_periodic_dump() {
+    {
+        std::lock_guard<std::mutex> lock(dump_latch_);
+        stop_dump_ = true;
+    }
+    dump_cv_.notify_all();
+    if (dump_worker_.joinable()) {
+        dump_worker_.join();
+    }
+}
+
+/**
+ * @description: 构造时检查共享内存段中上一个进程留下的帧：干净、未被固定且登记了文件的帧等待接管，
+ *               其余帧的描述清空。帧不在共享内存中时返回空数组
+ * @return {vector<bool>} 每个帧(pages_中的下标)是否等待接管
+ */
+std::vector<bool> BufferPoolManager::collect_shared_frames() {
+    std::vector<bool> candidates;
+    if (shared_segment_ == nullptr) {
+        return candidates;
+    }
+    candidates.resize(max_pool_size_, false);
+    for (size_t frame = 0; frame < max_pool_size_; frame++) {
+        SharedFrameSegment::FrameDesc &desc = shared_segment_->desc(frame);
+        if (shared_segment_->is_reattached() && desc.flags == SharedFrameSegment::FRAME_VALID && desc.file >= 0 &&
+            desc.page_no >= 0) {
+            candidates[frame] = true;
+            shared_candidates_.push_back(frame);
+        } else {
+            desc.flags = 0;
+        }
+    }
+    return candidates;
+}
+
+/**
+ * @description: 把帧的脏标记和固定状态同步到共享内存中的帧描述。页面被修改前一定已被固定，
+ *               进程在任何时刻退出，描述为干净且未被固定的帧中都是与磁盘一致的完整页面。调用者需持有分片的latch
+ * @param {Page*} page 目标帧
+ */
+void BufferPoolManager::sync_shared_frame(const Page* page) {
+    if (shared_segment_ == nullptr) {
+        return;
+    }
+    SharedFrameSegment::FrameDesc &desc = shared_segment_->desc(static_cast<size_t>(page - pages_));
+    if (desc.flags & SharedFrameSegment::FRAME_VALID) {
+        desc.flags = SharedFrameSegment::FRAME_VALID | (page->is_dirty_ ? SharedFrameSegment::FRAME_DIRTY : 0) |
+                     (page->pin_count_ > 0 ? SharedFrameSegment::FRAME_PINNED : 0);
+    }
+}
+
+/**
+ * @description: 清空共享内存中的帧描述，帧中的内容不再能被接管。调用者需持有分片的latch
+ * @param {Page*} page 目标帧
+ */
+void BufferPoolManager::clear_shared_frame(const Page* page) {
+    if (shared_segment_ != nullptr) {
+        shared_segment_->desc(static_cast<size_t>(page - pages_)).flags = 0;
+    }
+}
+
+/**
+ * @description: 放弃接管一个共享内存中的帧，帧放回所在分片的free_list。调用者不能持有分片的latch
+ * @param {size_t} frame 帧在pages_中的下标
+ */
+void BufferPoolManager::drop_shared_frame(size_t frame) {
+    for (size_t i = 0; i < num_shards_; i++) {
+        Shard &shard = shards_[i];
+        size_t begin = static_cast<size_t>(shard.pages - pages_);
+        if (frame < begin || frame >= begin + shard.size) {
+            continue;
+        }
+        std::lock_guard<std::mutex> lock(shard.latch);
+        clear_shared_frame(&pages_[frame]);
+        release_frame(shard, static_cast<frame_id_t>(frame - begin));
+        return;
+    }
+}
+
+/**
+ * @description: 接管上一个进程留在共享内存段中的页面，需在打开数据库的文件、完成恢复之后调用。
+ *               只接管退出时干净且未被固定的页面，文件需已经打开，页号在文件范围内，page_lsn不超过max_lsn
+ *               (更大的lsn说明页面含有日志没有持久化的修改)，且页面还不在缓冲池中(恢复时重新读入或修改过的以缓冲池中的为准)。
+ *               文件句柄在重启后可能变化，页面所在的分片随之变化：帧仍在页面所在分片中时原地登记到页表，
+ *               否则复制到该分片的空闲帧中，没有空闲帧时放弃。其余帧放回free_list
+ * @return {size_t} 接管的页面个数
+ * @param {lsn_t} max_lsn 允许接管的页面的最大page_lsn
+ */
+size_t BufferPoolManager::reattach_shared_frames(lsn_t max_lsn) {
+    struct Candidate {
+        size_t frame;
+        PageId page_id;
+        Shard *shard;
+    };
+    std::lock_guard<std::mutex> shared_lock(shared_latch_);
+    // 文件表中登记的是绝对路径，数据库的文件按相对于数据库目录的路径打开
+    std::string cwd_prefix;
+    char cwd[PATH_MAX];
+    if (getcwd(cwd, sizeof(cwd)) != nullptr) {
+        cwd_prefix = std::string(cwd) + "/";
+    }
+    std::unordered_map<int, int> fds;  // 文件表下标 -> 文件句柄
+    std::vector<Candidate> in_place;
+    std::vector<Candidate> moved;
+    std::vector<size_t> dropped;
+    for (size_t frame : shared_candidates_) {
+        const SharedFrameSegment::FrameDesc &desc = shared_segment_->desc(frame);
+        auto it = fds.find(desc.file);
+        if (it == fds.end()) {
+            std::string path = shared_segment_->file_path(desc.file);
+            int fd = disk_manager_->find_open_file(path);
+            if (fd < 0 && !cwd_prefix.empty() && path.compare(0, cwd_prefix.size(), cwd_prefix) == 0) {
+                fd = disk_manager_->find_open_file(path.substr(cwd_prefix.size()));
+            }
+            it = fds.emplace(desc.file, fd).first;
+        }
+        PageId page_id{it->second, desc.page_no};
+        if (page_id.fd < 0 || page_id.page_no >= disk_manager_->get_fd2pageno(page_id.fd) ||
+            (page_id.page_no >= first_lsn_page(page_id.fd) && pages_[frame].get_page_lsn() > max_lsn)) {
+            dropped.push_back(frame);
+            continue;
+        }
+        Shard &shard = shard_of(page_id);
+        size_t begin = static_cast<size_t>(shard.pages - pages_);
+        if (frame >= begin && frame < begin + shard.num_active) {
+            in_place.push_back({frame, page_id, &shard});
+        } else {
+            moved.push_back({frame, page_id, &shard});
+        }
+    }
+    shared_candidates_.clear();
+
+    size_t num_reattached = 0;
+    for (const Candidate &candidate : in_place) {
+        Shard &shard = *candidate.shard;
+        std::lock_guard<std::mutex> lock(shard.latch);
+        frame_id_t frame_id = static_cast<frame_id_t>(candidate.frame - static_cast<size_t>(shard.pages - pages_));
+        if (shard.page_table->contains(candidate.page_id) || shard.loading.count(candidate.page_id)) {
+            clear_shared_frame(&shard.pages[frame_id]);
+            release_frame(shard, frame_id);
+            continue;
+        }
+        Page *page = &shard.pages[frame_id];
+        page->id_ = candidate.page_id;
+        page->is_dirty_ = false;
+        page->pin_count_ = 0;
+        map_page(shard, candidate.page_id, frame_id);
+        shard.replacer->record_access(frame_id, page_key(candidate.page_id));
+        shard.replacer->unpin(frame_id);
+        num_reattached++;
+    }
+    // 被放弃的帧先回到free_list，再把需要移动的页面复制到页面所在分片的空闲帧中
+    for (size_t frame : dropped) {
+        drop_shared_frame(frame);
+    }
+    for (const Candidate &candidate : moved) {
+        {
+            Shard &shard = *candidate.shard;
+            std::lock_guard<std::mutex> lock(shard.latch);
+            if (!shard.page_table->contains(candidate.page_id) && !shard.loading.count(candidate.page_id) &&
+                !shard.free_list.empty()) {
+                frame_id_t frame_id = shard.free_list.front();
+                shard.free_list.pop_front();
+                Page *page = &shard.pages[frame_id];
+                clear_shared_frame(page);
+                memcpy(page->data_, pages_[candidate.frame].data_, PAGE_SIZE);
+                page->id_ = candidate.page_id;
+                page->is_dirty_ = false;
+                page->pin_count_ = 0;
+                map_page(shard, candidate.page_id, frame_id);
+                shard.replacer->record_access(frame_id, page_key(candidate.page_id));
+                shard.replacer->unpin(frame_id);
+                num_reattached++;
+            }
+        }
+        drop_shared_frame(candidate.frame);
+    }
+    return num_reattached;
+}
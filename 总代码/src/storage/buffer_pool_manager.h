@@ -2,72 +2,466 @@
 #include <fcntl.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <functional>
 #include <list>
+#include <memory>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+#include "buffer_access_strategy.h"
 #include "disk_manager.h"
 #include "errors.h"
+#include "frame_arena.h"
 #include "page.h"
+#include "page_guard.h"
+#include "page_table.h"
+#include "shared_frame_segment.h"
+#include "swip_table.h"
+#include "replacer/arc_replacer.h"
+#include "replacer/clock_replacer.h"
+#include "replacer/lru_k_replacer.h"
 #include "replacer/lru_replacer.h"
 #include "replacer/replacer.h"
 
 class BufferPoolManager {
    private:
-    size_t pool_size_;      // buffer_pool中可容纳页面的个数，即帧的个数
-    Page *pages_;           // buffer_pool中的Page对象数组，在构造空间中申请内存空间，在析构函数中释放，大小为BUFFER_POOL_SIZE
-    std::unordered_map<PageId, frame_id_t, PageIdHash> page_table_; // 帧号和页面号的映射哈希表，用于根据页面的PageId定位该页面的帧编号
-    std::list<frame_id_t> free_list_;   // 空闲帧编号的链表
+    /**
+     * @description: 一个线程对一个文件的顺序访问状态，用于检测顺序扫描并自适应地调整预读窗口。
+     *               每个线程单独记录，检测顺序访问不需要任何全局的latch，并发的扫描之间也不会互相打断
+     */
+    struct ReadaheadState {
+        page_id_t last_page_no = INVALID_PAGE_ID;     // 上一次访问的页号
+        page_id_t next_page_no = INVALID_PAGE_ID;     // 下一轮预读的起始页号，之前的页面已经预读过
+        page_id_t trigger_page_no = INVALID_PAGE_ID;  // 访问到该页(上一轮预读的第一页)时发起下一轮预读
+        int window = 0;                               // 当前预读窗口的页面个数，为0表示还没有检测到顺序访问
+    };
+
+    /**
+     * @description: 交给后台预读线程的一个请求，预读文件中[start.page_no, start.page_no + num_pages)的页面
+     */
+    struct ReadaheadRequest {
+        PageId start;
+        int num_pages;
+        bool free_frames_only = false;  // 只使用空闲帧，不淘汰缓冲池中已有的页面(重启后预热时使用)
+    };
+
+    /**
+     * @description: 一个文件在一个分片中的帧，用于只处理该文件页面的刷盘、关闭和删除
+     */
+    struct FileFrames {
+        std::unordered_set<frame_id_t> resident;  // 存放该文件页面的帧
+        std::unordered_set<frame_id_t> dirty;     // 其中的脏页
+        int shared_file = -1;                     // 文件在共享内存段文件表中的下标，缓冲池不在共享内存中时不使用
+    };
+
+    /**
+     * @description: 缓冲池的一个分片。文件中的页面按PageId哈希到固定的分片，
+     *               每个分片有自己的帧、页表、空闲链表、replacer和latch，不同分片上的操作互不阻塞
+     */
+    struct Shard {
+        Page *pages = nullptr;  // 本分片的帧，是BufferPoolManager::pages_中连续的一段，frame_id是在这一段中的下标
+        size_t size = 0;        // 本分片预留的帧个数，即缓冲池扩大到上限时的帧个数
+        size_t num_active = 0;  // 本分片当前使用的帧个数，只有[0, num_active)中的帧存放页面，由resize()调整
+        std::unique_ptr<PageTable> page_table;                          // 本分片中页面的PageId到帧编号的映射，查找不需要latch
+        std::list<frame_id_t> free_list;                                // 本分片的空闲帧编号
+        Replacer *replacer = nullptr;                                   // 本分片的置换策略
+        std::mutex latch;                                               // 保护本分片的以上数据结构和帧的元数据
+        std::unordered_map<PageId, bool, PageIdHash> loading;  // 正在读入本分片的页面，值为该次读入是否已被取消(页面被删除或重新分配)
+        size_t num_writing = 0;                                // 本分片中正在写回磁盘的帧个数(io_in_progress_)
+        std::condition_variable io_cv;                         // 通知等待中的线程有页面读入或写回完成
+        size_t clean_target = 0;                               // 后台写线程使本分片淘汰端保持干净的帧个数
+        bool shrinking = false;                                // resize()正在等待腾空本分片被移除的帧，页面被取消固定时通知io_cv
+        std::unordered_map<int, FileFrames> files;             // 文件句柄 -> 该文件在本分片中的帧，与page_table和脏标记同步维护
+    };
+
+    std::atomic<size_t> pool_size_;  // buffer_pool中可容纳页面的个数，即当前使用的帧个数
+    size_t max_pool_size_;  // 预留的帧个数，缓冲池可以在线扩大到的上限
+    std::mutex resize_latch_;  // 保证同一时刻只有一个resize()
+    Page *pages_;           // buffer_pool中的Page对象数组，只保存帧的元数据(PageId、脏标记、pin_count)，紧凑存放以便淘汰和刷盘时顺序扫描
+    std::unique_ptr<SharedFrameSegment> shared_segment_;  // 存放帧的共享内存段，为nullptr时帧在进程的私有内存中
+    std::mutex shared_latch_;                             // 保护shared_candidates_
+    std::vector<size_t> shared_candidates_;               // 上一个进程留在共享内存段中、等待接管的帧(pages_中的下标)，接管前不放入free_list
+    std::atomic<bool> retain_shared_frames_{false};       // 关闭文件时是否在共享内存段中保留干净页面的帧描述
+    std::unique_ptr<FrameArena> arena_;  // 所有帧的数据区，尽量使用大页以减少随机访问帧时的TLB缺失
+    char *frame_data_;      // 数据区的起始地址，按DIRECT_IO_ALIGNMENT对齐，第i帧位于frame_data_ + i * PAGE_SIZE
+    size_t num_shards_;     // 分片个数
+    Shard *shards_;         // 所有分片，第i个分片的帧位于pages_中[i * max_pool_size_ / num_shards_, (i + 1) * max_pool_size_ / num_shards_)
     DiskManager *disk_manager_;
-    Replacer *replacer_;    // buffer_pool的置换策略，当前赛题中为LRU置换策略
-    std::mutex latch_;      // 用于共享数据结构的并发控制
+
+    uint64_t instance_id_;                                           // 缓冲池实例的编号，用于区分各线程在不同实例上的顺序访问状态
+    int max_readahead_pages_;                                        // 预读窗口的上限，小于READAHEAD_MIN_PAGES时不预读
+    std::mutex readahead_latch_;                                     // 保护预读队列和后台预读线程
+    std::deque<ReadaheadRequest> readahead_queue_;                   // 等待后台线程处理的预读请求
+    std::condition_variable readahead_cv_;                           // 通知后台线程有新的预读请求或需要退出
+    std::thread readahead_worker_;                                   // 后台预读线程，第一次预读时启动
+    bool stop_readahead_ = false;                                    // 后台预读线程是否需要退出
+    std::atomic<size_t> num_prefetched_pages_{0};                    // 累计预读进缓冲池的页面个数
+
+    std::mutex writer_latch_;                                        // 后台写线程等待时使用的latch
+    std::condition_variable writer_cv_;                              // 唤醒后台写线程，前台遇到脏的淘汰页或缓冲池析构时通知
+    std::thread background_writer_;                                  // 后台写线程，提前写回即将被淘汰的脏页
+    std::atomic<bool> stop_background_writer_{false};                // 后台写线程是否需要退出
+    std::atomic<size_t> num_background_written_pages_{0};            // 累计由后台写线程写回的页面个数
+    std::shared_ptr<const std::function<void(lsn_t)>> flush_log_;    // 写回页面前保证日志已持久化到该页面的page_lsn(WAL)，为空时不检查；
+                                                                     // 写回时不持有分片的latch，用std::atomic_load/atomic_store读写
+    std::mutex lsn_files_latch_;                                     // 保护lsn_files_
+    std::unordered_map<int, page_id_t> lsn_files_;                   // 页面中保存page_lsn的文件 -> 第一个保存page_lsn的页号
+
+    std::vector<std::vector<PageId>> warm_up_batches_;               // 预热时按热度从高到低划分的批次，每批内按(fd, page_no)排序
+    std::atomic<size_t> next_warm_up_batch_{0};                      // 下一个要读入的批次
+    std::vector<std::thread> warm_up_workers_;                       // 预热线程
+    std::atomic<bool> stop_warm_up_{false};                          // 预热线程是否需要提前退出
+
+    std::mutex dump_latch_;                                          // 保护定期转储线程的启动和退出
+    std::condition_variable dump_cv_;                                // 通知定期转储线程退出
+    std::thread dump_worker_;                                        // 定期把常驻页面转储到文件的线程
+    bool stop_dump_ = false;                                         // 定期转储线程是否需要退出
+
+    std::atomic<bool> tracing_{false};                               // 是否在记录页面访问序列
+    std::mutex trace_latch_;                                         // 保护trace_
+    std::ofstream trace_;                                            // 页面访问序列的输出文件，每行为"fd page_no"
 
    public:
-    BufferPoolManager(size_t pool_size, DiskManager *disk_manager)
-        : pool_size_(pool_size), disk_manager_(disk_manager) {
-        // 为buffer pool分配一块连续的内存空间
-        pages_ = new Page[pool_size_];
-        // 可以被Replacer改变
-        if (REPLACER_TYPE.compare("LRU"))
-            replacer_ = new LRUReplacer(pool_size_);
-        else if (REPLACER_TYPE.compare("CLOCK"))
-            replacer_ = new LRUReplacer(pool_size_);
-        else {
-            replacer_ = new LRUReplacer(pool_size_);
+    /**
+     * @param {size_t} pool_size 缓冲池的帧个数
+     * @param {DiskManager*} disk_manager
+     * @param {size_t} num_shards 分片个数，为0时根据缓冲池大小选择，保证每个分片至少有BUFFER_POOL_SHARD_MIN_FRAMES个帧
+     * @param {string&} replacer_type 置换策略：LRU、CLOCK、LRU-K或ARC
+     * @param {size_t} max_pool_size 预留的帧个数，resize()最多扩大到这么多帧，为0时等于pool_size。
+     *                 预留的帧只占用元数据和地址空间，数据区的内存在帧被使用时才分配
+     * @param {string&} shared_segment 不为空时帧放在这个名称的POSIX共享内存段中，进程退出后保留，
+     *                 重启后由reattach_shared_frames()接管上一个进程留下的干净页面
+     */
+    BufferPoolManager(size_t pool_size, DiskManager *disk_manager, size_t num_shards = 0,
+                      const std::string &replacer_type = REPLACER_TYPE, size_t max_pool_size = 0,
+                      const std::string &shared_segment = "")
+        : pool_size_(pool_size), max_pool_size_(std::max(pool_size, max_pool_size)), disk_manager_(disk_manager) {
+        if (replacer_type != "LRU" && replacer_type != "CLOCK" && replacer_type != "LRU-K" && replacer_type != "ARC") {
+            throw InternalError("BufferPoolManager: unknown replacer type " + replacer_type);
+        }
+        if (num_shards == 0) {
+            num_shards = std::min<size_t>(BUFFER_POOL_SHARDS, pool_size_ / BUFFER_POOL_SHARD_MIN_FRAMES);
+        }
+        num_shards_ = std::max<size_t>(1, std::min<size_t>(num_shards, pool_size_));
+        static std::atomic<uint64_t> next_instance_id{0};
+        instance_id_ = next_instance_id++;
+        max_readahead_pages_ = std::min(READAHEAD_MAX_PAGES, static_cast<int>(pool_size_ / num_shards_ / 8));
+        // 为buffer pool分配一块连续的、满足O_DIRECT对齐要求的数据区，元数据单独存放在pages_数组中。
+        // 按预留的帧个数分配，mmap得到的内存在第一次访问时才分配，未使用的帧不占用物理内存
+        if (!shared_segment.empty()) {
+            shared_segment_ = std::make_unique<SharedFrameSegment>(shared_segment, max_pool_size_);
+            arena_ = shared_segment_->map_frames();
+        } else {
+            arena_ = std::make_unique<FrameArena>(max_pool_size_ * PAGE_SIZE);
+        }
+        frame_data_ = arena_->data();
+        pages_ = new Page[max_pool_size_];
+        for (size_t i = 0; i < max_pool_size_; ++i) {
+            pages_[i].data_ = frame_data_ + i * PAGE_SIZE;
         }
-        // 初始化时，所有的page都在free_list_中
-        for (size_t i = 0; i < pool_size_; ++i) {
-            free_list_.emplace_back(static_cast<frame_id_t>(i));  // static_cast转换数据类型
+        std::vector<bool> shared_candidates = collect_shared_frames();
+        shards_ = new Shard[num_shards_];
+        size_t num_active_frames = 0;
+        for (size_t i = 0; i < num_shards_; ++i) {
+            Shard &shard = shards_[i];
+            size_t begin = i * max_pool_size_ / num_shards_;
+            shard.pages = pages_ + begin;
+            shard.size = (i + 1) * max_pool_size_ / num_shards_ - begin;
+            shard.num_active = shard_active_frames(i, pool_size_);
+            num_active_frames += shard.num_active;
+            shard.clean_target = std::max<size_t>(1, shard.num_active * BG_WRITER_CLEAN_PERCENT / 100);
+            shard.page_table = std::make_unique<PageTable>(shard.size);
+            // 可以被Replacer改变
+            if (replacer_type == "CLOCK")
+                shard.replacer = new ClockReplacer(shard.size);
+            else if (replacer_type == "LRU-K")
+                shard.replacer = new LRUKReplacer(shard.size);
+            else if (replacer_type == "ARC")
+                shard.replacer = new ARCReplacer(shard.size);
+            else {
+                shard.replacer = new LRUReplacer(shard.size);
+            }
+            // 初始化时，除了等待接管的共享内存中的帧，所有使用的page都在free_list中
+            for (size_t j = 0; j < shard.num_active; ++j) {
+                if (!shared_candidates.empty() && shared_candidates[begin + j]) {
+                    continue;
+                }
+                shard.pages[j].reset_memory();
+                shard.free_list.emplace_back(static_cast<frame_id_t>(j));  // static_cast转换数据类型
+            }
+        }
+        pool_size_ = num_active_frames;
+        if (ENABLE_BG_WRITER) {
+            background_writer_ = std::thread(&BufferPoolManager::background_writer, this);
         }
     }
 
     ~BufferPoolManager() {
+        stop_periodic_dump();
+        stop_warm_up();
+        {
+            std::lock_guard<std::mutex> lock(readahead_latch_);
+            stop_readahead_ = true;
+        }
+        {
+            std::lock_guard<std::mutex> lock(writer_latch_);
+            stop_background_writer_ = true;
+        }
+        readahead_cv_.notify_all();
+        writer_cv_.notify_all();
+        if (readahead_worker_.joinable()) {
+            readahead_worker_.join();
+        }
+        if (background_writer_.joinable()) {
+            background_writer_.join();
+        }
+        for (size_t i = 0; i < num_shards_; ++i) {
+            delete shards_[i].replacer;
+        }
+        delete[] shards_;
         delete[] pages_;
-        delete replacer_;
     }
 
-    /**
-     * @description: 将目标页面标记为脏页
-     * @param {Page*} page 脏页
-     */
-    static void mark_dirty(Page* page) { page->is_dirty_ = true; }
-
    public: 
-    Page* fetch_page(PageId page_id);
+    void mark_dirty(Page* page);
+
+    Page* fetch_page(PageId page_id, BufferAccessStrategy* strategy = nullptr);
 
     bool unpin_page(PageId page_id, bool is_dirty);
 
     bool flush_page(PageId page_id);
 
-    Page* new_page(PageId* page_id);
+    Page* new_page(PageId* page_id, BufferAccessStrategy* strategy = nullptr);
 
     bool delete_page(PageId page_id);
 
     void flush_all_pages(int fd);
 
+    void drop_all_pages(int fd);
+
+    void resize(size_t new_pool_size);
+
+    ReadPageGuard fetch_page_read(PageId page_id, BufferAccessStrategy* strategy = nullptr);
+
+    WritePageGuard fetch_page_write(PageId page_id, BufferAccessStrategy* strategy = nullptr);
+
+    WritePageGuard new_page_guarded(PageId* page_id, BufferAccessStrategy* strategy = nullptr);
+
+    OptimisticPageGuard fetch_page_optimistic(PageId page_id, BufferAccessStrategy* strategy = nullptr);
+
+    OptimisticPageGuard fetch_page_swizzled(PageId page_id, const SwipTable* swips);
+
+    void unswizzle_file(int fd);
+
+    void hint_sequential(int fd, page_id_t start_page_no);
+
+    void prefetch_pages(PageId start_page_id, int num_pages);
+
+    /**
+     * @description: 设置写回页面前刷日志的方法，用于保证WAL：页面写回磁盘前，修改它的日志必须先持久化。
+     *               写回不持有分片的latch，方法以原子方式替换，后台线程运行期间也可以设置
+     * @param {function<void(lsn_t)>} flush_log 保证日志至少持久化到给定lsn的方法
+     */
+    void set_log_flusher(std::function<void(lsn_t)> flush_log) {
+        std::shared_ptr<const std::function<void(lsn_t)>> flusher;
+        if (flush_log) {
+            flusher = std::make_shared<const std::function<void(lsn_t)>>(std::move(flush_log));
+        }
+        std::atomic_store(&flush_log_, std::move(flusher));
+    }
+
+    /**
+     * @description: 登记文件中从first_page_no开始的页面在Page::OFFSET_LSN处保存page_lsn，写回这些页面前才按WAL刷日志。
+     *               没有登记的文件(如索引文件)以及文件头页面的这个位置存放的是其他数据，不作为page_lsn
+     * @param {int} fd 文件句柄
+     * @param {page_id_t} first_page_no 第一个保存page_lsn的页号
+     */
+    void register_lsn_file(int fd, page_id_t first_page_no) {
+        std::lock_guard<std::mutex> lock(lsn_files_latch_);
+        lsn_files_[fd] = first_page_no;
+    }
+
+    /**
+     * @description: 关闭文件时取消登记，文件句柄之后可能被其他文件重新使用
+     * @param {int} fd 文件句柄
+     */
+    void unregister_lsn_file(int fd) {
+        std::lock_guard<std::mutex> lock(lsn_files_latch_);
+        lsn_files_.erase(fd);
+    }
+
+    /**
+     * @description: 获得累计由后台写线程写回的页面个数
+     */
+    size_t get_num_background_written_pages() {
+        return num_background_written_pages_.load();
+    }
+
+    /**
+     * @description: 获得累计由预读读入缓冲池的页面个数
+     */
+    size_t get_num_prefetched_pages() {
+        return num_prefetched_pages_.load();
+    }
+
+    size_t dump_resident_pages(const std::string &path);
+
+    size_t warm_up(const std::string &path);
+
+    void wait_for_warm_up();
+
+    void stop_warm_up();
+
+    void start_periodic_dump(const std::string &path);
+
+    void stop_periodic_dump();
+
+    void start_access_trace(const std::string &path);
+
+    size_t reattach_shared_frames(lsn_t max_lsn);
+
+    /**
+     * @description: 正常关闭数据库前调用，此后关闭文件时已写回的页面在共享内存段中的帧描述保留，
+     *               下一个进程可以接管它们。调用后不应再有文件被删除或重新创建
+     */
+    void retain_shared_frames() { retain_shared_frames_ = true; }
+
+    /**
+     * @description: 帧是否放在共享内存段中
+     */
+    bool is_shared() const { return shared_segment_ != nullptr; }
+
+    void stop_access_trace();
+
+    /**
+     * @description: 获得分片个数
+     */
+    size_t get_num_shards() const { return num_shards_; }
+
+    /**
+     * @description: 获得帧数据区实际使用的内存类型
+     */
+    FramePageType get_frame_page_type() const { return arena_->get_page_type(); }
+
+    /**
+     * @description: 获得缓冲池当前使用的帧个数
+     */
+    size_t get_pool_size() const { return pool_size_.load(); }
+
+    /**
+     * @description: 获得预留的帧个数，即缓冲池可以扩大到的上限
+     */
+    size_t get_max_pool_size() const { return max_pool_size_; }
+
    private:
-    bool find_victim_page(frame_id_t* frame_id);
+    /**
+     * @description: 页面所在的分片。同一文件中每BUFFER_POOL_SHARD_PAGES个连续页面属于同一个分片
+     * @param {PageId} page_id 目标页面
+     */
+    Shard &shard_of(PageId page_id) {
+        uint64_t key = static_cast<uint64_t>(PageId{page_id.fd, page_id.page_no / BUFFER_POOL_SHARD_PAGES}.Get());
+        return shards_[((key * 0x9E3779B97F4A7C15ULL) >> 32) % num_shards_];
+    }
+
+    /**
+     * @description: 缓冲池有pool_size个帧时第i个分片使用的帧个数，不超过分片预留的帧个数
+     * @param {size_t} i 分片下标
+     * @param {size_t} pool_size 缓冲池的帧个数
+     */
+    size_t shard_active_frames(size_t i, size_t pool_size) const {
+        size_t reserved = (i + 1) * max_pool_size_ / num_shards_ - i * max_pool_size_ / num_shards_;
+        return std::min(reserved, (i + 1) * pool_size / num_shards_ - i * pool_size / num_shards_);
+    }
+
+    bool find_victim_page(Shard& shard, frame_id_t* frame_id);
+
+    bool find_victim_page(Shard& shard, frame_id_t* frame_id, BufferAccessStrategy* strategy);
+
+    size_t ring_capacity(const Shard& shard, const BufferAccessStrategy* strategy) const;
+
+    void add_to_ring(Shard& shard, BufferAccessStrategy* strategy, frame_id_t frame_id, PageId page_id);
+
+    void map_page(Shard& shard, PageId page_id, frame_id_t frame_id);
+
+    void unmap_page(Shard& shard, PageId page_id, frame_id_t frame_id);
+
+    void set_dirty(Shard& shard, frame_id_t frame_id, bool is_dirty);
+
+    void swizzle(Page* page, std::atomic<Page*>* swip);
+
+    void unswizzle(Page* page);
+
+    void release_frame(Shard& shard, frame_id_t frame_id);
+
+    void discard_frame(Shard& shard, frame_id_t frame_id);
+
+    void relocate_frame(Shard& shard, frame_id_t src_frame_id, frame_id_t dst_frame_id);
+
+    std::vector<bool> collect_shared_frames();
+
+    void sync_shared_frame(const Page* page);
+
+    void clear_shared_frame(const Page* page);
+
+    void drop_shared_frame(size_t frame);
+
+    bool shrink_shard(Shard& shard, std::unique_lock<std::mutex>& lock);
+
+    void evict_frame(Shard& shard, Page* page, std::unique_lock<std::mutex>& lock);
+
+    void wait_for_io(Shard& shard, Page* page, std::unique_lock<std::mutex>& lock);
+
+    void claim_ring_batch(Shard& shard, BufferAccessStrategy* strategy, PageId page_id,
+                          std::vector<frame_id_t>* frames, std::unique_lock<std::mutex>& lock);
+
+    std::vector<bool> read_frames(Shard& shard, PageId start_page_id, const std::vector<frame_id_t>& frames,
+                                  std::unique_lock<std::mutex>& lock);
+
+    std::vector<bool> read_pages_async(int fd, const std::vector<std::pair<page_id_t, char*>>& pages);
+
+    void update_page(Shard& shard, Page* page, PageId new_page_id, frame_id_t new_frame_id,
+                     std::unique_lock<std::mutex>& lock);
+
+    size_t write_back_victim(Shard& shard, Page* victim, std::unique_lock<std::mutex>& lock);
+
+    Page* find_dirty_unpinned_page(Shard& shard, PageId page_id);
+
+    void write_page_run(const std::vector<Page*>& run);
+
+    void write_pages_logged(int fd, page_id_t start_page_no, const std::vector<const char*>& pages_data);
+
+    page_id_t first_lsn_page(int fd);
+
+    void write_pinned_run(Shard& shard, const std::vector<Page*>& run);
+
+    void record_access(Shard& shard, frame_id_t frame_id, PageId page_id);
+
+    ReadaheadState& thread_readahead_state(int fd);
+
+    void on_page_access(PageId page_id);
+
+    void schedule_readahead(PageId start_page_id, int num_pages);
+
+    void cancel_readahead(Shard& shard, PageId page_id);
+
+    void readahead_worker();
+
+    void run_readahead(const ReadaheadRequest& request);
+
+    void warm_up_worker();
+
+    void background_writer();
 
-    void update_page(Page* page, PageId new_page_id, frame_id_t new_frame_id);
+    void clean_victim_frames(Shard& shard, std::unique_lock<std::mutex>& lock);
 };
\ No newline at end of file
@@ -0,0 +1,79 @@
+#include "storage/buffer_pool_set.h"
+
+/**
+ * @description: 创建一个具名缓冲池
+ * @param {string&} name 缓冲池名称
+ * @param {size_t} pool_size 缓冲池中的帧个数
+ * @param {string&} replacer_type 置换策略：LRU、CLOCK、LRU-K或ARC
+ */
+void BufferPoolSet::create_pool(const std::string &name, size_t pool_size, const std::string &replacer_type) {
+    if (pool_size == 0) {
+        throw InternalError("BufferPoolSet: buffer pool size must be positive");
+    }
+    std::unique_lock<std::shared_mutex> lock(latch_);
+    if (name == DEFAULT_BUFFER_POOL || pools_.count(name) != 0) {
+        throw BufferPoolExistsError(name);
+    }
+    pools_.emplace(name, std::make_unique<BufferPoolManager>(pool_size, disk_manager_, 0, replacer_type));
+}
+
+/**
+ * @description: 删除一个具名缓冲池，调用者需保证已经没有打开的文件使用它
+ * @param {string&} name 缓冲池名称
+ */
+void BufferPoolSet::drop_pool(const std::string &name) {
+    std::unique_lock<std::shared_mutex> lock(latch_);
+    if (name == DEFAULT_BUFFER_POOL) {
+        throw InternalError("BufferPoolSet: cannot drop the default buffer pool");
+    }
+    if (pools_.erase(name) == 0) {
+        throw BufferPoolNotFoundError(name);
+    }
+}
+
+/**
+ * @description: 按名称获取缓冲池
+ * @return {BufferPoolManager*} 缓冲池
+ * @param {string&} name 缓冲池名称
+ */
+BufferPoolManager *BufferPoolSet::get_pool(const std::string &name) const {
+    if (name == DEFAULT_BUFFER_POOL) {
+        return default_pool_;
+    }
+    std::shared_lock<std::shared_mutex> lock(latch_);
+    auto pos = pools_.find(name);
+    if (pos == pools_.end()) {
+        throw BufferPoolNotFoundError(name);
+    }
+    return pos->second.get();
+}
+
+bool BufferPoolSet::is_pool(const std::string &name) const {
+    std::shared_lock<std::shared_mutex> lock(latch_);
+    return name == DEFAULT_BUFFER_POOL || pools_.count(name) != 0;
+}
+
+/**
+ * @description: 获取所有缓冲池的名称，默认缓冲池排在第一个
+ * @return {vector<string>} 缓冲池名称
+ */
+std::vector<std::string> BufferPoolSet::get_pool_names() const {
+    std::shared_lock<std::shared_mutex> lock(latch_);
+    std::vector<std::string> names{DEFAULT_BUFFER_POOL};
+    for (auto &entry : pools_) {
+        names.push_back(entry.first);
+    }
+    return names;
+}
+
+/**
+ * @description: 缓冲池转储文件的名称，默认缓冲池沿用BUFFER_POOL_DUMP_FILE
+ * @return {string} 转储文件名称
+ * @param {string&} name 缓冲池名称
+ */
+std::string BufferPoolSet::dump_file(const std::string &name) {
+    if (name == DEFAULT_BUFFER_POOL) {
+        return BUFFER_POOL_DUMP_FILE;
+    }
+    return "buffer_pool." + name + ".dump";
+}
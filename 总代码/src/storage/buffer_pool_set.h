@@ -0,0 +1,43 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+#include "storage/buffer_pool_manager.h"
+
+/**
+ * @description: 数据库中所有具名缓冲池的集合。每个缓冲池有独立的大小和置换策略，表和索引的文件在打开时
+ *               按元数据中记录的缓冲池名称取得各自的BufferPoolManager，此后句柄只访问自己的缓冲池，
+ *               因此大表的扫描和追加不会把其他缓冲池中延迟敏感的索引页面挤出去。
+ *               默认缓冲池(DEFAULT_BUFFER_POOL)由启动时创建，不归本集合所有，也不能删除
+ */
+class BufferPoolSet {
+   public:
+    /**
+     * @param {DiskManager*} disk_manager 新建缓冲池使用的磁盘管理器
+     * @param {BufferPoolManager*} default_pool 默认缓冲池
+     */
+    BufferPoolSet(DiskManager *disk_manager, BufferPoolManager *default_pool)
+        : disk_manager_(disk_manager), default_pool_(default_pool) {}
+
+    void create_pool(const std::string &name, size_t pool_size, const std::string &replacer_type = REPLACER_TYPE);
+
+    void drop_pool(const std::string &name);
+
+    BufferPoolManager *get_pool(const std::string &name) const;
+
+    bool is_pool(const std::string &name) const;
+
+    std::vector<std::string> get_pool_names() const;
+
+    static std::string dump_file(const std::string &name);
+
+   private:
+    DiskManager *disk_manager_;
+    BufferPoolManager *default_pool_;
+    std::map<std::string, std::unique_ptr<BufferPoolManager>> pools_;  // 名称 -> 缓冲池，不含默认缓冲池
+    mutable std::shared_mutex latch_;
+};
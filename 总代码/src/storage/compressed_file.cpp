@@ -0,0 +1,303 @@
+#include "storage/compressed_file.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include "errors.h"
+#include "storage/page_codec.h"
+
+/**
+ * @description: 打开一个压缩文件，读入页面映射表；映射表文件不存在(上次没有正常关闭)时扫描所有槽重建
+ * @param {int} fd 已打开的文件句柄
+ * @param {string&} path 文件路径
+ */
+CompressedFile::CompressedFile(int fd, const std::string &path) : fd_(fd), path_(path) {
+    if (!load_page_map()) {
+        rebuild_page_map();
+    }
+}
+
+/**
+ * @description: 把一个新建的空文件初始化为压缩文件，写入超级块
+ * @param {int} fd 文件句柄
+ */
+void CompressedFile::format(int fd) {
+    char superblock[SUPERBLOCK_SIZE] = {};
+    memcpy(superblock, &FILE_MAGIC, sizeof(FILE_MAGIC));
+    if (pwrite(fd, superblock, SUPERBLOCK_SIZE, 0) != SUPERBLOCK_SIZE) {
+        throw UnixError();
+    }
+}
+
+/**
+ * @description: 根据超级块判断文件是否为压缩文件
+ * @param {string&} path 文件路径
+ */
+bool CompressedFile::is_compressed(const std::string &path) {
+    std::ifstream ifs(path, std::ios::binary);
+    uint64_t magic = 0;
+    return ifs.read(reinterpret_cast<char *>(&magic), sizeof(magic)) && magic == FILE_MAGIC;
+}
+
+/**
+ * @description: 读取页面的前num_bytes个字节
+ */
+void CompressedFile::read_page(page_id_t page_no, char *offset, int num_bytes) {
+    if (num_bytes > PAGE_SIZE) {
+        throw InternalError("DiskManager::read_page Error");
+    }
+    char page[PAGE_SIZE];
+    std::lock_guard<std::mutex> lock(latch_);
+    read_full_page(page_no, page);
+    memcpy(offset, page, num_bytes);
+}
+
+/**
+ * @description: 写入页面的前num_bytes个字节；不足一个页面时先读出原页面(不存在时视为全0)再合并
+ */
+void CompressedFile::write_page(page_id_t page_no, const char *offset, int num_bytes) {
+    if (num_bytes > PAGE_SIZE) {
+        throw InternalError("DiskManager::write_page Error");
+    }
+    std::lock_guard<std::mutex> lock(latch_);
+    if (num_bytes == PAGE_SIZE) {
+        write_full_page(page_no, offset);
+        return;
+    }
+    char page[PAGE_SIZE] = {};
+    if (page_map_.count(page_no)) {
+        read_full_page(page_no, page);
+    }
+    memcpy(page, offset, num_bytes);
+    write_full_page(page_no, page);
+}
+
+/**
+ * @description: 释放页面占用的槽，之后读取该页面会失败，直到它被重新写入
+ */
+void CompressedFile::free_page(page_id_t page_no) {
+    std::lock_guard<std::mutex> lock(latch_);
+    auto it = page_map_.find(page_no);
+    if (it != page_map_.end()) {
+        release_slot(it->second);
+        page_map_.erase(it);
+    }
+}
+
+size_t CompressedFile::get_stored_bytes() {
+    std::lock_guard<std::mutex> lock(latch_);
+    size_t bytes = 0;
+    for (auto &entry : page_map_) {
+        bytes += entry.second.stored_len;
+    }
+    return bytes;
+}
+
+size_t CompressedFile::get_num_pages() {
+    std::lock_guard<std::mutex> lock(latch_);
+    return page_map_.size();
+}
+
+void CompressedFile::read_full_page(page_id_t page_no, char *page) {
+    auto it = page_map_.find(page_no);
+    if (it == page_map_.end()) {
+        throw InternalError("DiskManager::read_page Error");
+    }
+    const Slot &slot = it->second;
+    char buf[sizeof(SlotHdr) + PAGE_SIZE];
+    ssize_t len = sizeof(SlotHdr) + slot.stored_len;
+    ssize_t bytes_read = pread(fd_, buf, len, slot.offset);
+    if (bytes_read == -1) {
+        throw UnixError();
+    }
+    SlotHdr hdr;
+    memcpy(&hdr, buf, sizeof(hdr));
+    if (bytes_read != len || hdr.magic != SLOT_MAGIC || hdr.page_no != page_no || hdr.stored_len != slot.stored_len) {
+        throw InternalError("DiskManager::read_page Error");
+    }
+    const char *data = buf + sizeof(SlotHdr);
+    if (slot.stored_len == PAGE_SIZE) {
+        memcpy(page, data, PAGE_SIZE);
+    } else if (PageCodec::decompress(data, slot.stored_len, page, PAGE_SIZE) != PAGE_SIZE) {
+        throw InternalError("CompressedFile: corrupted page " + std::to_string(page_no) + " in " + path_);
+    }
+}
+
+void CompressedFile::write_full_page(page_id_t page_no, const char *page) {
+    char buf[sizeof(SlotHdr) + PAGE_SIZE];
+    // 压缩结果至少要比原页面小，否则按原样存储
+    int stored_len = PageCodec::compress(page, PAGE_SIZE, buf + sizeof(SlotHdr), PAGE_SIZE - 1);
+    if (stored_len < 0) {
+        stored_len = PAGE_SIZE;
+        memcpy(buf + sizeof(SlotHdr), page, PAGE_SIZE);
+    }
+    uint16_t need = sectors_for(stored_len);
+
+    Slot slot;
+    auto it = page_map_.find(page_no);
+    if (it != page_map_.end() && it->second.capacity >= need) {
+        slot = it->second;  // 原地覆盖，槽的大小不变
+    } else {
+        if (it != page_map_.end()) {
+            release_slot(it->second);
+        }
+        slot.offset = take_slot(need, &slot.capacity);
+    }
+    slot.stored_len = static_cast<uint16_t>(stored_len);
+    slot.seq = next_seq_++;
+
+    SlotHdr hdr{SLOT_MAGIC, page_no, slot.seq, slot.stored_len, slot.capacity};
+    memcpy(buf, &hdr, sizeof(hdr));
+    ssize_t len = sizeof(SlotHdr) + stored_len;
+    ssize_t bytes_written = pwrite(fd_, buf, len, slot.offset);
+    if (bytes_written == -1) {
+        throw UnixError();
+    }
+    if (bytes_written != len) {
+        throw InternalError("DiskManager::write_page Error");
+    }
+    page_map_[page_no] = slot;
+}
+
+/**
+ * @description: 分配一个至少capacity个扇区的槽：优先复用大小接近的空闲槽，否则在文件末尾分配
+ * @return {off_t} 槽在文件中的位置
+ * @param {uint16_t*} taken_capacity 实际分配到的槽的大小
+ */
+off_t CompressedFile::take_slot(uint16_t capacity, uint16_t *taken_capacity) {
+    // 只复用最多大一个扇区的空闲槽，避免小页面长期占用大槽
+    for (auto it = free_slots_.lower_bound(capacity); it != free_slots_.end() && it->first <= capacity + 1; ++it) {
+        if (!it->second.empty()) {
+            off_t offset = it->second.back();
+            it->second.pop_back();
+            *taken_capacity = it->first;
+            return offset;
+        }
+    }
+    off_t offset = end_offset_;
+    end_offset_ += static_cast<off_t>(capacity) * SECTOR_SIZE;
+    *taken_capacity = capacity;
+    return offset;
+}
+
+void CompressedFile::release_slot(const Slot &slot) { free_slots_[slot.capacity].push_back(slot.offset); }
+
+/**
+ * @description: 把页面映射表和空闲槽列表写入"<文件名>.pagemap"，在关闭文件时调用
+ */
+void CompressedFile::persist() {
+    std::lock_guard<std::mutex> lock(latch_);
+    std::ofstream ofs(get_page_map_name(path_), std::ios::binary | std::ios::trunc);
+    if (!ofs.is_open()) {
+        throw UnixError();
+    }
+    auto put = [&ofs](const auto &value) { ofs.write(reinterpret_cast<const char *>(&value), sizeof(value)); };
+    put(MAP_MAGIC);
+    put(next_seq_);
+    put(static_cast<int64_t>(end_offset_));
+    put(static_cast<uint32_t>(page_map_.size()));
+    for (auto &[page_no, slot] : page_map_) {
+        put(page_no);
+        put(static_cast<int64_t>(slot.offset));
+        put(slot.stored_len);
+        put(slot.capacity);
+        put(slot.seq);
+    }
+    uint32_t num_free = 0;
+    for (auto &entry : free_slots_) num_free += entry.second.size();
+    put(num_free);
+    for (auto &[capacity, offsets] : free_slots_) {
+        for (off_t offset : offsets) {
+            put(static_cast<int64_t>(offset));
+            put(capacity);
+        }
+    }
+    ofs.close();
+    if (!ofs) {
+        throw InternalError("CompressedFile: failed to write page map of " + path_);
+    }
+}
+
+/**
+ * @description: 读入页面映射表文件并删除它。之后的写入会改变映射表，若不删除，崩溃后残留的旧映射表会指向过期的槽
+ * @return {bool} 映射表文件存在且完整时返回true
+ */
+bool CompressedFile::load_page_map() {
+    std::string map_name = get_page_map_name(path_);
+    std::ifstream ifs(map_name, std::ios::binary);
+    if (!ifs.is_open()) {
+        return false;
+    }
+    auto get = [&ifs](auto &value) { return static_cast<bool>(ifs.read(reinterpret_cast<char *>(&value), sizeof(value))); };
+    uint32_t magic = 0, num_pages = 0, num_free = 0;
+    int64_t end_offset = 0;
+    bool ok = get(magic) && magic == MAP_MAGIC && get(next_seq_) && get(end_offset) && get(num_pages);
+    end_offset_ = end_offset;
+    for (uint32_t i = 0; ok && i < num_pages; i++) {
+        page_id_t page_no;
+        int64_t offset;
+        Slot slot;
+        ok = get(page_no) && get(offset) && get(slot.stored_len) && get(slot.capacity) && get(slot.seq);
+        slot.offset = offset;
+        page_map_[page_no] = slot;
+    }
+    ok = ok && get(num_free);
+    for (uint32_t i = 0; ok && i < num_free; i++) {
+        int64_t offset;
+        uint16_t capacity;
+        ok = get(offset) && get(capacity);
+        free_slots_[capacity].push_back(offset);
+    }
+    ifs.close();
+    if (unlink(map_name.c_str()) == -1) {
+        throw UnixError();
+    }
+    if (!ok) {
+        page_map_.clear();
+        free_slots_.clear();
+        end_offset_ = SUPERBLOCK_SIZE;
+        next_seq_ = 1;
+    }
+    return ok;
+}
+
+/**
+ * @description: 从超级块之后顺序扫描所有槽，每个页面取写入序号最大的槽，其余的槽作为空闲槽；
+ *               遇到不完整的槽头(崩溃时写了一半的文件末尾)时停止
+ */
+void CompressedFile::rebuild_page_map() {
+    page_map_.clear();
+    free_slots_.clear();
+    next_seq_ = 1;
+    off_t file_size = lseek(fd_, 0, SEEK_END);
+    if (file_size == -1) {
+        throw UnixError();
+    }
+    off_t offset = SUPERBLOCK_SIZE;
+    while (offset + static_cast<off_t>(sizeof(SlotHdr)) <= file_size) {
+        SlotHdr hdr;
+        if (pread(fd_, &hdr, sizeof(hdr), offset) != static_cast<ssize_t>(sizeof(hdr))) {
+            throw UnixError();
+        }
+        if (hdr.magic != SLOT_MAGIC || hdr.capacity == 0 || hdr.stored_len > PAGE_SIZE ||
+            hdr.capacity < sectors_for(hdr.stored_len)) {
+            break;
+        }
+        Slot slot{offset, hdr.stored_len, hdr.capacity, hdr.seq};
+        auto it = page_map_.find(hdr.page_no);
+        if (it == page_map_.end()) {
+            page_map_[hdr.page_no] = slot;
+        } else if (it->second.seq < hdr.seq) {
+            release_slot(it->second);
+            it->second = slot;
+        } else {
+            release_slot(slot);
+        }
+        next_seq_ = std::max(next_seq_, hdr.seq + 1);
+        offset += static_cast<off_t>(hdr.capacity) * SECTOR_SIZE;
+    }
+    end_offset_ = offset;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <sys/types.h>
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/config.h"
+
+/**
+ * @description: 压缩模式的数据文件。每个页面压缩后存放在一个变长的槽(slot)中，槽的大小是SECTOR_SIZE的整数倍，
+ * 由页面映射表(page_no -> 槽)定位。文件布局为：
+ *   [超级块 SUPERBLOCK_SIZE字节][槽][槽]...
+ * 每个槽以SlotHdr开头，记录页面号、写入序号、存储长度和槽的大小，因此即使页面映射表丢失(如崩溃)，
+ * 也可以顺序扫描所有槽、按序号取每个页面的最新版本重建映射表。
+ * 页面重写时，新的压缩结果放得下就原地覆盖，否则换到空闲槽或文件末尾的新槽，旧槽进入空闲槽列表等待复用。
+ * 压缩后不小于一个页面时按原样存储。
+ * 页面映射表在关闭文件时保存到"<文件名>.pagemap"，打开文件时读入并删除该文件。
+ * 对BufferPoolManager透明：DiskManager对压缩文件的读写始终以完整页面为单位进行编解码。
+ */
+class CompressedFile {
+   public:
+    static constexpr int SECTOR_SIZE = 512;
+    static constexpr int SUPERBLOCK_SIZE = SECTOR_SIZE;
+    static constexpr uint64_t FILE_MAGIC = 0x315352504d434255ULL;  // "UBCMPRS1"
+    static constexpr uint32_t SLOT_MAGIC = 0x544f4c53;             // "SLOT"
+    static constexpr uint32_t MAP_MAGIC = 0x50414d50;              // "PMAP"
+
+    CompressedFile(int fd, const std::string &path);
+
+    CompressedFile(const CompressedFile &) = delete;
+    CompressedFile &operator=(const CompressedFile &) = delete;
+
+    static void format(int fd);
+
+    static bool is_compressed(const std::string &path);
+
+    static std::string get_page_map_name(const std::string &path) { return path + PAGE_MAP_FILE_SUFFIX; }
+
+    void read_page(page_id_t page_no, char *offset, int num_bytes);
+
+    void write_page(page_id_t page_no, const char *offset, int num_bytes);
+
+    void free_page(page_id_t page_no);
+
+    void persist();
+
+    /** @return 所有页面压缩后实际存储的字节数之和 */
+    size_t get_stored_bytes();
+
+    /** @return 文件中存放的页面个数 */
+    size_t get_num_pages();
+
+   private:
+    // 磁盘上每个槽的头部
+    struct SlotHdr {
+        uint32_t magic;
+        page_id_t page_no;
+        uint32_t seq;         // 写入序号，同一页面序号最大的槽是最新版本
+        uint16_t stored_len;  // 槽中数据的长度，等于PAGE_SIZE时表示未压缩
+        uint16_t capacity;    // 槽的大小(扇区数)，包含SlotHdr
+    };
+
+    // 页面映射表中的一项，描述页面当前所在的槽
+    struct Slot {
+        off_t offset;
+        uint16_t stored_len;
+        uint16_t capacity;
+        uint32_t seq;
+    };
+
+    static uint16_t sectors_for(int stored_len) {
+        return static_cast<uint16_t>((sizeof(SlotHdr) + stored_len + SECTOR_SIZE - 1) / SECTOR_SIZE);
+    }
+
+    void read_full_page(page_id_t page_no, char *page);
+
+    void write_full_page(page_id_t page_no, const char *page);
+
+    off_t take_slot(uint16_t capacity, uint16_t *taken_capacity);
+
+    void release_slot(const Slot &slot);
+
+    bool load_page_map();
+
+    void rebuild_page_map();
+
+    int fd_;
+    std::string path_;
+    std::mutex latch_;
+    std::unordered_map<page_id_t, Slot> page_map_;       // 页面映射表
+    std::map<uint16_t, std::vector<off_t>> free_slots_;  // 空闲槽，按槽大小(扇区数)分组
+    off_t end_offset_ = SUPERBLOCK_SIZE;                 // 最后一个槽之后的位置，新槽从这里分配
+    uint32_t next_seq_ = 1;
+};
@@ -3,11 +3,72 @@
 #include <assert.h>    // for assert
 #include <string.h>    // for memset
 #include <sys/stat.h>  // for stat
-#include <unistd.h>    // for lseek
+#include <unistd.h>    // for pread, pwrite
+
+#include <algorithm>
+#include <climits>     // for IOV_MAX, PATH_MAX
+#include <cstdint>
 
 #include "defs.h"
+#include "storage/aligned_buffer.h"
+
+namespace {
+
+/**
+ * @description: 判断缓冲区地址和长度是否满足O_DIRECT的对齐要求
+ */
+inline bool is_direct_aligned(const void *buf, size_t len) {
+    return reinterpret_cast<uintptr_t>(buf) % DIRECT_IO_ALIGNMENT == 0 && len % DIRECT_IO_ALIGNMENT == 0;
+}
+
+}  // namespace
+
+/**
+ * @description: 在一次I/O期间固定文件的操作系统描述符，防止它被其他线程淘汰关闭；描述符已被淘汰时重新打开
+ */
+class DiskManager::OsFd {
+   public:
+    OsFd(DiskManager *disk_manager, FileEntry *entry) : disk_manager_(disk_manager), entry_(entry) {
+        os_fd_ = disk_manager_->pin_os_fd(entry_);
+    }
+
+    ~OsFd() {
+        if (entry_ != nullptr) {
+            disk_manager_->unpin_os_fd(entry_);
+        }
+    }
 
-DiskManager::DiskManager() { memset(fd2pageno_, 0, MAX_FD * (sizeof(std::atomic<page_id_t>) / sizeof(char))); }
+    OsFd(const OsFd &) = delete;
+    OsFd &operator=(const OsFd &) = delete;
+
+    int get() const { return os_fd_; }
+
+    /** @description: 放弃对描述符的固定权，由调用者负责之后调用unpin_os_fd */
+    FileEntry *release() {
+        FileEntry *entry = entry_;
+        entry_ = nullptr;
+        return entry;
+    }
+
+   private:
+    DiskManager *disk_manager_;
+    FileEntry *entry_;
+    int os_fd_;
+};
+
+DiskManager::DiskManager() = default;
+
+DiskManager::~DiskManager() {
+    for (int fd = 0; fd < next_fd_; fd++) {
+        int os_fd = file_entry(fd)->os_fd;
+        if (os_fd >= 0) {
+            close(os_fd);
+        }
+    }
+    for (auto &chunk : file_chunks_) {
+        delete[] chunk.load();
+    }
+}
 
 /**
  * @description: 将数据写入文件的指定磁盘页面中
@@ -17,16 +78,19 @@ DiskManager::DiskManager() { memset(fd2pageno_, 0, MAX_FD * (sizeof(std::atomic<
  * @param {int} num_bytes 要写入磁盘的数据大小
  */
 void DiskManager::write_page(int fd, page_id_t page_no, const char *offset, int num_bytes) {
-    // Todo:
-    // 1.lseek()定位到文件头，通过(fd,page_no)可以定位指定页面及其在磁盘文件中的偏移量
-    // 2.调用write()函数
+    // 使用pwrite()按页面偏移量直接写入，不修改文件的共享读写位置，多个线程并发访问同一文件时互不干扰
     // 注意write返回值与num_bytes不等时 throw InternalError("DiskManager::write_page Error");
-    assert(fd>=0);
-    off_t pos=(page_no)*PAGE_SIZE;
-    if(lseek(fd,pos,SEEK_SET)==-1){
+    FileEntry *entry = opened_entry(fd);
+    if (CompressedFile *file = entry->compressed.get()) {
+        file->write_page(page_no, offset, num_bytes);
+        return;
+    }
+    OsFd os_fd(this, entry);
+    off_t pos=static_cast<off_t>(page_no)*PAGE_SIZE;
+    ssize_t bytes_written=entry->direct?pwrite_direct(os_fd.get(),offset,num_bytes,pos):pwrite(os_fd.get(),offset,num_bytes,pos);
+    if(bytes_written==-1){
         throw UnixError();
     }
-    ssize_t bytes_written=write(fd,offset,num_bytes);
     if(bytes_written!=num_bytes){
         throw InternalError("DiskManager::write_page Error");
     }
@@ -40,33 +104,555 @@ void DiskManager::write_page(int fd, page_id_t page_no, const char *offset, int
  * @param {int} num_bytes 读取的数据量大小
  */
 void DiskManager::read_page(int fd, page_id_t page_no, char *offset, int num_bytes) {
-    // Todo:
-    // 1.lseek()定位到文件头，通过(fd,page_no)可以定位指定页面及其在磁盘文件中的偏移量
-    // 2.调用read()函数
+    // 使用pread()按页面偏移量直接读取，不修改文件的共享读写位置
     // 注意read返回值与num_bytes不等时，throw InternalError("DiskManager::read_page Error");
-    assert(fd>=0);
-    off_t pos=page_no*PAGE_SIZE;
-    if(lseek(fd,pos,SEEK_SET)==-1){
+    FileEntry *entry = opened_entry(fd);
+    if (CompressedFile *file = entry->compressed.get()) {
+        file->read_page(page_no, offset, num_bytes);
+        return;
+    }
+    OsFd os_fd(this, entry);
+    off_t pos=static_cast<off_t>(page_no)*PAGE_SIZE;
+    ssize_t bytes_read=entry->direct?pread_direct(os_fd.get(),offset,num_bytes,pos):pread(os_fd.get(),offset,num_bytes,pos);
+    if(bytes_read==-1){
         throw UnixError();
     }
-    ssize_t bytes_read=read(fd,offset,num_bytes);
     if(bytes_read!=num_bytes){
         throw InternalError("DiskManager::read_page Error");
     }
 }
 
+/**
+ * @description: 将num_pages个内存页面写入文件中从start_page_no开始的连续页面，一次系统调用完成一批页面的写入
+ * @param {int} fd 磁盘文件的文件句柄
+ * @param {page_id_t} start_page_no 第一个目标页面的page_id
+ * @param {char*const*} pages_data 每个页面的数据首地址，pages_data[i]写入页面start_page_no+i，每个页面大小为PAGE_SIZE
+ * @param {int} num_pages 连续页面的个数
+ */
+void DiskManager::write_pages(int fd, page_id_t start_page_no, const char *const *pages_data, int num_pages) {
+    assert(num_pages >= 0);
+    FileEntry *entry = opened_entry(fd);
+    if (entry->compressed != nullptr ||
+        (entry->direct && !std::all_of(pages_data, pages_data + num_pages,
+                                       [](const char *data) { return is_direct_aligned(data, PAGE_SIZE); }))) {
+        // 压缩文件的页面在磁盘上不连续，需要逐页编码；
+        // O_DIRECT要求每个iovec都对齐，有未对齐的缓冲区时逐页中转写入
+        for (int i = 0; i < num_pages; i++) {
+            write_page(fd, start_page_no + i, pages_data[i], PAGE_SIZE);
+        }
+        return;
+    }
+    OsFd os_fd(this, entry);
+    struct iovec iov[IOV_MAX];
+    for (int done = 0; done < num_pages;) {
+        int batch = std::min(num_pages - done, IOV_MAX);
+        for (int i = 0; i < batch; i++) {
+            iov[i].iov_base = const_cast<char *>(pages_data[done + i]);
+            iov[i].iov_len = PAGE_SIZE;
+        }
+        off_t pos = static_cast<off_t>(start_page_no + done) * PAGE_SIZE;
+        ssize_t bytes_written = pwritev(os_fd.get(), iov, batch, pos);
+        if (bytes_written == -1) {
+            throw UnixError();
+        }
+        if (bytes_written != static_cast<ssize_t>(batch) * PAGE_SIZE) {
+            throw InternalError("DiskManager::write_pages Error");
+        }
+        done += batch;
+    }
+}
+
+/**
+ * @description: 读取文件中从start_page_no开始的num_pages个连续页面，一次系统调用完成一批页面的读取
+ * @param {int} fd 磁盘文件的文件句柄
+ * @param {page_id_t} start_page_no 第一个页面的page_id
+ * @param {char*const*} pages_data 页面start_page_no+i的内容读到pages_data[i]中，每个缓冲区大小为PAGE_SIZE
+ * @param {int} num_pages 连续页面的个数
+ */
+void DiskManager::read_pages(int fd, page_id_t start_page_no, char *const *pages_data, int num_pages) {
+    assert(num_pages >= 0);
+    FileEntry *entry = opened_entry(fd);
+    if (entry->compressed != nullptr ||
+        (entry->direct && !std::all_of(pages_data, pages_data + num_pages,
+                                       [](const char *data) { return is_direct_aligned(data, PAGE_SIZE); }))) {
+        for (int i = 0; i < num_pages; i++) {
+            read_page(fd, start_page_no + i, pages_data[i], PAGE_SIZE);
+        }
+        return;
+    }
+    OsFd os_fd(this, entry);
+    struct iovec iov[IOV_MAX];
+    for (int done = 0; done < num_pages;) {
+        int batch = std::min(num_pages - done, IOV_MAX);
+        for (int i = 0; i < batch; i++) {
+            iov[i].iov_base = pages_data[done + i];
+            iov[i].iov_len = PAGE_SIZE;
+        }
+        off_t pos = static_cast<off_t>(start_page_no + done) * PAGE_SIZE;
+        ssize_t bytes_read = preadv(os_fd.get(), iov, batch, pos);
+        if (bytes_read == -1) {
+            throw UnixError();
+        }
+        if (bytes_read != static_cast<ssize_t>(batch) * PAGE_SIZE) {
+            throw InternalError("DiskManager::read_pages Error");
+        }
+        done += batch;
+    }
+}
+
+/**
+ * @description: 提交一个异步读页面请求，请求会与同一线程中的其他请求一起批量提交
+ * @param {int} fd 磁盘文件的文件句柄
+ * @param {page_id_t} page_no 指定的页面编号
+ * @param {char} *offset 读取的内容写入到offset中，在收到完成结果之前必须保持有效
+ * @param {int} num_bytes 读取的数据量大小
+ * @param {uint64_t} user_data 调用者自定义的请求标识，随完成结果一起返回
+ */
+void DiskManager::submit_read(int fd, page_id_t page_no, char *offset, int num_bytes, uint64_t user_data) {
+    FileEntry *entry = opened_entry(fd);
+    if (CompressedFile *file = entry->compressed.get()) {
+        // 压缩文件需要在读出后解码，同步完成
+        try {
+            file->read_page(page_no, offset, num_bytes);
+            io_queue().complete(user_data, num_bytes);
+        } catch (UnixError &) {
+            io_queue().complete(user_data, -errno);
+        } catch (InternalError &) {
+            io_queue().complete(user_data, 0);
+        }
+        return;
+    }
+    OsFd os_fd(this, entry);
+    if (entry->direct && !is_direct_aligned(offset, num_bytes)) {
+        // 未对齐的缓冲区不能直接交给O_DIRECT文件，经对齐缓冲区同步中转
+        ssize_t bytes_read = pread_direct(os_fd.get(), offset, num_bytes, static_cast<off_t>(page_no) * PAGE_SIZE);
+        io_queue().complete(user_data, bytes_read < 0 ? -errno : static_cast<int>(bytes_read));
+        return;
+    }
+    io_queue().prep_read(os_fd.get(), offset, num_bytes, static_cast<off_t>(page_no) * PAGE_SIZE, user_data);
+    if (io_queue().is_async()) {
+        // 请求提交给内核之前描述符不能被关闭，在poll_completions中解除固定
+        pending_pins().push_back(os_fd.release());
+    }
+}
+
+/**
+ * @description: 提交一个异步写页面请求
+ * @param {int} fd 磁盘文件的文件句柄
+ * @param {page_id_t} page_no 写入目标页面的page_id
+ * @param {char} *offset 要写入磁盘的数据，在收到完成结果之前必须保持有效且不能被修改
+ * @param {int} num_bytes 要写入磁盘的数据大小
+ * @param {uint64_t} user_data 调用者自定义的请求标识，随完成结果一起返回
+ */
+void DiskManager::submit_write(int fd, page_id_t page_no, const char *offset, int num_bytes, uint64_t user_data) {
+    FileEntry *entry = opened_entry(fd);
+    if (CompressedFile *file = entry->compressed.get()) {
+        try {
+            file->write_page(page_no, offset, num_bytes);
+            io_queue().complete(user_data, num_bytes);
+        } catch (UnixError &) {
+            io_queue().complete(user_data, -errno);
+        } catch (InternalError &) {
+            io_queue().complete(user_data, -EIO);
+        }
+        return;
+    }
+    OsFd os_fd(this, entry);
+    if (entry->direct && !is_direct_aligned(offset, num_bytes)) {
+        ssize_t bytes_written = pwrite_direct(os_fd.get(), offset, num_bytes, static_cast<off_t>(page_no) * PAGE_SIZE);
+        io_queue().complete(user_data, bytes_written < 0 ? -errno : static_cast<int>(bytes_written));
+        return;
+    }
+    io_queue().prep_write(os_fd.get(), offset, num_bytes, static_cast<off_t>(page_no) * PAGE_SIZE, user_data);
+    if (io_queue().is_async()) {
+        pending_pins().push_back(os_fd.release());
+    }
+}
+
+/**
+ * @description: 提交当前线程暂存的异步请求，并收割已完成请求的结果
+ * @return {int} 本次获得的完成结果个数
+ * @param {vector<IoCompletion>*} completions 完成结果追加到其末尾，result为实际读写的字节数或-errno
+ * @param {int} min_complete 至少等待的完成结果个数，为0时不阻塞
+ */
+int DiskManager::poll_completions(std::vector<IoCompletion> *completions, int min_complete) {
+    int count = io_queue().poll(completions, min_complete);
+    // poll()已把暂存的请求全部提交，内核持有了这些请求的文件引用，此后关闭描述符不再影响它们
+    for (FileEntry *entry : pending_pins()) {
+        unpin_os_fd(entry);
+    }
+    pending_pins().clear();
+    return count;
+}
+
+/**
+ * @description: 获取当前线程的I/O队列；关闭异步I/O时使用同步模式的队列
+ */
+IoQueue &DiskManager::io_queue() {
+    thread_local IoQueue async_queue(ASYNC_IO_QUEUE_DEPTH);
+    thread_local IoQueue sync_queue(0);
+    return async_io_ ? async_queue : sync_queue;
+}
+
+/**
+ * @description: 当前线程已暂存到异步I/O队列、但还没有提交给内核的请求所固定的文件
+ */
+std::vector<DiskManager::FileEntry *> &DiskManager::pending_pins() {
+    thread_local std::vector<FileEntry *> pins;
+    return pins;
+}
+
+/**
+ * @description: 从O_DIRECT文件中读取数据。缓冲区或长度未对齐时，先把覆盖目标范围的整块读到对齐缓冲区，再拷贝出需要的部分
+ * @return {ssize_t} 读到的属于[pos, pos+num_bytes)的字节数，出错时返回-1并设置errno
+ */
+ssize_t DiskManager::pread_direct(int os_fd, char *offset, int num_bytes, off_t pos) {
+    if (is_direct_aligned(offset, num_bytes)) {
+        return pread(os_fd, offset, num_bytes, pos);
+    }
+    AlignedBuffer bounce(num_bytes);
+    ssize_t bytes_read = pread(os_fd, bounce.data(), bounce.size(), pos);
+    if (bytes_read < 0) {
+        return -1;
+    }
+    bytes_read = std::min<ssize_t>(bytes_read, num_bytes);
+    memcpy(offset, bounce.data(), bytes_read);
+    return bytes_read;
+}
+
+/**
+ * @description: 向O_DIRECT文件写入数据。缓冲区或长度未对齐时，先读出覆盖目标范围的整块，
+ *               在对齐缓冲区中合并新数据后整块写回(read-modify-write)
+ * @return {ssize_t} 写入的属于[pos, pos+num_bytes)的字节数，出错时返回-1并设置errno
+ */
+ssize_t DiskManager::pwrite_direct(int os_fd, const char *offset, int num_bytes, off_t pos) {
+    if (is_direct_aligned(offset, num_bytes)) {
+        return pwrite(os_fd, offset, num_bytes, pos);
+    }
+    AlignedBuffer bounce(num_bytes);
+    if (bounce.size() != static_cast<size_t>(num_bytes)) {
+        ssize_t bytes_read = pread(os_fd, bounce.data(), bounce.size(), pos);
+        if (bytes_read < 0) {
+            return -1;
+        }
+        memset(bounce.data() + bytes_read, 0, bounce.size() - bytes_read);
+    }
+    memcpy(bounce.data(), offset, num_bytes);
+    ssize_t bytes_written = pwrite(os_fd, bounce.data(), bounce.size(), pos);
+    if (bytes_written < 0) {
+        return -1;
+    }
+    return std::min<ssize_t>(bytes_written, num_bytes);
+}
+
 /**
  * @description: 分配一个新的页号
  * @return {page_id_t} 分配的新页号
  * @param {int} fd 指定文件的文件句柄
  */
 page_id_t DiskManager::allocate_page(int fd) {
-    // 简单的自增分配策略，指定文件的页面编号加1
-    assert(fd >= 0 && fd < MAX_FD);
-    return fd2pageno_[fd]++;
+    // 优先复用页号最小的空闲页面，没有空闲页面时在文件末尾自增分配
+    FileEntry *entry = file_entry(fd);
+    assert(entry != nullptr);
+    {
+        std::lock_guard<std::mutex> lock(entry->latch);
+        if (!entry->free_pages.empty()) {
+            page_id_t page_no = *entry->free_pages.begin();
+            entry->free_pages.erase(entry->free_pages.begin());
+            return page_no;
+        }
+    }
+    return allocate_pages(fd, 1);
+}
+
+/**
+ * @description: 在文件末尾一次分配num_pages个页号连续的页面，不使用空闲页面，适合批量插入和建索引时整段申请
+ * @return {page_id_t} 第一个页面的页号
+ * @param {int} fd 指定文件的文件句柄
+ * @param {int} num_pages 页面个数
+ */
+page_id_t DiskManager::allocate_pages(int fd, int num_pages) {
+    FileEntry *entry = file_entry(fd);
+    assert(entry != nullptr && num_pages > 0);
+    page_id_t start_page_no = entry->pageno.fetch_add(num_pages);
+    reserve_extents(entry, start_page_no + num_pages);
+    return start_page_no;
+}
+
+/**
+ * @description: 保证文件中[0, end_page_no)的页面都已预分配磁盘空间：不够时用fallocate按整个extent向后预分配，
+ *               使文件在磁盘上以大块连续空间增长，而不是每次新建页面增长4KB。
+ *               使用FALLOC_FL_KEEP_SIZE，文件的逻辑大小只在页面真正写入时增长
+ * @param {FileEntry*} entry 指定文件的注册表项
+ * @param {page_id_t} end_page_no 需要预分配到的页号上界
+ */
+void DiskManager::reserve_extents(FileEntry *entry, page_id_t end_page_no) {
+    if (FILE_EXTENT_PAGES <= 1 || end_page_no <= entry->extent_end || entry->compressed != nullptr) {
+        return;
+    }
+    OsFd os_fd(this, entry);
+    std::lock_guard<std::mutex> lock(entry->latch);
+    page_id_t extent_end = entry->extent_end;
+    if (end_page_no <= extent_end) {
+        return;
+    }
+    page_id_t new_extent_end = (end_page_no + FILE_EXTENT_PAGES - 1) / FILE_EXTENT_PAGES * FILE_EXTENT_PAGES;
+    // 预分配失败(如文件系统不支持)不影响正确性，页面写入时仍会按需分配磁盘空间
+    fallocate(os_fd.get(), FALLOC_FL_KEEP_SIZE, static_cast<off_t>(extent_end) * PAGE_SIZE,
+              static_cast<off_t>(new_extent_end - extent_end) * PAGE_SIZE);
+    entry->extent_end = new_extent_end;
 }
 
-void DiskManager::deallocate_page(__attribute__((unused)) page_id_t page_id) {}
+/**
+ * @description: 释放一个页面，之后allocate_page会优先复用它。
+ *               释放后所在的连续空闲页面达到FREE_PAGE_PUNCH_MIN_RUN个时，用fallocate(PUNCH_HOLE)归还这段磁盘空间，
+ *               文件的逻辑大小不变，被打洞的页面读出来全为0
+ * @param {int} fd 指定文件的文件句柄
+ * @param {page_id_t} page_no 要释放的页面号，调用者需保证该页面不再被引用
+ */
+void DiskManager::deallocate_page(int fd, page_id_t page_no) {
+    FileEntry *entry = opened_entry(fd);
+    if (page_no < 0 || page_no >= entry->pageno) {
+        return;
+    }
+    OsFd os_fd(this, entry);
+    std::lock_guard<std::mutex> lock(entry->latch);
+    auto &free_pages = entry->free_pages;
+    if (!free_pages.insert(page_no).second) {
+        return;
+    }
+    if (CompressedFile *file = entry->compressed.get()) {
+        // 压缩文件的页面不在固定位置，直接释放其占用的槽
+        file->free_page(page_no);
+        return;
+    }
+    if (FREE_PAGE_PUNCH_MIN_RUN <= 0) {
+        return;
+    }
+    // 找到包含page_no的连续空闲页面段[first, last]
+    page_id_t first = page_no, last = page_no;
+    for (auto it = free_pages.find(page_no); it != free_pages.begin() && *std::prev(it) == first - 1; --it) {
+        first--;
+    }
+    for (auto it = std::next(free_pages.find(page_no)); it != free_pages.end() && *it == last + 1; ++it) {
+        last++;
+    }
+    if (last - first + 1 >= FREE_PAGE_PUNCH_MIN_RUN) {
+        // 打洞失败(如文件系统不支持)不影响正确性，空闲页面仍可复用
+        fallocate(os_fd.get(), FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, static_cast<off_t>(first) * PAGE_SIZE,
+                  static_cast<off_t>(last - first + 1) * PAGE_SIZE);
+    }
+}
+
+/**
+ * @description: 获得文件中当前可复用的空闲页面个数
+ * @param {int} fd 指定文件的文件句柄
+ */
+size_t DiskManager::get_num_free_pages(int fd) {
+    FileEntry *entry = opened_entry(fd);
+    std::lock_guard<std::mutex> lock(entry->latch);
+    return entry->free_pages.size();
+}
+
+/**
+ * @description: 获得压缩文件中所有页面压缩后实际占用的字节数，非压缩文件返回0
+ * @param {int} fd 指定文件的文件句柄
+ */
+size_t DiskManager::get_compressed_bytes(int fd) {
+    CompressedFile *file = compressed_file(fd);
+    return file == nullptr ? 0 : file->get_stored_bytes();
+}
+
+/**
+ * @description: 打开文件时读入其空闲页面表，并删除空闲页面表文件。调用者需持有entry->latch。
+ *               运行期间这些页面可能被重新分配，若不删除，崩溃后残留的旧表会让正在使用的页面被再次分配；
+ *               删除后崩溃只会让这些空闲页面无法被复用，不会破坏数据
+ * @param {FileEntry*} entry 文件的注册表项
+ */
+void DiskManager::load_free_pages(FileEntry *entry) {
+    entry->free_pages.clear();
+    std::string free_list_name = get_free_list_name(entry->path);
+    std::ifstream ifs(free_list_name, std::ios::binary);
+    if (!ifs.is_open()) {
+        return;
+    }
+    page_id_t page_no;
+    while (ifs.read(reinterpret_cast<char *>(&page_no), sizeof(page_no))) {
+        entry->free_pages.insert(page_no);
+    }
+    ifs.close();
+    if (unlink(free_list_name.c_str()) == -1) {
+        throw UnixError();
+    }
+}
+
+/**
+ * @description: 关闭文件时把空闲页面表写入"<文件名>.free"，没有空闲页面时不生成该文件。调用者需持有entry->latch
+ * @param {FileEntry*} entry 文件的注册表项
+ */
+void DiskManager::persist_free_pages(FileEntry *entry) {
+    std::set<page_id_t> free_pages = std::move(entry->free_pages);
+    entry->free_pages.clear();
+    if (free_pages.empty()) {
+        return;
+    }
+    std::ofstream ofs(get_free_list_name(entry->path), std::ios::binary | std::ios::trunc);
+    if (!ofs.is_open()) {
+        throw UnixError();
+    }
+    for (page_id_t page_no : free_pages) {
+        ofs.write(reinterpret_cast<const char *>(&page_no), sizeof(page_no));
+    }
+}
+
+/**
+ * @description: 获得已打开文件的注册表项
+ * @return {FileEntry*} 文件的注册表项
+ * @param {int} fd 文件句柄
+ */
+DiskManager::FileEntry *DiskManager::opened_entry(int fd) {
+    FileEntry *entry = file_entry(fd);
+    if (entry == nullptr || !entry->opened) {
+        throw FileNotOpenError(fd);
+    }
+    return entry;
+}
+
+/**
+ * @description: 查找路径对应的文件编号
+ * @return {int} 文件编号，路径没有登记时返回-1
+ * @param {string&} path 文件路径
+ */
+int DiskManager::lookup_path(const std::string &path) {
+    PathShard &shard = path_shard(path);
+    std::shared_lock<std::shared_mutex> lock(shard.latch);
+    auto it = shard.path2fd.find(path);
+    return it == shard.path2fd.end() ? -1 : it->second;
+}
+
+/**
+ * @description: 获得路径对应的文件编号，路径第一次出现时为它分配新的编号和注册表项
+ * @return {int} 文件编号
+ * @param {string&} path 文件路径
+ */
+int DiskManager::register_path(const std::string &path) {
+    int fd = lookup_path(path);
+    if (fd != -1) {
+        return fd;
+    }
+    PathShard &shard = path_shard(path);
+    std::unique_lock<std::shared_mutex> lock(shard.latch);
+    auto it = shard.path2fd.find(path);
+    if (it != shard.path2fd.end()) {
+        return it->second;
+    }
+    {
+        std::lock_guard<std::mutex> register_lock(register_latch_);
+        fd = next_fd_;
+        if (fd >= FILE_CHUNK_SIZE * MAX_FILE_CHUNKS) {
+            throw InternalError("DiskManager::register_path: too many files");
+        }
+        if (fd % FILE_CHUNK_SIZE == 0) {
+            file_chunks_[fd / FILE_CHUNK_SIZE].store(new FileEntry[FILE_CHUNK_SIZE], std::memory_order_release);
+        }
+        FileEntry *entry = &file_chunks_[fd / FILE_CHUNK_SIZE].load()[fd % FILE_CHUNK_SIZE];
+        entry->fd = fd;
+        entry->path = path;
+        // 注册表项初始化完成后才发布新的编号，file_entry()无锁读取时不会看到未初始化的项
+        next_fd_.store(fd + 1, std::memory_order_release);
+    }
+    shard.path2fd[path] = fd;
+    return fd;
+}
+
+/**
+ * @description: 固定文件的操作系统描述符，描述符已被淘汰时重新打开。固定期间描述符不会被关闭，用完后需调用unpin_os_fd
+ * @return {int} 操作系统文件描述符
+ * @param {FileEntry*} entry 已打开文件的注册表项
+ */
+int DiskManager::pin_os_fd(FileEntry *entry) {
+    // 先增加pins再读取os_fd，与try_release_os_fd中先摘下os_fd再检查pins的顺序配合，
+    // 保证两者至少有一方看到对方的修改：要么这里读到-1走重新打开的路径，要么淘汰方看到pins>0而放弃
+    entry->pins.fetch_add(1);
+    if (!entry->referenced.load(std::memory_order_relaxed)) {
+        entry->referenced.store(true, std::memory_order_relaxed);
+    }
+    int os_fd = entry->os_fd;
+    if (os_fd >= 0) {
+        return os_fd;
+    }
+    try {
+        return reopen_os_fd(entry);
+    } catch (...) {
+        entry->pins.fetch_sub(1);
+        throw;
+    }
+}
+
+/**
+ * @description: 重新打开描述符已被淘汰的文件，打开前先按需淘汰其他空闲文件的描述符
+ * @return {int} 操作系统文件描述符
+ * @param {FileEntry*} entry 已打开文件的注册表项
+ */
+int DiskManager::reopen_os_fd(FileEntry *entry) {
+    release_os_fds();
+    std::lock_guard<std::mutex> lock(entry->latch);
+    int os_fd = entry->os_fd;
+    if (os_fd >= 0) {
+        return os_fd;
+    }
+    if (!entry->opened) {
+        throw FileNotOpenError(entry->fd);
+    }
+    os_fd = open(entry->abs_path.c_str(), O_RDWR | (entry->direct ? O_DIRECT : 0));
+    if (os_fd == -1) {
+        throw UnixError();
+    }
+    num_os_fds_++;
+    entry->os_fd = os_fd;
+    return os_fd;
+}
+
+/**
+ * @description: 持有的描述符个数达到MAX_OPEN_FILES时，按clock算法关闭最近没有被访问的空闲文件的描述符，
+ *               这些文件仍然处于打开状态，下次访问时由pin_os_fd重新打开。
+ *               所有描述符都在使用时不会阻塞，允许暂时超出上限
+ */
+void DiskManager::release_os_fds() {
+    int num_files = next_fd_;
+    for (int i = 0; i < 2 * num_files && num_os_fds_ >= MAX_OPEN_FILES; i++) {
+        FileEntry *entry = file_entry(clock_hand_.fetch_add(1) % num_files);
+        if (entry->os_fd < 0 || entry->referenced.exchange(false)) {
+            continue;
+        }
+        try_release_os_fd(entry);
+    }
+}
+
+/**
+ * @description: 尝试关闭一个文件的描述符，文件正在被访问或是压缩文件时放弃
+ * @return {bool} 是否关闭了描述符
+ * @param {FileEntry*} entry 文件的注册表项
+ */
+bool DiskManager::try_release_os_fd(FileEntry *entry) {
+    std::unique_lock<std::mutex> lock(entry->latch, std::try_to_lock);
+    // 压缩文件的页面映射表直接持有描述符，不能淘汰
+    if (!lock.owns_lock() || entry->compressed != nullptr) {
+        return false;
+    }
+    int os_fd = entry->os_fd;
+    if (os_fd < 0 || entry->pins > 0) {
+        return false;
+    }
+    entry->os_fd = -1;
+    if (entry->pins > 0) {
+        entry->os_fd = os_fd;
+        return false;
+    }
+    close(os_fd);
+    num_os_fds_--;
+    return true;
+}
 
 bool DiskManager::is_dir(const std::string& path) {
     struct stat st;
@@ -103,8 +689,9 @@ bool DiskManager::is_file(const std::string &path) {
  * @description: 用于创建指定路径文件
  * @return {*}
  * @param {string} &path
+ * @param {bool} compressed 是否创建压缩文件，压缩文件中的页面以变长的压缩形式存储，对上层透明
  */
-void DiskManager::create_file(const std::string &path) {
+void DiskManager::create_file(const std::string &path, bool compressed) {
     // Todo:
     // 调用open()函数，使用O_CREAT模式
     // 注意不能重复创建相同文件
@@ -112,10 +699,13 @@ void DiskManager::create_file(const std::string &path) {
         // throw std::runtime_error("File already exists: " + path);
         throw FileExistsError(path);
     }
-    int fd=open(path.c_str(),O_CREAT);
+    int fd=open(path.c_str(),O_CREAT|O_RDWR,S_IRUSR|S_IWUSR|S_IRGRP|S_IROTH);
     if(fd==-1){
         throw UnixError();
     }
+    if (compressed) {
+        CompressedFile::format(fd);
+    }
     close(fd);
 }
 
@@ -129,13 +719,27 @@ void DiskManager::destroy_file(const std::string &path) {
     // 注意不能删除未关闭的文件
     if (!is_file(path))
         throw FileNotFoundError(path);
-    if(path2fd_.count(path)){
-        int fd=open(path.c_str(),O_CREAT);
-        throw FileNotOpenError(fd);
+    {
+        PathShard &shard = path_shard(path);
+        std::unique_lock<std::shared_mutex> lock(shard.latch);
+        auto it = shard.path2fd.find(path);
+        if (it != shard.path2fd.end()) {
+            if (file_entry(it->second)->opened) {
+                throw FileNotOpenError(it->second);
+            }
+            // 删除后原来的文件编号作废，重新创建的同名文件会分配新的编号，
+            // 缓冲池中残留的旧页面不会被当作新文件的页面
+            shard.path2fd.erase(it);
+        }
     }
     if(unlink(path.c_str())==-1){
         throw UnixError();
     }
+    for (const std::string &sidecar : {get_free_list_name(path), CompressedFile::get_page_map_name(path)}) {
+        if (is_file(sidecar) && unlink(sidecar.c_str()) == -1) {
+            throw UnixError();
+        }
+    }
 }
 
 
@@ -148,20 +752,45 @@ int DiskManager::open_file(const std::string &path) {
     // Todo:
     // 调用open()函数，使用O_RDWR模式
     // 注意不能重复打开相同文件，并且需要更新文件打开列表
-    if (path2fd_.count(path)) {
-        // throw FileNotOpenError(-1);
-        return path2fd_[path];
+    FileEntry *entry = file_entry(lookup_path(path));
+    if (entry != nullptr && entry->opened) {
+        return entry->fd;
+    }
+    if (!is_file(path)) {
+        throw FileNotFoundError(path);
+    }
+    entry = file_entry(register_path(path));
+    release_os_fds();
+    std::lock_guard<std::mutex> lock(entry->latch);
+    if (entry->opened) {
+        return entry->fd;
     }
-    int fd=open(path.c_str(), O_RDWR);
-    if (fd==-1) {
+    // 数据文件按需使用O_DIRECT，日志文件按字节追加写，始终使用带缓存的I/O
+    // 压缩文件按变长的槽读写，同样不使用O_DIRECT
+    bool compressed = CompressedFile::is_compressed(path);
+    bool direct = direct_io_ && path != LOG_FILE_NAME && !compressed;
+    int os_fd=open(path.c_str(), O_RDWR | (direct ? O_DIRECT : 0));
+    if (os_fd==-1 && direct && errno==EINVAL) {
+        // 文件系统不支持O_DIRECT(如tmpfs)，退化为带缓存的I/O
+        direct = false;
+        os_fd=open(path.c_str(), O_RDWR);
+    }
+    if (os_fd==-1) {
         if (errno==ENOENT)
             throw FileNotFoundError(path);
         throw UnixError();
     }
-    path2fd_[path] = fd;
-    fd2path_[fd] = path;
-    fd2pageno_[fd] = get_file_size(path);
-    return fd;
+    char cwd[PATH_MAX];
+    entry->abs_path = path[0] == '/' || getcwd(cwd, sizeof(cwd)) == nullptr ? path : std::string(cwd) + "/" + path;
+    num_os_fds_++;
+    entry->os_fd = os_fd;
+    entry->direct = direct;
+    entry->compressed = compressed ? std::make_unique<CompressedFile>(os_fd, path) : nullptr;
+    entry->pageno = get_file_size(path);
+    entry->extent_end = 0;
+    load_free_pages(entry);
+    entry->opened = true;
+    return entry->fd;
 }
 
 /**
@@ -172,15 +801,25 @@ void DiskManager::close_file(int fd) {
     // Todo:
     // 调用close()函数
     // 注意不能关闭未打开的文件，并且需要更新文件打开列表
-    if(!fd2path_.count(fd)){
-        throw  FileNotOpenError(fd);
+    // 文件编号和路径的对应关系保留，重新打开同一文件时得到相同的编号
+    FileEntry *entry = opened_entry(fd);
+    std::lock_guard<std::mutex> lock(entry->latch);
+    if (!entry->opened) {
+        throw FileNotOpenError(fd);
     }
-    if(close(fd)==-1){
-        throw UnixError();
+    persist_free_pages(entry);
+    if (entry->compressed != nullptr) {
+        entry->compressed->persist();
+        entry->compressed.reset();
+    }
+    entry->opened = false;
+    int os_fd = entry->os_fd.exchange(-1);
+    if (os_fd >= 0) {
+        num_os_fds_--;
+        if (close(os_fd) == -1) {
+            throw UnixError();
+        }
     }
-    std::string path=fd2path_[fd];
-    fd2path_.erase(fd);
-    path2fd_.erase(path);
 }
 
 
@@ -201,10 +840,7 @@ int DiskManager::get_file_size(const std::string &file_name) {
  * @param {int} fd 文件句柄
  */
 std::string DiskManager::get_file_name(int fd) {
-    if (!fd2path_.count(fd)) {
-        throw FileNotOpenError(fd);
-    }
-    return fd2path_[fd];
+    return opened_entry(fd)->path;
 }
 
 /**
@@ -213,10 +849,17 @@ std::string DiskManager::get_file_name(int fd) {
  * @param {string} &file_name 文件名
  */
 int DiskManager::get_file_fd(const std::string &file_name) {
-    if (!path2fd_.count(file_name)) {
-        return open_file(file_name);
-    }
-    return path2fd_[file_name];
+    return open_file(file_name);
+}
+
+/**
+ * @description: 查找已被打开的文件的句柄，与get_file_fd()不同，文件没有被打开时不会打开它
+ * @return {int} 文件句柄，文件没有被打开时返回-1
+ * @param {string} &path 文件路径
+ */
+int DiskManager::find_open_file(const std::string &path) {
+    FileEntry *entry = file_entry(lookup_path(path));
+    return entry != nullptr && entry->opened ? entry->fd : -1;
 }
 
 
@@ -239,8 +882,8 @@ int DiskManager::read_log(char *log_data, int size, int offset) {
 
     size = std::min(size, file_size - offset);
     if(size == 0) return 0;
-    lseek(log_fd_, offset, SEEK_SET);
-    ssize_t bytes_read = read(log_fd_, log_data, size);
+    OsFd os_fd(this, opened_entry(log_fd_));
+    ssize_t bytes_read = pread(os_fd.get(), log_data, size, offset);
     assert(bytes_read == size);
     return bytes_read;
 }
@@ -257,8 +900,9 @@ void DiskManager::write_log(char *log_data, int size) {
     }
 
     // write from the file_end
-    lseek(log_fd_, 0, SEEK_END);
-    ssize_t bytes_write = write(log_fd_, log_data, size);
+    OsFd os_fd(this, opened_entry(log_fd_));
+    lseek(os_fd.get(), 0, SEEK_END);
+    ssize_t bytes_write = write(os_fd.get(), log_data, size);
     if (bytes_write != size) {
         throw UnixError();
     }
@@ -2,33 +2,78 @@
 
 #include <fcntl.h>     
 #include <sys/stat.h>  
+#include <sys/uio.h>   
 #include <unistd.h>    
 
 #include <atomic>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "common/config.h"
 #include "errors.h"  
+#include "storage/compressed_file.h"
+#include "storage/io_queue.h"
 
 /**
- * @description: DiskManager的作用主要是根据上层的需要对磁盘文件进行操作
+ * @description: DiskManager的作用主要是根据上层的需要对磁盘文件进行操作。
+ * 上层使用的文件句柄fd是DiskManager分配的内部文件编号，而不是操作系统的文件描述符：
+ * 同一路径的文件在删除之前始终对应同一个编号，关闭后重新打开仍得到原来的编号；
+ * 操作系统文件描述符按需打开，数量超过MAX_OPEN_FILES时关闭空闲文件的描述符，下次访问时再重新打开
  */
 class DiskManager {
    public:
     explicit DiskManager();
 
-    ~DiskManager() = default;
+    ~DiskManager();
 
     void write_page(int fd, page_id_t page_no, const char *offset, int num_bytes);
 
     void read_page(int fd, page_id_t page_no, char *offset, int num_bytes);
 
+    void write_pages(int fd, page_id_t start_page_no, const char *const *pages_data, int num_pages);
+
+    void read_pages(int fd, page_id_t start_page_no, char *const *pages_data, int num_pages);
+
+    /*异步I/O操作，请求在当前线程的I/O队列中批量提交，通过poll_completions()获取完成结果*/
+    void submit_read(int fd, page_id_t page_no, char *offset, int num_bytes, uint64_t user_data);
+
+    void submit_write(int fd, page_id_t page_no, const char *offset, int num_bytes, uint64_t user_data);
+
+    int poll_completions(std::vector<IoCompletion> *completions, int min_complete = 0);
+
+    void set_async_io(bool enable) { async_io_ = enable; }
+
+    bool is_async_io() { return async_io_ && io_queue().is_async(); }
+
+    /*O_DIRECT模式，只影响之后打开的数据文件，日志文件始终使用带缓存的I/O*/
+    void set_direct_io(bool enable) { direct_io_ = enable; }
+
+    bool is_direct_io(int fd) {
+        FileEntry *entry = file_entry(fd);
+        return entry != nullptr && entry->direct;
+    }
+
+    /*页面压缩模式，在创建文件时指定，打开文件时根据文件的超级块自动识别*/
+    bool is_compressed(int fd) { return compressed_file(fd) != nullptr; }
+
+    size_t get_compressed_bytes(int fd);
+
     page_id_t allocate_page(int fd);
 
-    void deallocate_page(page_id_t page_id);
+    page_id_t allocate_pages(int fd, int num_pages);
+
+    void deallocate_page(int fd, page_id_t page_no);
+
+    size_t get_num_free_pages(int fd);
+
+    static std::string get_free_list_name(const std::string &path) { return path + FREE_LIST_FILE_SUFFIX; }
 
     /*目录操作*/
     bool is_dir(const std::string &path);
@@ -40,7 +85,7 @@ class DiskManager {
     /*文件操作*/
     bool is_file(const std::string &path);
 
-    void create_file(const std::string &path);
+    void create_file(const std::string &path, bool compressed = false);
 
     void destroy_file(const std::string &path);
 
@@ -54,6 +99,8 @@ class DiskManager {
 
     int get_file_fd(const std::string &file_name);
 
+    int find_open_file(const std::string &path);
+
     /*日志操作*/
     int read_log(char *log_data, int size, int offset);
 
@@ -68,22 +115,129 @@ class DiskManager {
      * @param {int} fd 文件对应的文件句柄
      * @param {int} start_page_no 已经分配的页面个数，即文件接下来从start_page_no开始分配页面编号
      */
-    void set_fd2pageno(int fd, int start_page_no) { fd2pageno_[fd] = start_page_no; }
+    void set_fd2pageno(int fd, int start_page_no) {
+        FileEntry *entry = file_entry(fd);
+        entry->pageno = start_page_no;
+        if (entry->extent_end < start_page_no) {
+            entry->extent_end = start_page_no;
+        }
+    }
 
     /**
      * @description: 获得文件目前已分配的页面个数，即如果文件要分配一个新页面，需要从fd2pagenp_[fd]开始分配
      * @return {page_id_t} 已分配的页面个数 
      * @param {int} fd 文件对应的句柄
      */
-    page_id_t get_fd2pageno(int fd) { return fd2pageno_[fd]; }
+    page_id_t get_fd2pageno(int fd) { return file_entry(fd)->pageno; }
+
+    /**
+     * @description: 获得文件已经预分配到的页面个数，即磁盘空间已预留、但不一定已被allocate_page分配出去的页号上界
+     * @param {int} fd 文件对应的句柄
+     */
+    page_id_t get_extent_end(int fd) { return file_entry(fd)->extent_end; }
 
-    static constexpr int MAX_FD = 8192;
+    /**
+     * @description: 获得当前持有的操作系统文件描述符个数
+     */
+    int get_num_os_fds() { return num_os_fds_; }
+
+    static constexpr int FILE_EXTENT_PAGES = FILE_EXTENT_SIZE / PAGE_SIZE;  // 每个extent包含的页面个数
+
+    static constexpr int FILE_CHUNK_SIZE = 1024;    // 文件注册表每个块中的文件个数
+    static constexpr int MAX_FILE_CHUNKS = 4096;    // 文件注册表的块数，最多可登记FILE_CHUNK_SIZE*MAX_FILE_CHUNKS个文件
+    static constexpr int NUM_PATH_SHARDS = 16;      // 路径到文件编号映射的分片数
 
    private:
-    // 文件打开列表，用于记录文件是否被打开
-    std::unordered_map<std::string, int> path2fd_;  //<Page文件磁盘路径,Page fd>哈希表
-    std::unordered_map<int, std::string> fd2path_;  //<Page fd,Page文件磁盘路径>哈希表
+    /**
+     * @description: 文件注册表中的一项，记录一个文件的路径、操作系统文件描述符和页面分配信息。
+     * 登记之后直到DiskManager析构都不会被释放，因此可以无锁地通过文件编号访问
+     */
+    struct FileEntry {
+        int fd = -1;                                // 文件编号，即上层使用的文件句柄
+        std::string path;                           // 文件路径
+        std::string abs_path;                       // 文件的绝对路径，重新打开描述符时使用，不受之后切换工作目录的影响
+        std::atomic<bool> opened{false};            // 是否已被上层打开(open_file之后、close_file之前)
+        std::atomic<int> os_fd{-1};                 // 操作系统文件描述符，-1表示当前没有打开
+        std::atomic<int> pins{0};                   // 正在使用os_fd的I/O个数，大于0时不能关闭os_fd
+        std::atomic<bool> referenced{false};        // 最近是否被访问过，淘汰文件描述符时使用(clock算法)
+        bool direct = false;                        // 是否以O_DIRECT打开
+        std::unique_ptr<CompressedFile> compressed;  // 压缩文件的页面映射表，非压缩文件为nullptr
+        std::atomic<page_id_t> pageno{0};           // 文件中已经分配的页面个数
+        std::atomic<page_id_t> extent_end{0};       // 文件中已用fallocate预分配磁盘空间的页面个数，不小于pageno
+        std::mutex latch;                           // 保护os_fd的打开和关闭、extent的预分配和free_pages
+        std::set<page_id_t> free_pages;             // 已释放、可重新分配的页面，按页号有序
+    };
+
+    /**
+     * @description: 路径到文件编号映射的一个分片
+     */
+    struct PathShard {
+        std::shared_mutex latch;
+        std::unordered_map<std::string, int> path2fd;
+    };
+
+    class OsFd;
+
+    /**
+     * @description: 根据文件编号找到注册表中的文件项，O(1)且不加锁
+     * @return {FileEntry*} 文件项，编号无效时返回nullptr
+     * @param {int} fd 文件编号
+     */
+    FileEntry *file_entry(int fd) {
+        if (fd < 0 || fd >= next_fd_.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return &file_chunks_[fd / FILE_CHUNK_SIZE].load(std::memory_order_acquire)[fd % FILE_CHUNK_SIZE];
+    }
+
+    FileEntry *opened_entry(int fd);
+
+    PathShard &path_shard(const std::string &path) {
+        return path_shards_[std::hash<std::string>()(path) % NUM_PATH_SHARDS];
+    }
+
+    int lookup_path(const std::string &path);
+
+    int register_path(const std::string &path);
+
+    int pin_os_fd(FileEntry *entry);
+
+    void unpin_os_fd(FileEntry *entry) { entry->pins.fetch_sub(1); }
+
+    int reopen_os_fd(FileEntry *entry);
+
+    void release_os_fds();
+
+    bool try_release_os_fd(FileEntry *entry);
+
+    static std::vector<FileEntry *> &pending_pins();
+
+    IoQueue &io_queue();
+
+    CompressedFile *compressed_file(int fd) {
+        FileEntry *entry = file_entry(fd);
+        return entry == nullptr ? nullptr : entry->compressed.get();
+    }
+
+    ssize_t pread_direct(int os_fd, char *offset, int num_bytes, off_t pos);
+
+    ssize_t pwrite_direct(int os_fd, const char *offset, int num_bytes, off_t pos);
+
+    void reserve_extents(FileEntry *entry, page_id_t end_page_no);
+
+    void load_free_pages(FileEntry *entry);
+
+    void persist_free_pages(FileEntry *entry);
+
+    // 文件注册表：路径->文件编号的映射按路径哈希分片，文件编号->文件项按块存放，块在需要时分配
+    PathShard path_shards_[NUM_PATH_SHARDS];
+    std::atomic<FileEntry *> file_chunks_[MAX_FILE_CHUNKS]{};
+    std::atomic<int> next_fd_{0};            // 下一个分配的文件编号，也是已登记的文件个数
+    std::mutex register_latch_;              // 串行化文件编号和注册表块的分配
+    std::atomic<int> num_os_fds_{0};         // 当前持有的操作系统文件描述符个数
+    std::atomic<unsigned> clock_hand_{0};    // 淘汰文件描述符时clock算法的指针
 
-    int log_fd_ = -1;                             // WAL日志文件的文件句柄，默认为-1，代表未打开日志文件
-    std::atomic<page_id_t> fd2pageno_[MAX_FD]{};  // 文件中已经分配的页面个数，初始值为0
+    int log_fd_ = -1;                        // WAL日志文件的文件句柄，默认为-1，代表未打开日志文件
+    bool async_io_ = ENABLE_ASYNC_IO;        // 是否使用io_uring提交异步I/O，为false时submit_*同步完成
+    bool direct_io_ = ENABLE_DIRECT_IO;      // 新打开的数据文件是否使用O_DIRECT
 };
\ No newline at end of file
@@ -0,0 +1,103 @@
+#include "frame_arena.h"
+
+#include <sys/mman.h>
+
+#include <cstdint>
+#include <new>
+
+/**
+ * @description: 向上取整到align的倍数
+ */
+static size_t round_up(size_t size, size_t align) { return (size + align - 1) / align * align; }
+
+FrameArena::FrameArena(size_t size, bool use_huge_pages) : size_(size) {
+    if (use_huge_pages && map_explicit_huge()) {
+        return;
+    }
+    map_normal(use_huge_pages);
+}
+
+FrameArena::FrameArena(size_t size, int shm_fd, size_t offset) : size_(size) {
+    size_t length = round_up(size_, DIRECT_IO_ALIGNMENT);
+    void *addr = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, shm_fd, static_cast<off_t>(offset));
+    if (addr == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+    mapping_ = static_cast<char *>(addr);
+    mapping_size_ = length;
+    data_ = mapping_;
+    page_type_ = FramePageType::SHARED;
+}
+
+FrameArena::~FrameArena() {
+    if (mapping_ != nullptr) {
+        munmap(mapping_, mapping_size_);
+    }
+}
+
+/**
+ * @description: 把数据区中不再使用的一段内存归还给操作系统，之后再次访问时得到全为0的新内存。
+ *               只归还完全落在范围内的页面(大页映射时为大页)，其余部分保持不变。
+ *               共享内存段中的页面由共享内存文件持有，需用MADV_REMOVE才能真正释放
+ * @param {char*} addr 起始地址，在数据区内
+ * @param {size_t} length 字节数
+ */
+void FrameArena::release(char *addr, size_t length) {
+    size_t granularity = page_type_ == FramePageType::EXPLICIT_HUGE ? HUGE_PAGE_SIZE : DIRECT_IO_ALIGNMENT;
+    uintptr_t begin = round_up(reinterpret_cast<uintptr_t>(addr), granularity);
+    uintptr_t end = (reinterpret_cast<uintptr_t>(addr) + length) / granularity * granularity;
+    if (begin < end) {
+        madvise(reinterpret_cast<void *>(begin), end - begin,
+                page_type_ == FramePageType::SHARED ? MADV_REMOVE : MADV_DONTNEED);
+    }
+}
+
+/**
+ * @description: 用预留的大页映射数据区，长度取整到HUGE_PAGE_SIZE。系统没有预留足够的大页或不支持时返回false
+ */
+bool FrameArena::map_explicit_huge() {
+#ifdef MAP_HUGETLB
+    size_t length = round_up(size_, HUGE_PAGE_SIZE);
+    void *addr = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (addr == MAP_FAILED) {
+        return false;
+    }
+    mapping_ = static_cast<char *>(addr);
+    mapping_size_ = length;
+    data_ = mapping_;
+    page_type_ = FramePageType::EXPLICIT_HUGE;
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @description: 用普通页面映射数据区。请求透明大页时多映射一个大页的长度，把数据区的起始地址对齐到大页边界，
+ *               使整个数据区都能被合并为大页，再把首尾多余的部分归还
+ * @param {bool} advise_huge 是否请求透明大页
+ */
+void FrameArena::map_normal(bool advise_huge) {
+    size_t length = advise_huge ? round_up(size_, HUGE_PAGE_SIZE) : round_up(size_, DIRECT_IO_ALIGNMENT);
+    size_t extra = advise_huge ? HUGE_PAGE_SIZE : 0;
+    void *addr = mmap(nullptr, length + extra, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (addr == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+    char *begin = static_cast<char *>(addr);
+    char *aligned = reinterpret_cast<char *>(round_up(reinterpret_cast<uintptr_t>(begin), extra == 0 ? 1 : extra));
+    if (aligned > begin) {
+        munmap(begin, aligned - begin);
+    }
+    if (begin + extra > aligned) {
+        munmap(aligned + length, begin + extra - aligned);
+    }
+    mapping_ = aligned;
+    mapping_size_ = length;
+    data_ = aligned;
+#ifdef MADV_HUGEPAGE
+    if (advise_huge && madvise(aligned, length, MADV_HUGEPAGE) == 0) {
+        page_type_ = FramePageType::TRANSPARENT_HUGE;
+    }
+#endif
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+
+#include "common/config.h"
+
+/**
+ * @description: 缓冲池帧数据区使用的内存类型
+ */
+enum class FramePageType {
+    NORMAL,             // 普通4KB页面
+    TRANSPARENT_HUGE,   // 透明大页，由内核在后台合并为2MB页面(madvise(MADV_HUGEPAGE))
+    EXPLICIT_HUGE,      // 预留的大页(MAP_HUGETLB)
+    SHARED              // POSIX共享内存段中的一段(MAP_SHARED)，进程退出后内容仍保留
+};
+
+/**
+ * @description: 缓冲池所有帧的数据区，一块用mmap分配的连续内存，起始地址满足O_DIRECT的对齐要求。
+ *               缓冲池达到几百MB时，随机访问帧的TLB缺失很明显，因此优先使用大页：
+ *               先尝试MAP_HUGETLB(需要系统预留了足够的大页)，失败时改用普通映射并按大页边界对齐后
+ *               madvise(MADV_HUGEPAGE)请求透明大页，内核不支持时就是普通页面
+ */
+class FrameArena {
+   public:
+    /**
+     * @param {size_t} size 数据区的字节数
+     * @param {bool} use_huge_pages 是否尝试使用大页，为false时只使用普通页面
+     */
+    explicit FrameArena(size_t size, bool use_huge_pages = ENABLE_HUGE_PAGES);
+
+    /**
+     * @param {size_t} size 数据区的字节数
+     * @param {int} shm_fd 共享内存段的文件描述符，映射期间需保持打开
+     * @param {size_t} offset 数据区在共享内存段中的偏移，按HUGE_PAGE_SIZE对齐
+     */
+    FrameArena(size_t size, int shm_fd, size_t offset);
+
+    ~FrameArena();
+
+    FrameArena(const FrameArena &) = delete;
+    FrameArena &operator=(const FrameArena &) = delete;
+
+    char *data() const { return data_; }
+
+    size_t size() const { return size_; }
+
+    /**
+     * @description: 获得数据区实际使用的内存类型
+     */
+    FramePageType get_page_type() const { return page_type_; }
+
+    void release(char *addr, size_t length);
+
+   private:
+    bool map_explicit_huge();
+
+    void map_normal(bool advise_huge);
+
+    char *data_ = nullptr;         // 数据区的起始地址
+    size_t size_;                  // 数据区的字节数
+    char *mapping_ = nullptr;      // mmap得到的映射的起始地址
+    size_t mapping_size_ = 0;      // 映射的字节数
+    FramePageType page_type_ = FramePageType::NORMAL;
+};
@@ -0,0 +1,252 @@
+#include "storage/io_queue.h"
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+#include "errors.h"
+
+/**
+ * @description: 创建一个深度为depth的io_uring，创建失败(内核不支持、被seccomp禁止等)或内核的io_uring不支持读写操作时进入同步模式
+ * @param {unsigned} depth 队列深度，即同时在途的最大请求数，为0时直接使用同步模式
+ */
+IoQueue::IoQueue(unsigned depth) {
+    if (depth == 0) {
+        return;
+    }
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    int ring_fd = static_cast<int>(syscall(__NR_io_uring_setup, depth, &params));
+    if (ring_fd < 0) {
+        return;
+    }
+    if (!supports_read_write(ring_fd)) {
+        close(ring_fd);
+        return;
+    }
+
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (single_mmap) {
+        sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+    }
+    sq_ring_ = mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd,
+                    IORING_OFF_SQ_RING);
+    if (sq_ring_ == MAP_FAILED) {
+        sq_ring_ = nullptr;
+        close(ring_fd);
+        return;
+    }
+    if (single_mmap) {
+        cq_ring_ = sq_ring_;
+    } else {
+        cq_ring_ = mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd,
+                        IORING_OFF_CQ_RING);
+        if (cq_ring_ == MAP_FAILED) {
+            cq_ring_ = nullptr;
+            munmap(sq_ring_, sq_ring_size_);
+            sq_ring_ = nullptr;
+            close(ring_fd);
+            return;
+        }
+    }
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    void *sqes = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd,
+                      IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        if (cq_ring_ != sq_ring_) munmap(cq_ring_, cq_ring_size_);
+        munmap(sq_ring_, sq_ring_size_);
+        sq_ring_ = cq_ring_ = nullptr;
+        close(ring_fd);
+        return;
+    }
+    sqes_ = static_cast<io_uring_sqe *>(sqes);
+
+    char *sq = static_cast<char *>(sq_ring_);
+    sq_head_ = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+    sq_tail_ = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    sq_mask_ = reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    char *cq = static_cast<char *>(cq_ring_);
+    cq_head_ = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    cq_mask_ = reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+
+    sq_entries_ = params.sq_entries;
+    ring_fd_ = ring_fd;
+}
+
+/**
+ * @description: 检查内核的io_uring是否支持IORING_OP_READ/IORING_OP_WRITE。5.1~5.5的内核可以创建io_uring，
+ *               但不支持这两种操作，所有请求都以-EINVAL完成；这些内核也不支持IORING_REGISTER_PROBE，探测失败时同样视为不支持
+ * @return {bool} 两种操作都支持时返回true
+ * @param {int} ring_fd io_uring_setup返回的描述符
+ */
+bool IoQueue::supports_read_write(int ring_fd) {
+    constexpr unsigned num_ops = 256;
+    std::vector<char> buf(sizeof(io_uring_probe) + num_ops * sizeof(io_uring_probe_op), 0);
+    io_uring_probe *probe = reinterpret_cast<io_uring_probe *>(buf.data());
+    if (syscall(__NR_io_uring_register, ring_fd, IORING_REGISTER_PROBE, probe, num_ops) < 0) {
+        return false;
+    }
+    auto supported = [probe](unsigned op) {
+        return op <= probe->last_op && (probe->ops[op].flags & IO_URING_OP_SUPPORTED);
+    };
+    return supported(IORING_OP_READ) && supported(IORING_OP_WRITE);
+}
+
+IoQueue::~IoQueue() {
+    if (!is_async()) {
+        return;
+    }
+    // 等待所有在途请求完成，避免内核在缓冲区释放之后继续写入
+    try {
+        while (inflight_ > 0 || to_submit_ > 0) {
+            enter(inflight_ > 0 ? 1 : 0);
+            reap();
+        }
+    } catch (UnixError &) {
+    }
+    munmap(sqes_, sqes_size_);
+    if (cq_ring_ != sq_ring_) munmap(cq_ring_, cq_ring_size_);
+    munmap(sq_ring_, sq_ring_size_);
+    close(ring_fd_);
+}
+
+/**
+ * @description: 暂存一个读请求，把文件fd中从offset开始的len个字节读到buf中
+ * @note 在收到该请求的完成结果之前，buf必须保持有效
+ */
+void IoQueue::prep_read(int fd, char *buf, unsigned len, off_t offset, uint64_t user_data) {
+    if (!is_async()) {
+        ssize_t bytes_read = pread(fd, buf, len, offset);
+        ready_.push_back({user_data, bytes_read < 0 ? -errno : static_cast<int>(bytes_read)});
+        return;
+    }
+    io_uring_sqe *sqe = get_sqe();
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = fd;
+    sqe->off = offset;
+    sqe->addr = reinterpret_cast<uint64_t>(buf);
+    sqe->len = len;
+    sqe->user_data = user_data;
+}
+
+/**
+ * @description: 暂存一个写请求，把buf中的len个字节写入文件fd中offset开始的位置
+ * @note 在收到该请求的完成结果之前，buf必须保持有效且不能被修改
+ */
+void IoQueue::prep_write(int fd, const char *buf, unsigned len, off_t offset, uint64_t user_data) {
+    if (!is_async()) {
+        ssize_t bytes_written = pwrite(fd, buf, len, offset);
+        ready_.push_back({user_data, bytes_written < 0 ? -errno : static_cast<int>(bytes_written)});
+        return;
+    }
+    io_uring_sqe *sqe = get_sqe();
+    sqe->opcode = IORING_OP_WRITE;
+    sqe->fd = fd;
+    sqe->off = offset;
+    sqe->addr = reinterpret_cast<uint64_t>(buf);
+    sqe->len = len;
+    sqe->user_data = user_data;
+}
+
+/**
+ * @description: 将暂存的请求一次性提交给内核，不等待完成
+ */
+void IoQueue::submit() {
+    if (is_async() && to_submit_ > 0) {
+        enter(0);
+    }
+}
+
+/**
+ * @description: 提交暂存的请求，并收割已完成请求的结果
+ * @return {int} 本次追加到completions中的结果个数
+ * @param {vector<IoCompletion>*} completions 完成结果追加到其末尾
+ * @param {int} min_complete 至少等待min_complete个结果(不超过在途请求数)，为0时不阻塞
+ */
+int IoQueue::poll(std::vector<IoCompletion> *completions, int min_complete) {
+    if (is_async()) {
+        reap();
+        size_t want = std::min(static_cast<size_t>(std::max(min_complete, 0)), inflight());
+        if (to_submit_ > 0 || ready_.size() < want) {
+            enter(static_cast<unsigned>(want > ready_.size() ? want - ready_.size() : 0));
+            reap();
+        }
+        while (ready_.size() < want) {
+            enter(1);
+            reap();
+        }
+    }
+    int count = static_cast<int>(ready_.size());
+    completions->insert(completions->end(), ready_.begin(), ready_.end());
+    ready_.clear();
+    return count;
+}
+
+/**
+ * @description: 获取一个空闲的SQE；在途请求达到队列深度时，先等待部分请求完成
+ */
+io_uring_sqe *IoQueue::get_sqe() {
+    while (inflight_ >= sq_entries_) {
+        enter(1);
+        reap();
+    }
+    unsigned tail = *sq_tail_;
+    unsigned index = tail & *sq_mask_;
+    io_uring_sqe *sqe = &sqes_[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sq_array_[index] = index;
+    __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+    to_submit_++;
+    inflight_++;
+    return sqe;
+}
+
+/**
+ * @description: 调用io_uring_enter提交所有暂存的请求，并等待至少min_complete个请求完成
+ */
+void IoQueue::enter(unsigned min_complete) {
+    unsigned flags = min_complete > 0 ? IORING_ENTER_GETEVENTS : 0;
+    while (true) {
+        int ret = static_cast<int>(syscall(__NR_io_uring_enter, ring_fd_, to_submit_, min_complete, flags, nullptr, 0));
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EBUSY) {
+                reap();
+                continue;
+            }
+            throw UnixError();
+        }
+        to_submit_ -= std::min(static_cast<unsigned>(ret), to_submit_);
+        if (to_submit_ == 0) {
+            return;
+        }
+    }
+}
+
+/**
+ * @description: 从完成队列(CQ)中取出所有已完成请求的结果，放入ready_
+ */
+void IoQueue::reap() {
+    unsigned head = *cq_head_;
+    unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    while (head != tail) {
+        io_uring_cqe *cqe = &cqes_[head & *cq_mask_];
+        ready_.push_back({cqe->user_data, cqe->res});
+        head++;
+        inflight_--;
+    }
+    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <sys/types.h>
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+/**
+ * @description: 一个异步I/O请求的完成结果
+ */
+struct IoCompletion {
+    uint64_t user_data;  // 提交请求时由调用者传入的标识
+    int result;          // 成功时为实际读写的字节数，失败时为-errno
+};
+
+/**
+ * @description: 基于io_uring的异步I/O队列，直接使用io_uring_setup/io_uring_enter系统调用，不依赖liburing。
+ * 提交的请求先暂存在提交队列(SQ)中，在submit()或poll()时一次io_uring_enter批量提交。
+ * 内核不支持io_uring、不支持其中的读写操作(或depth为0)时退化为同步模式：请求在prep_*中直接用pread/pwrite完成，结果在poll()时返回。
+ * 注意：IoQueue不是线程安全的，每个线程应当使用自己的IoQueue。
+ */
+class IoQueue {
+   public:
+    explicit IoQueue(unsigned depth);
+
+    ~IoQueue();
+
+    IoQueue(const IoQueue &) = delete;
+    IoQueue &operator=(const IoQueue &) = delete;
+
+    bool is_async() const { return ring_fd_ >= 0; }
+
+    void prep_read(int fd, char *buf, unsigned len, off_t offset, uint64_t user_data);
+
+    void prep_write(int fd, const char *buf, unsigned len, off_t offset, uint64_t user_data);
+
+    void submit();
+
+    /** @description: 登记一个在队列之外(同步)完成的请求，其结果与其他请求一样由poll()返回 */
+    void complete(uint64_t user_data, int result) { ready_.push_back({user_data, result}); }
+
+    int poll(std::vector<IoCompletion> *completions, int min_complete);
+
+    /** @return 已提交(或暂存)但还没有被poll()取走结果的请求个数 */
+    size_t inflight() const { return inflight_ + ready_.size(); }
+
+   private:
+    static bool supports_read_write(int ring_fd);
+
+    io_uring_sqe *get_sqe();
+
+    void enter(unsigned min_complete);
+
+    void reap();
+
+    int ring_fd_ = -1;
+    unsigned sq_entries_ = 0;
+
+    // SQ ring
+    void *sq_ring_ = nullptr;
+    size_t sq_ring_size_ = 0;
+    unsigned *sq_head_ = nullptr;
+    unsigned *sq_tail_ = nullptr;
+    unsigned *sq_mask_ = nullptr;
+    unsigned *sq_array_ = nullptr;
+    io_uring_sqe *sqes_ = nullptr;
+    size_t sqes_size_ = 0;
+
+    // CQ ring
+    void *cq_ring_ = nullptr;
+    size_t cq_ring_size_ = 0;
+    unsigned *cq_head_ = nullptr;
+    unsigned *cq_tail_ = nullptr;
+    unsigned *cq_mask_ = nullptr;
+    io_uring_cqe *cqes_ = nullptr;
+
+    unsigned to_submit_ = 0;           // 已放入SQ但还没有通过io_uring_enter提交的请求数
+    size_t inflight_ = 0;              // 已放入SQ且还没有收割完成结果的请求数
+    std::deque<IoCompletion> ready_;   // 已完成、等待poll()返回给调用者的结果
+};
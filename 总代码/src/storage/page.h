@@ -1,5 +1,9 @@
 #pragma once
 
+#include <atomic>
+#include <cstring>
+#include <shared_mutex>
+
 #include "common/config.h"
 
 /**
@@ -11,7 +15,7 @@ struct PageId {
 
     friend bool operator==(const PageId &x, const PageId &y) { return x.fd == y.fd && x.page_no == y.page_no; }
     bool operator<(const PageId& x) const {
-        if(fd < x.fd) return true;
+        if (fd != x.fd) return fd < x.fd;
         return page_no < x.page_no;
     }
 
@@ -19,14 +23,22 @@ struct PageId {
         return "{fd: " + std::to_string(fd) + " page_no: " + std::to_string(page_no) + "}"; 
     }
 
+    // fd和page_no各占32位，不同页面的值互不相同
     inline int64_t Get() const {
-        return (static_cast<int64_t>(fd << 16) | page_no);
+        return static_cast<int64_t>((static_cast<uint64_t>(static_cast<uint32_t>(fd)) << 32) |
+                                    static_cast<uint32_t>(page_no));
     }
 };
 
-// PageId的自定义哈希算法, 用于构建unordered_map<PageId, frame_id_t, PageIdHash>
+// PageId的自定义哈希算法, 用于构建unordered_map<PageId, frame_id_t, PageIdHash>和PageTable。
+// 对(fd, page_no)做64位混合(splitmix64的终结函数)，高位和低位都充分依赖fd和page_no，可以直接取低位作为开放寻址的下标
 struct PageIdHash {
-    size_t operator()(const PageId &x) const { return (x.fd << 16) | x.page_no; }
+    size_t operator()(const PageId &x) const {
+        uint64_t key = static_cast<uint64_t>(x.Get());
+        key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        key = (key ^ (key >> 27)) * 0x94D049BB133111EBULL;
+        return static_cast<size_t>(key ^ (key >> 31));
+    }
 };
 
 template <>
@@ -40,10 +52,13 @@ struct std::hash<PageId> {
  */
 class Page {
     friend class BufferPoolManager;
+    friend class ReadPageGuard;
+    friend class WritePageGuard;
+    friend class OptimisticPageGuard;
 
    public:
     
-    Page() { reset_memory(); }
+    Page() = default;
 
     ~Page() = default;
 
@@ -62,19 +77,68 @@ class Page {
     inline void set_page_lsn(lsn_t page_lsn) { memcpy(get_data() + OFFSET_LSN, &page_lsn, sizeof(lsn_t)); }
 
    private:
+    /** 页面的读写锁，由ReadPageGuard和WritePageGuard获取和释放。只能在页面被固定时持有，
+     *  持有期间不会被淘汰；与分片的latch不同，持有它时可以调用BufferPoolManager */
+    void rlatch() { latch_.lock_shared(); }
+
+    void runlatch() { latch_.unlock_shared(); }
+
+    /** 获取独占锁后版本号变为奇数，释放前再加一变回偶数，乐观读据此发现读取期间页面被修改过 */
+    void wlatch() {
+        latch_.lock();
+        version_.store(version_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    void wunlatch() {
+        version_.store(version_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        latch_.unlock();
+    }
+
+    /** 开始一次乐观读：等待正在进行的写完成，返回此时的版本号 */
+    uint64_t begin_optimistic_read() {
+        uint64_t version = version_.load(std::memory_order_acquire);
+        while (version & 1) {
+            rlatch();
+            runlatch();
+            version = version_.load(std::memory_order_acquire);
+        }
+        return version;
+    }
+
+    /** 乐观读结束后检查版本号是否仍为开始时的值，不是则说明读取期间有写者修改了页面 */
+    bool validate_optimistic_read(uint64_t version) const {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return version_.load(std::memory_order_relaxed) == version;
+    }
+
     void reset_memory() { memset(data_, OFFSET_PAGE_START, PAGE_SIZE); }  // 将data_的PAGE_SIZE个字节填充为0
 
     /** page的唯一标识符 */
     PageId id_;
 
     /** The actual data that is stored within a page.
-     *  该页面在bufferPool中的偏移地址
+     *  指向该页面在bufferPool数据区中的帧，帧按DIRECT_IO_ALIGNMENT对齐，由BufferPoolManager分配和释放
      */
-    char data_[PAGE_SIZE] = {};
+    char *data_ = nullptr;
 
     /** 脏页判断 */
     bool is_dirty_ = false;
 
     /** The pin count of this page. */
     int pin_count_ = 0;
+
+    /** 页面正在被写回磁盘。写回期间BufferPoolManager不持有分片的latch，页面内容不能被修改，
+     *  访问该页面或要重新使用该帧的线程等待写回完成 */
+    bool io_in_progress_ = false;
+
+    /** 页面内容的读写锁：多个读者可以同时读取页面，写者独占页面 */
+    std::shared_mutex latch_;
+
+    /** 页面内容的版本号，写者持有独占锁期间为奇数，每次写完成后比开始前大2；页面离开帧时也加2 */
+    std::atomic<uint64_t> version_{0};
+
+    /** 指向该页面的swizzle引用(SwipTable中的一项)，为nullptr表示页面没有被swizzle。
+     *  由BufferPoolManager在分片的latch保护下设置，页面冷却或离开帧时清空该引用 */
+    std::atomic<Page *> *swip_ = nullptr;
 };
\ No newline at end of file
@@ -0,0 +1,170 @@
+#include "storage/page_codec.h"
+
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+inline uint32_t read32(const char *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline uint32_t hash32(uint32_t v) { return (v * 2654435761u) >> (32 - PageCodec::HASH_LOG); }
+
+/**
+ * @description: 写入长度的扩展部分：len已经减去了token中能表示的15，之后每个字节表示0~255，最后一个字节小于255
+ * @return {bool} 输出空间不足时返回false
+ */
+inline bool write_length(char *&op, const char *op_end, int len) {
+    while (len >= 255) {
+        if (op >= op_end) return false;
+        *op++ = static_cast<char>(255);
+        len -= 255;
+    }
+    if (op >= op_end) return false;
+    *op++ = static_cast<char>(len);
+    return true;
+}
+
+/**
+ * @description: 读取长度的扩展部分，累加到len上
+ * @return {bool} 输入提前结束时返回false
+ */
+inline bool read_length(const unsigned char *&ip, const unsigned char *ip_end, int &len) {
+    unsigned char b;
+    do {
+        if (ip >= ip_end) return false;
+        b = *ip++;
+        len += b;
+    } while (b == 255);
+    return true;
+}
+
+/**
+ * @description: 输出一个序列：字面量[literal, literal+literal_len)，之后是一个匹配(match_len为0时表示最后一个序列)
+ */
+inline bool write_sequence(char *&op, const char *op_end, const char *literal, int literal_len, int offset,
+                           int match_len) {
+    if (op >= op_end) return false;
+    char *token = op++;
+    int lit_code = literal_len < 15 ? literal_len : 15;
+    int match_code = 0;
+    if (lit_code == 15 && !write_length(op, op_end, literal_len - 15)) return false;
+    if (op_end - op < literal_len) return false;
+    memcpy(op, literal, literal_len);
+    op += literal_len;
+    if (match_len > 0) {
+        int code = match_len - PageCodec::MIN_MATCH;
+        match_code = code < 15 ? code : 15;
+        if (op_end - op < 2) return false;
+        *op++ = static_cast<char>(offset & 0xff);
+        *op++ = static_cast<char>(offset >> 8);
+        if (match_code == 15 && !write_length(op, op_end, code - 15)) return false;
+    }
+    *token = static_cast<char>((lit_code << 4) | match_code);
+    return true;
+}
+
+}  // namespace
+
+/**
+ * @description: 压缩src中的src_len字节数据
+ * @return {int} 压缩后的长度，如果压缩结果超过dst_capacity则返回-1(调用者应当按原样存储数据)
+ * @param {char*} src 待压缩数据
+ * @param {int} src_len 待压缩数据长度
+ * @param {char*} dst 压缩结果的输出缓冲区
+ * @param {int} dst_capacity 输出缓冲区的大小
+ */
+int PageCodec::compress(const char *src, int src_len, char *dst, int dst_capacity) {
+    int32_t table[1 << HASH_LOG];
+    memset(table, -1, sizeof(table));
+
+    char *op = dst;
+    const char *op_end = dst + dst_capacity;
+    int anchor = 0;  // 尚未输出的字面量起点
+    int ip = 0;
+    while (ip + MIN_MATCH <= src_len) {
+        uint32_t v = read32(src + ip);
+        uint32_t h = hash32(v);
+        int ref = table[h];
+        table[h] = ip;
+        if (ref < 0 || ip - ref > MAX_OFFSET || read32(src + ref) != v) {
+            // 连续未匹配时逐渐加大步长，快速跳过不可压缩的数据
+            ip += 1 + ((ip - anchor) >> 6);
+            continue;
+        }
+        int match_len = MIN_MATCH;
+        while (ip + match_len < src_len && src[ref + match_len] == src[ip + match_len]) {
+            match_len++;
+        }
+        if (!write_sequence(op, op_end, src + anchor, ip - anchor, ip - ref, match_len)) {
+            return -1;
+        }
+        // 把匹配区间内的部分位置也放入哈希表，提高后续匹配的命中率
+        int match_end = ip + match_len;
+        for (int pos = ip + 1; pos + MIN_MATCH <= src_len && pos < match_end; pos += 2) {
+            table[hash32(read32(src + pos))] = pos;
+        }
+        ip = match_end;
+        anchor = ip;
+    }
+    if (!write_sequence(op, op_end, src + anchor, src_len - anchor, 0, 0)) {
+        return -1;
+    }
+    return static_cast<int>(op - dst);
+}
+
+/**
+ * @description: 解压缩由compress()生成的数据，会检查输入是否越界，不会写出dst之外
+ * @return {int} 解压后的长度，数据损坏或解压结果不等于dst_len时返回-1
+ * @param {char*} src 压缩数据
+ * @param {int} src_len 压缩数据长度
+ * @param {char*} dst 解压结果的输出缓冲区
+ * @param {int} dst_len 期望的解压结果长度
+ */
+int PageCodec::decompress(const char *src, int src_len, char *dst, int dst_len) {
+    const unsigned char *ip = reinterpret_cast<const unsigned char *>(src);
+    const unsigned char *ip_end = ip + src_len;
+    char *op = dst;
+    char *op_end = dst + dst_len;
+    while (ip < ip_end) {
+        unsigned char token = *ip++;
+        int literal_len = token >> 4;
+        if (literal_len == 15 && !read_length(ip, ip_end, literal_len)) return -1;
+        if (ip_end - ip < literal_len || op_end - op < literal_len) return -1;
+        memcpy(op, ip, literal_len);
+        ip += literal_len;
+        op += literal_len;
+        if (ip == ip_end) {
+            break;  // 最后一个序列只有字面量
+        }
+        if (ip_end - ip < 2) return -1;
+        int offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        int match_len = token & 0x0f;
+        if (match_len == 15 && !read_length(ip, ip_end, match_len)) return -1;
+        match_len += MIN_MATCH;
+        if (offset == 0 || offset > op - dst || op_end - op < match_len) return -1;
+        // 匹配区间可能与输出重叠：偏移为1时是同一字节的重复(如填充的0)；偏移不小于8时按8字节分块复制不会读到未写出的数据
+        const char *match = op - offset;
+        if (offset == 1) {
+            memset(op, *match, match_len);
+        } else if (offset >= 8) {
+            int i = 0;
+            for (; i + 8 <= match_len; i += 8) {
+                memcpy(op + i, match + i, 8);
+            }
+            for (; i < match_len; i++) {
+                op[i] = match[i];
+            }
+        } else {
+            for (int i = 0; i < match_len; i++) {
+                op[i] = match[i];
+            }
+        }
+        op += match_len;
+    }
+    return op == op_end ? dst_len : -1;
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+/**
+ * @description: 自包含的LZ77族快速压缩算法，编码格式与LZ4的block格式相似：
+ * 每个序列由一个token字节、字面量长度扩展、字面量、2字节的匹配偏移和匹配长度扩展组成，
+ * token高4位为字面量长度，低4位为(匹配长度-MIN_MATCH)，取15时后续字节继续累加(每个字节最多255)。
+ * 最后一个序列只有字面量，没有匹配部分。
+ * 适合压缩定长记录槽位和索引键中的大量填充0，一个页面的编解码都在几微秒内完成。
+ */
+class PageCodec {
+   public:
+    static constexpr int MIN_MATCH = 4;          // 最短匹配长度
+    static constexpr int MAX_OFFSET = 65535;     // 匹配偏移用2字节表示
+    static constexpr int HASH_LOG = 12;          // 哈希表大小为2^HASH_LOG
+
+    static int compress(const char *src, int src_len, char *dst, int dst_capacity);
+
+    static int decompress(const char *src, int src_len, char *dst, int dst_len);
+
+    /** @return 压缩src_len字节数据时，输出在最坏情况下的长度 */
+    static constexpr int max_compressed_size(int src_len) { return src_len + src_len / 255 + 16; }
+};
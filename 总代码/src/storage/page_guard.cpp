@@ -0,0 +1,95 @@
+#include "page_guard.h"
+
+#include "buffer_pool_manager.h"
+
+ReadPageGuard::ReadPageGuard(ReadPageGuard &&other) noexcept : bpm_(other.bpm_), page_(other.page_) {
+    other.bpm_ = nullptr;
+    other.page_ = nullptr;
+}
+
+ReadPageGuard &ReadPageGuard::operator=(ReadPageGuard &&other) noexcept {
+    if (this != &other) {
+        drop();
+        bpm_ = other.bpm_;
+        page_ = other.page_;
+        other.bpm_ = nullptr;
+        other.page_ = nullptr;
+    }
+    return *this;
+}
+
+/**
+ * @description: 释放共享锁并取消固定页面，之后保护不再持有页面；不持有页面时什么也不做
+ */
+void ReadPageGuard::drop() {
+    if (page_ == nullptr) {
+        return;
+    }
+    PageId page_id = page_->get_page_id();
+    page_->runlatch();
+    bpm_->unpin_page(page_id, false);
+    bpm_ = nullptr;
+    page_ = nullptr;
+}
+
+WritePageGuard::WritePageGuard(WritePageGuard &&other) noexcept : bpm_(other.bpm_), page_(other.page_) {
+    other.bpm_ = nullptr;
+    other.page_ = nullptr;
+}
+
+WritePageGuard &WritePageGuard::operator=(WritePageGuard &&other) noexcept {
+    if (this != &other) {
+        drop();
+        bpm_ = other.bpm_;
+        page_ = other.page_;
+        other.bpm_ = nullptr;
+        other.page_ = nullptr;
+    }
+    return *this;
+}
+
+/**
+ * @description: 释放独占锁并以脏页取消固定页面，之后保护不再持有页面；不持有页面时什么也不做
+ */
+void WritePageGuard::drop() {
+    if (page_ == nullptr) {
+        return;
+    }
+    PageId page_id = page_->get_page_id();
+    page_->wunlatch();
+    bpm_->unpin_page(page_id, true);
+    bpm_ = nullptr;
+    page_ = nullptr;
+}
+
+OptimisticPageGuard::OptimisticPageGuard(OptimisticPageGuard &&other) noexcept
+    : bpm_(other.bpm_), page_(other.page_), version_(other.version_) {
+    other.bpm_ = nullptr;
+    other.page_ = nullptr;
+}
+
+OptimisticPageGuard &OptimisticPageGuard::operator=(OptimisticPageGuard &&other) noexcept {
+    if (this != &other) {
+        drop();
+        bpm_ = other.bpm_;
+        page_ = other.page_;
+        version_ = other.version_;
+        other.bpm_ = nullptr;
+        other.page_ = nullptr;
+    }
+    return *this;
+}
+
+/**
+ * @description: 取消固定页面，之后保护不再持有页面；不持有页面时什么也不做
+ */
+void OptimisticPageGuard::drop() {
+    if (page_ == nullptr) {
+        return;
+    }
+    if (bpm_ != nullptr) {
+        bpm_->unpin_page(page_->get_page_id(), false);
+    }
+    bpm_ = nullptr;
+    page_ = nullptr;
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <cassert>
+
+#include "page.h"
+
+class BufferPoolManager;
+
+/**
+ * @description: 页面的读保护，持有页面的固定(pin)和共享锁，析构或drop()时自动释放锁并取消固定。
+ *               只能移动不能复制，由BufferPoolManager::fetch_page_read()创建
+ */
+class ReadPageGuard {
+   public:
+    ReadPageGuard() = default;
+
+    /**
+     * @param {BufferPoolManager*} bpm 页面所在的缓冲池
+     * @param {Page*} page 已被固定并已获取共享锁的页面
+     */
+    ReadPageGuard(BufferPoolManager *bpm, Page *page) : bpm_(bpm), page_(page) {}
+
+    ReadPageGuard(const ReadPageGuard &) = delete;
+
+    ReadPageGuard &operator=(const ReadPageGuard &) = delete;
+
+    ReadPageGuard(ReadPageGuard &&other) noexcept;
+
+    ReadPageGuard &operator=(ReadPageGuard &&other) noexcept;
+
+    ~ReadPageGuard() { drop(); }
+
+    void drop();
+
+    /**
+     * @description: 是否持有页面，缓冲池没有可用的帧时fetch_page_read()返回不持有页面的保护
+     */
+    bool is_valid() const { return page_ != nullptr; }
+
+    PageId get_page_id() const { return page_->get_page_id(); }
+
+    const char *get_data() const { return page_->get_data(); }
+
+    /**
+     * @description: 被保护的页面，供按页面布局解析数据的句柄(如RmPageHandle)使用，只能读取
+     */
+    Page *get_page() const { return page_; }
+
+   private:
+    BufferPoolManager *bpm_ = nullptr;
+    Page *page_ = nullptr;
+};
+
+/**
+ * @description: 页面的写保护，持有页面的固定(pin)和独占锁，析构或drop()时自动释放锁并以脏页取消固定。
+ *               只能移动不能复制，由BufferPoolManager::fetch_page_write()和new_page_guarded()创建
+ */
+class WritePageGuard {
+   public:
+    WritePageGuard() = default;
+
+    /**
+     * @param {BufferPoolManager*} bpm 页面所在的缓冲池
+     * @param {Page*} page 已被固定并已获取独占锁的页面
+     */
+    WritePageGuard(BufferPoolManager *bpm, Page *page) : bpm_(bpm), page_(page) {}
+
+    WritePageGuard(const WritePageGuard &) = delete;
+
+    WritePageGuard &operator=(const WritePageGuard &) = delete;
+
+    WritePageGuard(WritePageGuard &&other) noexcept;
+
+    WritePageGuard &operator=(WritePageGuard &&other) noexcept;
+
+    ~WritePageGuard() { drop(); }
+
+    void drop();
+
+    bool is_valid() const { return page_ != nullptr; }
+
+    PageId get_page_id() const { return page_->get_page_id(); }
+
+    const char *get_data() const { return page_->get_data(); }
+
+    char *get_data_mut() { return page_->get_data(); }
+
+    Page *get_page() const { return page_; }
+
+   private:
+    BufferPoolManager *bpm_ = nullptr;
+    Page *page_ = nullptr;
+};
+
+/**
+ * @description: 页面的乐观读保护，只持有页面的固定(pin)，不加页面锁：读取前记下页面的版本号，
+ *               读取后用validate()检查版本号没有变化，变化说明读取期间有写者修改了页面，需要begin_read()后重新读取。
+ *               读取的数据在验证通过之前不能被使用(例如作为页号访问其他页面)。
+ *               适合被频繁读取、很少修改的页面，如B+树的内部结点，避免所有读者都修改同一个锁所在的缓存行。
+ *               通过swizzle引用得到的保护连页面也不固定，页面离开帧时版本号变化，验证失败后需要重新获取页面，不能begin_read()。
+ *               只能移动不能复制，由BufferPoolManager::fetch_page_optimistic()和fetch_page_swizzled()创建
+ */
+class OptimisticPageGuard {
+   public:
+    OptimisticPageGuard() = default;
+
+    /**
+     * @param {BufferPoolManager*} bpm 页面所在的缓冲池
+     * @param {Page*} page 已被固定的页面
+     */
+    OptimisticPageGuard(BufferPoolManager *bpm, Page *page)
+        : bpm_(bpm), page_(page), version_(page->begin_optimistic_read()) {}
+
+    /**
+     * @param {Page*} page 通过swizzle引用找到的页面，不固定
+     * @param {uint64_t} version 确认引用仍指向该页面之前取得的版本号
+     */
+    OptimisticPageGuard(Page *page, uint64_t version) : page_(page), version_(version) {}
+
+    OptimisticPageGuard(const OptimisticPageGuard &) = delete;
+
+    OptimisticPageGuard &operator=(const OptimisticPageGuard &) = delete;
+
+    OptimisticPageGuard(OptimisticPageGuard &&other) noexcept;
+
+    OptimisticPageGuard &operator=(OptimisticPageGuard &&other) noexcept;
+
+    ~OptimisticPageGuard() { drop(); }
+
+    void drop();
+
+    bool is_valid() const { return page_ != nullptr; }
+
+    /**
+     * @description: 是否固定了页面，通过swizzle引用得到的保护不固定页面
+     */
+    bool is_pinned() const { return bpm_ != nullptr; }
+
+    /**
+     * @description: 重新开始一次乐观读，等待正在进行的写完成并记下新的版本号。只能用于固定了页面的保护
+     */
+    void begin_read() {
+        assert(is_pinned());
+        version_ = page_->begin_optimistic_read();
+    }
+
+    /**
+     * @description: 自begin_read()(或创建保护)以来页面是否没有被修改过，为true时期间读到的数据是一致的
+     */
+    bool validate() const { return page_->validate_optimistic_read(version_); }
+
+    PageId get_page_id() const { return page_->get_page_id(); }
+
+    const char *get_data() const { return page_->get_data(); }
+
+    Page *get_page() const { return page_; }
+
+   private:
+    BufferPoolManager *bpm_ = nullptr;
+    Page *page_ = nullptr;
+    uint64_t version_ = 0;
+};
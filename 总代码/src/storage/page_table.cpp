@@ -0,0 +1,117 @@
+#include "page_table.h"
+
+#include <thread>
+
+#include "errors.h"
+
+PageTable::PageTable(size_t max_entries) {
+    size_t capacity = 16;
+    while (capacity < 2 * max_entries) {
+        capacity *= 2;
+    }
+    slots_ = std::make_unique<Slot[]>(capacity);
+    mask_ = capacity - 1;
+}
+
+/**
+ * @description: 查找页面所在的帧，不加锁。与修改同时进行时，返回查找期间某一时刻的结果
+ * @return {frame_id_t} 页面所在的帧，页面不在表中时返回INVALID_FRAME_ID
+ * @param {PageId} page_id 目标页面
+ */
+frame_id_t PageTable::find(PageId page_id) const {
+    uint64_t key = make_key(page_id);
+    while (true) {
+        uint64_t version = version_.load(std::memory_order_acquire);
+        if (version & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+        frame_id_t frame_id = INVALID_FRAME_ID;
+        size_t pos = home(key);
+        for (size_t probes = 0; probes <= mask_; probes++, pos = (pos + 1) & mask_) {
+            uint64_t slot_key = slots_[pos].key.load(std::memory_order_acquire);
+            if (slot_key == key) {
+                frame_id = slots_[pos].frame_id.load(std::memory_order_relaxed);
+                break;
+            }
+            if (slot_key == EMPTY_KEY) {
+                break;
+            }
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (version_.load(std::memory_order_relaxed) == version) {
+            return frame_id;
+        }
+    }
+}
+
+/**
+ * @description: 查找key所在的位置，只由修改者调用
+ * @return {size_t} key所在的位置，不在表中时返回探测到的第一个空位置
+ */
+size_t PageTable::find_slot(uint64_t key) const {
+    size_t pos = home(key);
+    while (true) {
+        uint64_t slot_key = slots_[pos].key.load(std::memory_order_relaxed);
+        if (slot_key == key || slot_key == EMPTY_KEY) {
+            return pos;
+        }
+        pos = (pos + 1) & mask_;
+    }
+}
+
+/**
+ * @description: 插入或更新页面所在的帧，调用者需持有修改用的锁
+ * @param {PageId} page_id 目标页面
+ * @param {frame_id_t} frame_id 页面所在的帧
+ */
+void PageTable::insert(PageId page_id, frame_id_t frame_id) {
+    uint64_t key = make_key(page_id);
+    Slot &slot = slots_[find_slot(key)];
+    if (slot.key.load(std::memory_order_relaxed) == key) {
+        slot.frame_id.store(frame_id, std::memory_order_release);
+        return;
+    }
+    if (num_entries_ + 1 > mask_ / 2 + 1) {
+        throw InternalError("PageTable::insert: page table is full");
+    }
+    slot.frame_id.store(frame_id, std::memory_order_relaxed);
+    slot.key.store(key, std::memory_order_release);
+    num_entries_++;
+}
+
+/**
+ * @description: 删除页面，调用者需持有修改用的锁。之后的条目中起始探测位置不在(空位, 当前位置]之间的，
+ *               向前移动到空位上，直到遇到空位置(Knuth算法R)
+ * @return {bool} 页面在表中时返回true
+ * @param {PageId} page_id 目标页面
+ */
+bool PageTable::erase(PageId page_id) {
+    uint64_t key = make_key(page_id);
+    size_t hole = find_slot(key);
+    if (slots_[hole].key.load(std::memory_order_relaxed) != key) {
+        return false;
+    }
+    uint64_t version = version_.load(std::memory_order_relaxed);
+    version_.store(version + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t pos = (hole + 1) & mask_;; pos = (pos + 1) & mask_) {
+        uint64_t slot_key = slots_[pos].key.load(std::memory_order_relaxed);
+        if (slot_key == EMPTY_KEY) {
+            break;
+        }
+        size_t slot_home = home(slot_key);
+        bool stays = hole < pos ? (slot_home > hole && slot_home <= pos) : (slot_home > hole || slot_home <= pos);
+        if (stays) {
+            continue;
+        }
+        slots_[hole].frame_id.store(slots_[pos].frame_id.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        slots_[hole].key.store(slot_key, std::memory_order_release);
+        hole = pos;
+    }
+    slots_[hole].key.store(EMPTY_KEY, std::memory_order_release);
+    slots_[hole].frame_id.store(INVALID_FRAME_ID, std::memory_order_relaxed);
+    version_.store(version + 2, std::memory_order_release);
+    num_entries_--;
+    return true;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+#include "common/config.h"
+#include "storage/page.h"
+
+/**
+ * @description: 缓冲池的页表，PageId到帧编号的映射。固定容量(不少于最大条目数的两倍，取2的幂)的开放寻址哈希表，
+ *               线性探测，每个位置16字节，一条cache line放4个位置，查找时顺序访问相邻位置，没有结点分配和指针跳转。
+ *               查找不加锁；插入和删除由调用者加锁(缓冲池中为分片的latch)，同一时刻只有一个修改者。
+ *               删除时把后面的条目向前移动填补空位(不使用墓碑，探测长度不会随插入删除次数增长)，
+ *               移动期间整个表的版本号为奇数，与移动同时进行的查找在结束后发现版本号变化，重新查找
+ */
+class PageTable {
+   public:
+    /**
+     * @param {size_t} max_entries 表中同时存在的最多条目数，即缓冲池分片的帧个数
+     */
+    explicit PageTable(size_t max_entries);
+
+    PageTable(const PageTable &) = delete;
+
+    PageTable &operator=(const PageTable &) = delete;
+
+    frame_id_t find(PageId page_id) const;
+
+    bool contains(PageId page_id) const { return find(page_id) != INVALID_FRAME_ID; }
+
+    void insert(PageId page_id, frame_id_t frame_id);
+
+    bool erase(PageId page_id);
+
+    /**
+     * @description: 获得表中的条目数，调用者需持有修改用的锁
+     */
+    size_t size() const { return num_entries_; }
+
+    size_t capacity() const { return mask_ + 1; }
+
+   private:
+    static constexpr uint64_t EMPTY_KEY = ~0ULL;  // 空位置的key，fd和page_no都为-1，不是合法的页面
+
+    /**
+     * @description: 表中的一个位置。key在frame_id写好之后才写入，查找读到key后再读frame_id
+     */
+    struct Slot {
+        std::atomic<uint64_t> key{EMPTY_KEY};
+        std::atomic<frame_id_t> frame_id{INVALID_FRAME_ID};
+    };
+
+    static uint64_t make_key(PageId page_id) { return static_cast<uint64_t>(page_id.Get()); }
+
+    /**
+     * @description: key的起始探测位置
+     */
+    size_t home(uint64_t key) const {
+        PageId page_id{static_cast<int>(key >> 32), static_cast<page_id_t>(key & 0xFFFFFFFFULL)};
+        return PageIdHash()(page_id) & mask_;
+    }
+
+    size_t find_slot(uint64_t key) const;
+
+    std::unique_ptr<Slot[]> slots_;
+    size_t mask_;                          // 容量减一
+    size_t num_entries_ = 0;               // 条目数，只由修改者访问
+    std::atomic<uint64_t> version_{0};     // 删除移动条目期间为奇数
+};
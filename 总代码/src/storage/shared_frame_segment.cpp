@@ -0,0 +1,149 @@
+#include "storage/shared_frame_segment.h"
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <climits>
+#include <cstring>
+
+#include "errors.h"
+
+/**
+ * @description: 共享内存段的段头，其后紧跟文件表和帧描述
+ */
+struct SharedFrameSegment::Header {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t page_size;
+    uint64_t num_frames;
+    int32_t num_files;                          // 文件表中已登记的文件个数
+    char files[MAX_FILES][MAX_PATH_LEN];        // 文件表，按绝对路径登记
+};
+
+static constexpr uint64_t SEGMENT_MAGIC = 0x554E494241534542ULL;  // "UNIBASEB"
+static constexpr uint32_t SEGMENT_VERSION = 1;
+
+/**
+ * @description: 向上取整到align的倍数
+ */
+static size_t round_up(size_t size, size_t align) { return (size + align - 1) / align * align; }
+
+SharedFrameSegment::SharedFrameSegment(const std::string &name, size_t num_frames)
+    : name_(name), num_frames_(num_frames) {
+    meta_size_ = round_up(sizeof(Header) + num_frames_ * sizeof(FrameDesc), HUGE_PAGE_SIZE);
+    size_t total_size = meta_size_ + round_up(num_frames_ * PAGE_SIZE, HUGE_PAGE_SIZE);
+    fd_ = shm_open(name_.c_str(), O_RDWR | O_CREAT, 0600);
+    if (fd_ < 0) {
+        throw UnixError();
+    }
+    // 两个进程同时使用同一个段会互相破坏对方的帧
+    if (flock(fd_, LOCK_EX | LOCK_NB) < 0) {
+        close(fd_);
+        throw InternalError("SharedFrameSegment: " + name_ + " is in use by another process");
+    }
+    struct stat st;
+    if (fstat(fd_, &st) < 0) {
+        close(fd_);
+        throw UnixError();
+    }
+    bool existing = static_cast<size_t>(st.st_size) == total_size;
+    // 大小不匹配时截断为0再扩展，内容全部清零
+    if (!existing && (ftruncate(fd_, 0) < 0 || ftruncate(fd_, static_cast<off_t>(total_size)) < 0)) {
+        close(fd_);
+        throw UnixError();
+    }
+    void *addr = mmap(nullptr, meta_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (addr == MAP_FAILED) {
+        close(fd_);
+        throw UnixError();
+    }
+    meta_ = static_cast<char *>(addr);
+    header_ = reinterpret_cast<Header *>(meta_);
+    descs_ = reinterpret_cast<FrameDesc *>(meta_ + sizeof(Header));
+    reattached_ = existing && header_->magic == SEGMENT_MAGIC && header_->version == SEGMENT_VERSION &&
+                  header_->page_size == PAGE_SIZE && header_->num_frames == num_frames_ &&
+                  header_->num_files >= 0 && header_->num_files <= MAX_FILES;
+    if (!reattached_) {
+        memset(meta_, 0, meta_size_);
+        header_->magic = SEGMENT_MAGIC;
+        header_->version = SEGMENT_VERSION;
+        header_->page_size = PAGE_SIZE;
+        header_->num_frames = num_frames_;
+        header_->num_files = 0;
+        return;
+    }
+    for (int i = 0; i < header_->num_files; i++) {
+        header_->files[i][MAX_PATH_LEN - 1] = '\0';
+        files_.emplace(header_->files[i], i);
+    }
+}
+
+/**
+ * @description: 解除映射并关闭段(同时释放flock)，段本身保留，供下一个进程打开
+ */
+SharedFrameSegment::~SharedFrameSegment() {
+    if (meta_ != nullptr) {
+        munmap(meta_, meta_size_);
+    }
+    if (fd_ >= 0) {
+        close(fd_);
+    }
+}
+
+/**
+ * @description: 映射段中的帧数据区
+ * @return {unique_ptr<FrameArena>} 帧数据区，析构时解除映射
+ */
+std::unique_ptr<FrameArena> SharedFrameSegment::map_frames() {
+    return std::make_unique<FrameArena>(num_frames_ * PAGE_SIZE, fd_, meta_size_);
+}
+
+/**
+ * @description: 在文件表中登记文件，已登记过的文件返回原来的下标
+ * @return {int} 文件表下标，路径过长或文件表已满时返回-1
+ * @param {string&} path 文件路径，相对路径按当前工作目录转换为绝对路径
+ */
+int SharedFrameSegment::register_file(const std::string &path) {
+    std::string abs_path = path;
+    if (abs_path.empty() || abs_path[0] != '/') {
+        char cwd[PATH_MAX];
+        if (getcwd(cwd, sizeof(cwd)) == nullptr) {
+            return -1;
+        }
+        abs_path = std::string(cwd) + "/" + path;
+    }
+    std::lock_guard<std::mutex> lock(latch_);
+    auto it = files_.find(abs_path);
+    if (it != files_.end()) {
+        return it->second;
+    }
+    if (header_->num_files >= MAX_FILES || abs_path.size() >= MAX_PATH_LEN) {
+        return -1;
+    }
+    int file = header_->num_files;
+    strcpy(header_->files[file], abs_path.c_str());
+    header_->num_files = file + 1;
+    files_.emplace(abs_path, file);
+    return file;
+}
+
+/**
+ * @description: 获得文件表中登记的文件的绝对路径
+ * @return {string} 绝对路径，下标无效时返回空串
+ * @param {int} file 文件表下标
+ */
+std::string SharedFrameSegment::file_path(int file) const {
+    if (file < 0 || file >= header_->num_files) {
+        return std::string();
+    }
+    return header_->files[file];
+}
+
+/**
+ * @description: 删除共享内存段，已打开它的进程仍可以继续使用到关闭为止
+ * @param {string&} name 共享内存段的名称
+ */
+void SharedFrameSegment::destroy(const std::string &name) { shm_unlink(name.c_str()); }
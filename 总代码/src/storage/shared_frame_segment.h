@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "common/config.h"
+#include "storage/frame_arena.h"
+
+/**
+ * @description: 存放缓冲池帧的POSIX共享内存段，进程退出(包括崩溃)后仍由操作系统保留，重启的进程重新打开同名的段。
+ *               段的开头是段头、文件表和每个帧的描述，之后按大页对齐存放所有帧的数据。
+ *               页表、replacer和Page对象中的latch等都是进程内的结构，不放在段中：帧描述只记录帧中是哪个文件
+ *               (按绝对路径登记在文件表中，文件句柄在重启后会变化)的哪个页面，以及页面是否为脏、是否被固定，
+ *               重启后由BufferPoolManager据此把干净、未被固定的帧重新登记到页表中。
+ *               同一时刻只允许一个进程使用一个段，用flock保证
+ */
+class SharedFrameSegment {
+   public:
+    /**
+     * @description: 一个帧的描述，只由BufferPoolManager在帧所在分片的latch保护下修改
+     */
+    struct FrameDesc {
+        int32_t file;       // 帧中页面所在文件在文件表中的下标
+        page_id_t page_no;  // 帧中页面的页号
+        uint32_t flags;     // FRAME_VALID、FRAME_DIRTY、FRAME_PINNED的组合
+    };
+
+    static constexpr uint32_t FRAME_VALID = 1;   // 帧中存放着file的page_no页
+    static constexpr uint32_t FRAME_DIRTY = 2;   // 页面被修改过、还没有写回磁盘
+    static constexpr uint32_t FRAME_PINNED = 4;  // 页面被固定，内容可能正在被修改
+
+    static constexpr int MAX_FILES = 1024;      // 文件表的大小，文件表满后新文件的页面不再能被重启后的进程接管
+    static constexpr int MAX_PATH_LEN = 256;    // 文件表中路径的最大长度(含结尾的'\0')
+
+    /**
+     * @description: 打开名为name的共享内存段，段不存在或与num_frames、PAGE_SIZE不匹配时重新创建
+     * @param {string&} name 共享内存段的名称，以'/'开头
+     * @param {size_t} num_frames 帧个数
+     */
+    SharedFrameSegment(const std::string &name, size_t num_frames);
+
+    ~SharedFrameSegment();
+
+    SharedFrameSegment(const SharedFrameSegment &) = delete;
+    SharedFrameSegment &operator=(const SharedFrameSegment &) = delete;
+
+    /**
+     * @description: 是否打开了上一个进程留下的段，为false时段是新创建的，所有帧描述都无效
+     */
+    bool is_reattached() const { return reattached_; }
+
+    std::unique_ptr<FrameArena> map_frames();
+
+    FrameDesc &desc(size_t frame) { return descs_[frame]; }
+
+    int register_file(const std::string &path);
+
+    std::string file_path(int file) const;
+
+    static void destroy(const std::string &name);
+
+   private:
+    struct Header;
+
+    std::string name_;
+    int fd_ = -1;                   // 共享内存段的文件描述符，持有它的flock
+    size_t num_frames_;
+    char *meta_ = nullptr;          // 段头、文件表和帧描述的映射
+    size_t meta_size_;              // 以上部分的字节数，按HUGE_PAGE_SIZE对齐，帧数据从这里开始
+    Header *header_ = nullptr;
+    FrameDesc *descs_ = nullptr;
+    bool reattached_ = false;
+    std::mutex latch_;                                  // 保护文件表的登记
+    std::unordered_map<std::string, int> files_;        // 绝对路径 -> 文件表下标
+};
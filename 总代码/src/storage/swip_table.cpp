@@ -0,0 +1,58 @@
+#include "storage/swip_table.h"
+
+#include "storage/buffer_pool_manager.h"
+
+SwipTable::SwipTable(BufferPoolManager *bpm, int fd)
+    : bpm_(bpm), fd_(fd), chunks_(new std::atomic<std::atomic<Page *> *>[MAX_CHUNKS]) {
+    for (int i = 0; i < MAX_CHUNKS; i++) {
+        chunks_[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @description: 清空缓冲池中仍指向本表的引用(如仍被固定、没有随文件关闭移出缓冲池的页面)，再释放所有块
+ */
+SwipTable::~SwipTable() {
+    bpm_->unswizzle_file(fd_);
+    for (int i = 0; i < MAX_CHUNKS; i++) {
+        delete[] chunks_[i].load(std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @description: 获得页面的引用，所在的块还没有分配时分配它
+ * @return {atomic<Page*>*} 页面的引用，页号超出范围时返回nullptr
+ * @param {page_id_t} page_no 页号
+ */
+std::atomic<Page *> *SwipTable::slot(page_id_t page_no) const {
+    if (page_no < 0 || page_no >= CHUNK_PAGES * MAX_CHUNKS) {
+        return nullptr;
+    }
+    std::atomic<std::atomic<Page *> *> &chunk = chunks_[page_no / CHUNK_PAGES];
+    std::atomic<Page *> *swips = chunk.load(std::memory_order_acquire);
+    if (swips == nullptr) {
+        std::lock_guard<std::mutex> lock(latch_);
+        swips = chunk.load(std::memory_order_relaxed);
+        if (swips == nullptr) {
+            swips = new std::atomic<Page *>[CHUNK_PAGES];
+            for (int i = 0; i < CHUNK_PAGES; i++) {
+                swips[i].store(nullptr, std::memory_order_relaxed);
+            }
+            chunk.store(swips, std::memory_order_release);
+        }
+    }
+    return &swips[page_no % CHUNK_PAGES];
+}
+
+/**
+ * @description: 获得被swizzle的页面，不分配块
+ * @return {Page*} 存放该页面的帧，页面没有被swizzle时返回nullptr
+ * @param {page_id_t} page_no 页号
+ */
+Page *SwipTable::get(page_id_t page_no) const {
+    if (page_no < 0 || page_no >= CHUNK_PAGES * MAX_CHUNKS) {
+        return nullptr;
+    }
+    std::atomic<Page *> *swips = chunks_[page_no / CHUNK_PAGES].load(std::memory_order_acquire);
+    return swips == nullptr ? nullptr : swips[page_no % CHUNK_PAGES].load(std::memory_order_acquire);
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+#include "common/config.h"
+#include "storage/page.h"
+
+class BufferPoolManager;
+
+/**
+ * @description: 一个文件的swizzle引用表，页号到缓冲池中存放该页面的Page的直接映射。
+ *               B+树结点和表页面在磁盘上用页号互相引用，页面内容中不存放指针，写回前不需要unswizzle；
+ *               被swizzle的页面通过页号下标直接找到它所在的帧，不经过页表的哈希查找和分片的latch，也不固定页面。
+ *               引用按页号分块存放，块在第一次使用时分配，直到表析构才释放，因此查找不加锁。
+ *               引用只由BufferPoolManager修改：页面被访问时swizzle，被replacer选中时先冷却(清空引用、留在缓冲池中)，
+ *               离开帧(被淘汰、删除或文件被关闭)时清空引用
+ */
+class SwipTable {
+   public:
+    /**
+     * @param {BufferPoolManager*} bpm 页面所在的缓冲池
+     * @param {int} fd 文件句柄
+     */
+    SwipTable(BufferPoolManager *bpm, int fd);
+
+    SwipTable(const SwipTable &) = delete;
+
+    SwipTable &operator=(const SwipTable &) = delete;
+
+    ~SwipTable();
+
+    std::atomic<Page *> *slot(page_id_t page_no) const;
+
+    Page *get(page_id_t page_no) const;
+
+    static constexpr int CHUNK_PAGES = 1024;  // 每个块中的引用个数
+    static constexpr int MAX_CHUNKS = 4096;   // 块数，页号不小于CHUNK_PAGES*MAX_CHUNKS的页面不swizzle
+
+   private:
+    BufferPoolManager *bpm_;
+    int fd_;
+    std::unique_ptr<std::atomic<std::atomic<Page *> *>[]> chunks_;  // 已分配的块，未分配时为nullptr
+    mutable std::mutex latch_;                                      // 保护块的分配
+};
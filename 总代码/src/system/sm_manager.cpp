@@ -31,6 +31,7 @@ void SmManager::create_db(const std::string& db_name) {
     }
     db_.name_ = db_name;
     db_.tabs_.clear();
+    db_.pools_.clear();
     //为数据库创建一个子目录
     std::string cmd = "mkdir " + db_name;
     if (system(cmd.c_str()) < 0) {  // 创建一个名为db_name的目录
@@ -84,18 +85,31 @@ void SmManager::open_db(const std::string& db_name) {
     if (!ifs.is_open()) {
         throw UnixError();
     }
+    db_.tabs_.clear();
+    db_.pools_.clear();
     ifs >> db_;
     db_.name_ = db_name;
 
+    // 先创建具名缓冲池，表和索引的文件在各自的缓冲池中打开
+    for (auto &entry : db_.pools_) {
+        buffer_pools_.create_pool(entry.second.name, entry.second.size, entry.second.replacer);
+    }
     // open all table files
     for (auto &entry : db_.tabs_) {
         auto &tab_name = entry.first;
-        fhs_[tab_name] = rm_manager_->open_file(tab_name);
+        fhs_[tab_name] = rm_manager_->open_file(tab_name, buffer_pools_.get_pool(entry.second.buffer_pool));
         // open indexes on the table
         for (auto &index : entry.second.indexes) {
-            ihs_[ix_manager_->get_index_name(tab_name, index.cols)] = ix_manager_->open_index(tab_name, index.cols);
+            ihs_[ix_manager_->get_index_name(tab_name, index.cols)] =
+                ix_manager_->open_index(tab_name, index.cols, buffer_pools_.get_pool(index.buffer_pool));
         }
     }
+    // 按上次关闭(或最近一次定期转储)时缓冲池中的页面在后台预热，不阻塞客户端的访问
+    for (auto &pool_name : buffer_pools_.get_pool_names()) {
+        BufferPoolManager *bpm = buffer_pools_.get_pool(pool_name);
+        bpm->warm_up(BufferPoolSet::dump_file(pool_name));
+        bpm->start_periodic_dump(BufferPoolSet::dump_file(pool_name));
+    }
 }
 
 /**
@@ -108,13 +122,8 @@ void SmManager::flush_meta() {
         throw InternalError("cannot open DB.meta");
     }
 
-    // 只写最基本信息，先别用 operator<<
-    ofs << db_.name_ << std::endl;
-    ofs << db_.tabs_.size() << std::endl;
-
-    for (auto &[tab_name, tab] : db_.tabs_) {
-        ofs << tab_name << std::endl;
-    }
+    // 写入完整的元数据(包括字段、索引和缓冲池的分配)，与open_db中的operator>>对应
+    ofs << db_;
 
     ofs.close();
 }
@@ -123,6 +132,20 @@ void SmManager::flush_meta() {
  * @description: 关闭数据库并把数据落盘
  */
 void SmManager::close_db() {
+    // 关闭文件会把页面移出缓冲池，在此之前转储每个缓冲池的常驻页面，供下次打开时预热
+    std::vector<std::string> pool_names = buffer_pools_.get_pool_names();
+    for (auto &pool_name : pool_names) {
+        BufferPoolManager *bpm = buffer_pools_.get_pool(pool_name);
+        bpm->stop_periodic_dump();
+        bpm->stop_warm_up();
+        try {
+            bpm->dump_resident_pages(BufferPoolSet::dump_file(pool_name));
+        } catch (UniBaseError &) {
+            // 转储失败只影响下次打开时的预热，不影响关闭数据库
+        }
+    }
+    // 默认缓冲池在共享内存中时，关闭文件后已写回的页面仍留在帧中，下次启动直接接管
+    buffer_pool_manager_->retain_shared_frames();
     // close index handles
     for (auto &entry : ihs_) {
         ix_manager_->close_index(entry.second.get());
@@ -133,6 +156,51 @@ void SmManager::close_db() {
         rm_manager_->close_file(entry.second.get());
     }
     fhs_.clear();
+    // 具名缓冲池随数据库关闭而释放，下次打开时按元数据重新创建
+    for (auto &pool_name : pool_names) {
+        if (pool_name != DEFAULT_BUFFER_POOL) {
+            buffer_pools_.drop_pool(pool_name);
+        }
+    }
+    flush_meta();
+}
+
+/**
+ * @description: 创建具名缓冲池，之后可以在建表和建索引时把文件分配到这个缓冲池
+ * @param {string&} pool_name 缓冲池名称
+ * @param {size_t} pool_size 缓冲池中的帧个数
+ * @param {string&} replacer_type 置换策略：LRU、CLOCK、LRU-K或ARC
+ * @param {Context*} context
+ */
+void SmManager::create_buffer_pool(const std::string& pool_name, size_t pool_size, const std::string& replacer_type,
+                                   Context* context) {
+    buffer_pools_.create_pool(pool_name, pool_size, replacer_type);
+    db_.pools_[pool_name] = BufferPoolMeta{pool_name, pool_size, replacer_type};
+    buffer_pools_.get_pool(pool_name)->start_periodic_dump(BufferPoolSet::dump_file(pool_name));
+    flush_meta();
+}
+
+/**
+ * @description: 删除具名缓冲池，仍有表或索引分配在该缓冲池中时不允许删除
+ * @param {string&} pool_name 缓冲池名称
+ * @param {Context*} context
+ */
+void SmManager::drop_buffer_pool(const std::string& pool_name, Context* context) {
+    if (db_.pools_.count(pool_name) == 0) {
+        throw BufferPoolNotFoundError(pool_name);
+    }
+    for (auto &entry : db_.tabs_) {
+        bool in_use = entry.second.buffer_pool == pool_name;
+        for (auto &index : entry.second.indexes) {
+            in_use = in_use || index.buffer_pool == pool_name;
+        }
+        if (in_use) {
+            throw InternalError("Buffer pool " + pool_name + " is still used by table " + entry.first);
+        }
+    }
+    buffer_pools_.drop_pool(pool_name);
+    db_.pools_.erase(pool_name);
+    unlink(BufferPoolSet::dump_file(pool_name).c_str());
     flush_meta();
 }
 
@@ -185,15 +253,19 @@ void SmManager::desc_table(const std::string& tab_name, Context* context) {
  * @param {string&} tab_name 表的名称
  * @param {vector<ColDef>&} col_defs 表的字段
  * @param {Context*} context 
+ * @param {string&} buffer_pool 表的数据文件所在的缓冲池
  */
-void SmManager::create_table(const std::string& tab_name, const std::vector<ColDef>& col_defs, Context* context) {
+void SmManager::create_table(const std::string& tab_name, const std::vector<ColDef>& col_defs, Context* context,
+                             const std::string& buffer_pool) {
     if (db_.is_table(tab_name)) {
         throw TableExistsError(tab_name);
     }
+    BufferPoolManager *bpm = buffer_pools_.get_pool(buffer_pool);
     // Create table meta
     int curr_offset = 0;
     TabMeta tab;
     tab.name = tab_name;
+    tab.buffer_pool = buffer_pool;
     for (auto &col_def : col_defs) {
         int col_len;
         switch (col_def.type) {
@@ -227,7 +299,7 @@ void SmManager::create_table(const std::string& tab_name, const std::vector<ColD
     rm_manager_->create_file(tab_name, record_size);
     db_.tabs_[tab_name] = tab;
     // fhs_[tab_name] = rm_manager_->open_file(tab_name);
-    fhs_.emplace(tab_name, rm_manager_->open_file(tab_name));
+    fhs_.emplace(tab_name, rm_manager_->open_file(tab_name, bpm));
 
     flush_meta();
 }
@@ -243,7 +315,7 @@ void SmManager::drop_table(const std::string& tab_name, Context* context) {
     }
     // close and erase file handle
     if (fhs_.count(tab_name)) {
-        rm_manager_->close_file(fhs_.at(tab_name).get());
+        rm_manager_->discard_file(fhs_.at(tab_name).get());
         fhs_.erase(tab_name);
     }
     // drop indexes on the table
@@ -253,7 +325,7 @@ void SmManager::drop_table(const std::string& tab_name, Context* context) {
         for (auto &c : index.cols) col_names.push_back(c.name);
         auto ix_name = ix_manager_->get_index_name(tab_name, index.cols);
         if (ihs_.count(ix_name)) {
-            ix_manager_->close_index(ihs_.at(ix_name).get());
+            ix_manager_->discard_index(ihs_.at(ix_name).get());
             ihs_.erase(ix_name);
         }
         ix_manager_->destroy_index(tab_name, col_names);
@@ -269,9 +341,12 @@ void SmManager::drop_table(const std::string& tab_name, Context* context) {
  * @param {string&} tab_name 表的名称
  * @param {vector<string>&} col_names 索引包含的字段名称
  * @param {Context*} context
+ * @param {string&} buffer_pool 索引文件所在的缓冲池
  */
-void SmManager::create_index(const std::string& tab_name, const std::vector<std::string>& col_names, Context* context) {
+void SmManager::create_index(const std::string& tab_name, const std::vector<std::string>& col_names, Context* context,
+                             const std::string& buffer_pool) {
     TabMeta &tab = db_.get_table(tab_name);
+    BufferPoolManager *bpm = buffer_pools_.get_pool(buffer_pool);
     if (tab.is_index(col_names)) {
         throw IndexExistsError(tab_name, col_names);
     }
@@ -283,10 +358,10 @@ void SmManager::create_index(const std::string& tab_name, const std::vector<std:
         tot_len += it->len;
         it->index = true;
     }
-    IndexMeta meta{tab_name, tot_len, static_cast<int>(cols.size()), cols};
+    IndexMeta meta{tab_name, tot_len, static_cast<int>(cols.size()), cols, buffer_pool};
     tab.indexes.push_back(meta);
     ix_manager_->create_index(tab_name, cols);
-    ihs_[ix_manager_->get_index_name(tab_name, cols)] = ix_manager_->open_index(tab_name, cols);
+    ihs_[ix_manager_->get_index_name(tab_name, cols)] = ix_manager_->open_index(tab_name, cols, bpm);
     flush_meta();
 }
 
@@ -304,7 +379,7 @@ void SmManager::drop_index(const std::string& tab_name, const std::vector<std::s
     }
     auto ix_name = ix_manager_->get_index_name(tab_name, it_meta->cols);
     if (ihs_.count(ix_name)) {
-        ix_manager_->close_index(ihs_.at(ix_name).get());
+        ix_manager_->discard_index(ihs_.at(ix_name).get());
         ihs_.erase(ix_name);
     }
     tab.indexes.erase(it_meta);
@@ -4,6 +4,7 @@
 #include "record/rm_file_handle.h"
 #include "sm_defs.h"
 #include "sm_meta.h"
+#include "storage/buffer_pool_set.h"
 #include "common/context.h"
 
 class Context;
@@ -25,6 +26,7 @@ class SmManager {
     BufferPoolManager* buffer_pool_manager_;
     RmManager* rm_manager_;
     IxManager* ix_manager_;
+    BufferPoolSet buffer_pools_;    // 默认缓冲池和当前数据库中的具名缓冲池
 
    public:
     SmManager(DiskManager* disk_manager, BufferPoolManager* buffer_pool_manager, RmManager* rm_manager,
@@ -32,12 +34,15 @@ class SmManager {
         : disk_manager_(disk_manager),
           buffer_pool_manager_(buffer_pool_manager),
           rm_manager_(rm_manager),
-          ix_manager_(ix_manager) {}
+          ix_manager_(ix_manager),
+          buffer_pools_(disk_manager, buffer_pool_manager) {}
 
     ~SmManager() {}
 
     BufferPoolManager* get_bpm() { return buffer_pool_manager_; }
 
+    BufferPoolSet* get_buffer_pools() { return &buffer_pools_; }
+
     RmManager* get_rm_manager() { return rm_manager_; }  
 
     IxManager* get_ix_manager() { return ix_manager_; }  
@@ -58,11 +63,18 @@ class SmManager {
 
     void desc_table(const std::string& tab_name, Context* context);
 
-    void create_table(const std::string& tab_name, const std::vector<ColDef>& col_defs, Context* context);
+    void create_buffer_pool(const std::string& pool_name, size_t pool_size, const std::string& replacer_type,
+                            Context* context);
+
+    void drop_buffer_pool(const std::string& pool_name, Context* context);
+
+    void create_table(const std::string& tab_name, const std::vector<ColDef>& col_defs, Context* context,
+                      const std::string& buffer_pool = DEFAULT_BUFFER_POOL);
 
     void drop_table(const std::string& tab_name, Context* context);
 
-    void create_index(const std::string& tab_name, const std::vector<std::string>& col_names, Context* context);
+    void create_index(const std::string& tab_name, const std::vector<std::string>& col_names, Context* context,
+                      const std::string& buffer_pool = DEFAULT_BUFFER_POOL);
 
     void drop_index(const std::string& tab_name, const std::vector<std::string>& col_names, Context* context);
     
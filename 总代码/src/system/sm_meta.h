@@ -6,6 +6,7 @@
 #include <string>
 #include <vector>
 
+#include "common/config.h"
 #include "errors.h"
 #include "sm_defs.h"
 
@@ -35,9 +36,10 @@ struct IndexMeta {
     int col_tot_len;                // 索引字段长度总和
     int col_num;                    // 索引字段数量
     std::vector<ColMeta> cols;      // 索引包含的字段
+    std::string buffer_pool = DEFAULT_BUFFER_POOL;  // 索引文件所在的缓冲池
 
     friend std::ostream &operator<<(std::ostream &os, const IndexMeta &index) {
-        os << index.tab_name << " " << index.col_tot_len << " " << index.col_num;
+        os << index.tab_name << " " << index.col_tot_len << " " << index.col_num << " " << index.buffer_pool;
         for(auto& col: index.cols) {
             os << "\n" << col;
         }
@@ -45,7 +47,7 @@ struct IndexMeta {
     }
 
     friend std::istream &operator>>(std::istream &is, IndexMeta &index) {
-        is >> index.tab_name >> index.col_tot_len >> index.col_num;
+        is >> index.tab_name >> index.col_tot_len >> index.col_num >> index.buffer_pool;
         for(int i = 0; i < index.col_num; ++i) {
             ColMeta col;
             is >> col;
@@ -60,11 +62,13 @@ struct TabMeta {
     std::string name;                   // 表名称
     std::vector<ColMeta> cols;          // 表包含的字段
     std::vector<IndexMeta> indexes;     // 表上建立的索引
+    std::string buffer_pool = DEFAULT_BUFFER_POOL;  // 表的数据文件所在的缓冲池
 
     TabMeta(){}
 
     TabMeta(const TabMeta &other) {
         name = other.name;
+        buffer_pool = other.buffer_pool;
         for(auto col : other.cols) cols.push_back(col);
     }
 
@@ -115,7 +119,7 @@ struct TabMeta {
     }
 
     friend std::ostream &operator<<(std::ostream &os, const TabMeta &tab) {
-        os << tab.name << '\n' << tab.cols.size() << '\n';
+        os << tab.name << ' ' << tab.buffer_pool << '\n' << tab.cols.size() << '\n';
         for (auto &col : tab.cols) {
             os << col << '\n';  // col是ColMeta类型，然后调用重载的ColMeta的操作符<<
         }
@@ -128,7 +132,7 @@ struct TabMeta {
 
     friend std::istream &operator>>(std::istream &is, TabMeta &tab) {
         size_t n;
-        is >> tab.name >> n;
+        is >> tab.name >> tab.buffer_pool >> n;
         for (size_t i = 0; i < n; i++) {
             ColMeta col;
             is >> col;
@@ -144,6 +148,21 @@ struct TabMeta {
     }
 };
 
+/* 具名缓冲池元数据，打开数据库时按它重新创建缓冲池 */
+struct BufferPoolMeta {
+    std::string name;       // 缓冲池名称
+    size_t size;            // 缓冲池中的帧个数
+    std::string replacer;   // 置换策略
+
+    friend std::ostream &operator<<(std::ostream &os, const BufferPoolMeta &pool) {
+        return os << pool.name << ' ' << pool.size << ' ' << pool.replacer;
+    }
+
+    friend std::istream &operator>>(std::istream &is, BufferPoolMeta &pool) {
+        return is >> pool.name >> pool.size >> pool.replacer;
+    }
+};
+
 // 注意重载了操作符 << 和 >>，这需要更底层同样重载TabMeta、ColMeta的操作符 << 和 >>
 /* 数据库元数据 */
 class DbMeta {
@@ -152,6 +171,7 @@ class DbMeta {
    private:
     std::string name_;                      // 数据库名称
     std::map<std::string, TabMeta> tabs_;   // 数据库中包含的表
+    std::map<std::string, BufferPoolMeta> pools_;   // 数据库中用CREATE BUFFER_POOL创建的缓冲池，不含默认缓冲池
 
    public:
     // DbMeta(std::string name) : name_(name) {}
@@ -179,6 +199,10 @@ class DbMeta {
         for (auto &entry : db_meta.tabs_) {
             os << entry.second << '\n';
         }
+        os << db_meta.pools_.size() << '\n';
+        for (auto &entry : db_meta.pools_) {
+            os << entry.second << '\n';
+        }
         return os;
     }
 
@@ -190,6 +214,14 @@ class DbMeta {
             is >> tab;
             db_meta.tabs_[tab.name] = tab;
         }
+        // 没有缓冲池信息的元数据文件视为只使用默认缓冲池
+        n = 0;
+        is >> n;
+        for (size_t i = 0; i < n; i++) {
+            BufferPoolMeta pool;
+            is >> pool;
+            db_meta.pools_[pool.name] = pool;
+        }
         return is;
     }
 };
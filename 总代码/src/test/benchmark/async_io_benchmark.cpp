@@ -0,0 +1,97 @@
+/**
+ * @description: 随机页面读的吞吐量测试：比较同步read_page与io_uring在不同队列深度(1/8/32)下的表现
+ * 用法: async_io_benchmark [num_pages] [num_reads]
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "storage/disk_manager.h"
+
+static const std::string BENCH_FILE = "async_io_benchmark.db";
+
+/**
+ * @description: 以给定的队列深度进行num_reads次随机页面读，返回每秒读取的页面数
+ */
+static double run_async(DiskManager *disk_manager, int fd, const std::vector<page_id_t> &page_nos, int depth) {
+    std::vector<char> bufs(static_cast<size_t>(depth) * PAGE_SIZE);
+    std::vector<int> free_slots;
+    for (int i = depth - 1; i >= 0; i--) free_slots.push_back(i);
+    std::vector<IoCompletion> completions;
+    size_t next = 0, done = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    while (done < page_nos.size()) {
+        // 队列未满时补充新的读请求
+        while (!free_slots.empty() && next < page_nos.size()) {
+            int slot = free_slots.back();
+            free_slots.pop_back();
+            disk_manager->submit_read(fd, page_nos[next++], &bufs[static_cast<size_t>(slot) * PAGE_SIZE], PAGE_SIZE,
+                                      slot);
+        }
+        completions.clear();
+        disk_manager->poll_completions(&completions, 1);
+        for (auto &completion : completions) {
+            if (completion.result != PAGE_SIZE) {
+                fprintf(stderr, "read failed: %d\n", completion.result);
+                exit(1);
+            }
+            free_slots.push_back(static_cast<int>(completion.user_data));
+        }
+        done += completions.size();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return page_nos.size() / elapsed.count();
+}
+
+static double run_sync(DiskManager *disk_manager, int fd, const std::vector<page_id_t> &page_nos) {
+    char buf[PAGE_SIZE];
+    auto start = std::chrono::steady_clock::now();
+    for (page_id_t page_no : page_nos) {
+        disk_manager->read_page(fd, page_no, buf, PAGE_SIZE);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return page_nos.size() / elapsed.count();
+}
+
+int main(int argc, char **argv) {
+    int num_pages = argc > 1 ? atoi(argv[1]) : 16384;
+    int num_reads = argc > 2 ? atoi(argv[2]) : 100000;
+
+    DiskManager disk_manager;
+    if (disk_manager.is_file(BENCH_FILE)) {
+        disk_manager.destroy_file(BENCH_FILE);
+    }
+    disk_manager.create_file(BENCH_FILE);
+    int fd = disk_manager.open_file(BENCH_FILE);
+
+    std::vector<char> chunk(static_cast<size_t>(IO_BATCH_MAX_PAGES) * PAGE_SIZE, 'x');
+    std::vector<const char *> pages(IO_BATCH_MAX_PAGES);
+    for (int i = 0; i < IO_BATCH_MAX_PAGES; i++) pages[i] = &chunk[static_cast<size_t>(i) * PAGE_SIZE];
+    for (int page_no = 0; page_no < num_pages; page_no += IO_BATCH_MAX_PAGES) {
+        disk_manager.write_pages(fd, page_no, pages.data(), std::min(IO_BATCH_MAX_PAGES, num_pages - page_no));
+    }
+
+    std::mt19937 rng(2024);
+    std::uniform_int_distribution<page_id_t> dist(0, num_pages - 1);
+    std::vector<page_id_t> page_nos(num_reads);
+    for (auto &page_no : page_nos) page_no = dist(rng);
+
+    printf("pages=%d reads=%d\n", num_pages, num_reads);
+    printf("%-16s %14s\n", "mode", "pages/s");
+    printf("%-16s %14.0f\n", "sync read_page", run_sync(&disk_manager, fd, page_nos));
+    for (bool async : {false, true}) {
+        disk_manager.set_async_io(async);
+        for (int depth : {1, 8, 32}) {
+            std::string mode = std::string(async ? "io_uring" : "fallback") + " qd=" + std::to_string(depth);
+            printf("%-16s %14.0f\n", mode.c_str(), run_async(&disk_manager, fd, page_nos, depth));
+        }
+    }
+
+    disk_manager.close_file(fd);
+    disk_manager.destroy_file(BENCH_FILE);
+    return 0;
+}
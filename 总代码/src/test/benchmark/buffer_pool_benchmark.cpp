@@ -0,0 +1,83 @@
+/**
+ * @description: 缓冲池的多线程fetch_page/unpin_page吞吐量测试：所有页面都已在缓冲池中，只衡量latch的开销
+ * 比较不分片(1个分片)与分片缓冲池在1到32个线程下的表现
+ * 用法: buffer_pool_benchmark [num_pages] [ops_per_thread]
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "storage/buffer_pool_manager.h"
+
+static const std::string BENCH_FILE = "buffer_pool_benchmark.db";
+
+/**
+ * @description: num_threads个线程各自随机fetch并unpin ops_per_thread次页面，返回每秒完成的fetch次数
+ */
+static double run_fetch(BufferPoolManager *bpm, int fd, int num_pages, int num_threads, int ops_per_thread) {
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+    for (int tid = 0; tid < num_threads; tid++) {
+        threads.emplace_back([=]() {
+            std::mt19937 rng(tid);
+            std::uniform_int_distribution<page_id_t> dist(0, num_pages - 1);
+            for (int i = 0; i < ops_per_thread; i++) {
+                PageId page_id{fd, dist(rng)};
+                Page *page = bpm->fetch_page(page_id);
+                if (page == nullptr) {
+                    fprintf(stderr, "fetch_page failed: %s\n", page_id.toString().c_str());
+                    exit(1);
+                }
+                bpm->unpin_page(page_id, false);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(num_threads) * ops_per_thread / elapsed.count();
+}
+
+int main(int argc, char **argv) {
+    int num_pages = argc > 1 ? atoi(argv[1]) : 16384;
+    int ops_per_thread = argc > 2 ? atoi(argv[2]) : 200000;
+
+    DiskManager disk_manager;
+    if (disk_manager.is_file(BENCH_FILE)) {
+        disk_manager.destroy_file(BENCH_FILE);
+    }
+    disk_manager.create_file(BENCH_FILE);
+    int fd = disk_manager.open_file(BENCH_FILE);
+
+    std::vector<char> chunk(static_cast<size_t>(IO_BATCH_MAX_PAGES) * PAGE_SIZE, 'x');
+    std::vector<const char *> pages(IO_BATCH_MAX_PAGES);
+    for (int i = 0; i < IO_BATCH_MAX_PAGES; i++) pages[i] = &chunk[static_cast<size_t>(i) * PAGE_SIZE];
+    for (int page_no = 0; page_no < num_pages; page_no += IO_BATCH_MAX_PAGES) {
+        disk_manager.write_pages(fd, page_no, pages.data(), std::min(IO_BATCH_MAX_PAGES, num_pages - page_no));
+    }
+    disk_manager.set_fd2pageno(fd, num_pages);
+
+    printf("pages=%d ops/thread=%d\n", num_pages, ops_per_thread);
+    printf("%-8s %-8s %14s\n", "shards", "threads", "fetches/s");
+    for (size_t num_shards : {static_cast<size_t>(1), static_cast<size_t>(BUFFER_POOL_SHARDS)}) {
+        BufferPoolManager bpm(num_pages, &disk_manager, num_shards);
+        // 预热：先把所有页面读入缓冲池
+        for (page_id_t page_no = 0; page_no < num_pages; page_no++) {
+            bpm.fetch_page(PageId{fd, page_no});
+            bpm.unpin_page(PageId{fd, page_no}, false);
+        }
+        for (int num_threads : {1, 2, 4, 8, 16, 32}) {
+            printf("%-8zu %-8d %14.0f\n", bpm.get_num_shards(), num_threads,
+                   run_fetch(&bpm, fd, num_pages, num_threads, ops_per_thread));
+        }
+    }
+
+    disk_manager.close_file(fd);
+    disk_manager.destroy_file(BENCH_FILE);
+    return 0;
+}
@@ -0,0 +1,85 @@
+/**
+ * @description: 帧数据区的页面大小对随机访问帧的影响：分别用普通4KB页面和大页(2MB)分配同样大小的数据区，
+ * 在随机的帧之间做依赖链访问(每次访问的帧由上一次读到的值决定，衡量访问延迟)和独立的随机访问(衡量吞吐量)。
+ * 数据区远大于TLB的覆盖范围时，大页的TLB缺失少得多
+ * 用法: huge_page_benchmark [num_frames] [num_accesses]
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "storage/frame_arena.h"
+
+static const char *page_type_name(FramePageType type) {
+    switch (type) {
+        case FramePageType::EXPLICIT_HUGE:
+            return "hugetlb 2M";
+        case FramePageType::TRANSPARENT_HUGE:
+            return "THP 2M";
+        default:
+            return "4K";
+    }
+}
+
+/**
+ * @description: 帧frame_no中存放下一个帧编号的位置。不同帧使用不同的页内偏移，避免都落在同一个cache set上
+ */
+static uint32_t *slot(char *data, uint32_t frame_no) {
+    size_t offset = (static_cast<size_t>(frame_no) * 64) % PAGE_SIZE;
+    return reinterpret_cast<uint32_t *>(data + static_cast<size_t>(frame_no) * PAGE_SIZE + offset);
+}
+
+/**
+ * @description: 在一个数据区上运行两种随机访问，输出每次访问的平均耗时
+ */
+static void run(bool use_huge_pages, uint32_t num_frames, size_t num_accesses) {
+    FrameArena arena(static_cast<size_t>(num_frames) * PAGE_SIZE, use_huge_pages);
+    char *data = arena.data();
+    // 把所有帧随机排成一个环，每个帧中记录环上的下一个帧
+    std::vector<uint32_t> order(num_frames);
+    std::iota(order.begin(), order.end(), 0);
+    std::mt19937 rng(2024);
+    std::shuffle(order.begin(), order.end(), rng);
+    for (uint32_t i = 0; i < num_frames; i++) {
+        *slot(data, order[i]) = order[(i + 1) % num_frames];
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    uint32_t frame_no = order[0];
+    for (size_t i = 0; i < num_accesses; i++) {
+        frame_no = *slot(data, frame_no);
+    }
+    std::chrono::duration<double, std::nano> chase = std::chrono::steady_clock::now() - start;
+
+    std::uniform_int_distribution<uint32_t> dist(0, num_frames - 1);
+    std::vector<uint32_t> targets(num_accesses);
+    for (auto &target : targets) {
+        target = dist(rng);
+    }
+    start = std::chrono::steady_clock::now();
+    uint64_t sum = 0;
+    for (uint32_t target : targets) {
+        sum += *slot(data, target);
+    }
+    std::chrono::duration<double, std::nano> independent = std::chrono::steady_clock::now() - start;
+
+    printf("%-12s %14.2f %14.2f   (checksum %u %llu)\n", page_type_name(arena.get_page_type()),
+           chase.count() / num_accesses, independent.count() / num_accesses, frame_no,
+           static_cast<unsigned long long>(sum));
+}
+
+int main(int argc, char **argv) {
+    uint32_t num_frames = argc > 1 ? static_cast<uint32_t>(atol(argv[1])) : 262144;
+    size_t num_accesses = argc > 2 ? static_cast<size_t>(atol(argv[2])) : 20000000;
+    printf("frames=%u (%zu MB) accesses=%zu\n", num_frames, static_cast<size_t>(num_frames) * PAGE_SIZE >> 20,
+           num_accesses);
+    printf("%-12s %14s %14s\n", "pages", "chase ns/op", "random ns/op");
+    run(false, num_frames, num_accesses);
+    run(true, num_frames, num_accesses);
+    return 0;
+}
@@ -0,0 +1,90 @@
+/**
+ * @description: 页表的查找吞吐量测试：比较原来的std::unordered_map(旧的PageIdHash，由分片的latch保护)
+ * 与开放寻址的PageTable(查找不加锁)。页面来自多个文件，每个文件超过65536页，这时旧的哈希(fd << 16) | page_no会产生冲突
+ * 用法: page_table_benchmark [num_entries] [lookups_per_thread]
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "storage/page_table.h"
+
+/**
+ * @description: 原来的PageId哈希
+ */
+struct LegacyPageIdHash {
+    size_t operator()(const PageId &x) const { return (x.fd << 16) | x.page_no; }
+};
+
+/**
+ * @description: num_threads个线程各自随机查找lookups_per_thread次，返回每秒完成的查找次数
+ */
+static double run_lookups(const std::vector<PageId> &keys, int num_threads, int lookups_per_thread,
+                          const std::function<frame_id_t(PageId)> &lookup) {
+    std::vector<std::thread> threads;
+    std::atomic<int64_t> checksum{0};
+    auto start = std::chrono::steady_clock::now();
+    for (int tid = 0; tid < num_threads; tid++) {
+        threads.emplace_back([&, tid]() {
+            std::mt19937 rng(tid);
+            std::uniform_int_distribution<size_t> dist(0, keys.size() - 1);
+            int64_t sum = 0;
+            for (int i = 0; i < lookups_per_thread; i++) {
+                sum += lookup(keys[dist(rng)]);
+            }
+            checksum += sum;
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    if (checksum.load() < 0) {
+        fprintf(stderr, "lookup failed\n");
+        exit(1);
+    }
+    return static_cast<double>(num_threads) * lookups_per_thread / elapsed.count();
+}
+
+int main(int argc, char **argv) {
+    int num_entries = argc > 1 ? atoi(argv[1]) : 65536;
+    int lookups_per_thread = argc > 2 ? atoi(argv[2]) : 1000000;
+
+    // 4个文件，页号分散在[0, 4 * num_entries)中
+    std::vector<PageId> keys;
+    std::mt19937 rng(2024);
+    std::uniform_int_distribution<page_id_t> page_dist(0, 4 * num_entries - 1);
+    std::unordered_map<PageId, frame_id_t, LegacyPageIdHash> map;
+    PageTable page_table(num_entries);
+    while (static_cast<int>(keys.size()) < num_entries) {
+        PageId page_id{static_cast<int>(keys.size() % 4), page_dist(rng)};
+        if (map.count(page_id)) {
+            continue;
+        }
+        frame_id_t frame_id = static_cast<frame_id_t>(keys.size());
+        map[page_id] = frame_id;
+        page_table.insert(page_id, frame_id);
+        keys.push_back(page_id);
+    }
+    std::mutex latch;
+    auto map_lookup = [&](PageId page_id) {
+        std::lock_guard<std::mutex> lock(latch);
+        auto it = map.find(page_id);
+        return it == map.end() ? INVALID_FRAME_ID : it->second;
+    };
+    auto table_lookup = [&](PageId page_id) { return page_table.find(page_id); };
+
+    printf("entries=%d lookups_per_thread=%d\n", num_entries, lookups_per_thread);
+    printf("%-8s %22s %22s\n", "threads", "unordered_map(ops/s)", "PageTable(ops/s)");
+    for (int num_threads : {1, 2, 4, 8, 16}) {
+        printf("%-8d %22.0f %22.0f\n", num_threads, run_lookups(keys, num_threads, lookups_per_thread, map_lookup),
+               run_lookups(keys, num_threads, lookups_per_thread, table_lookup));
+    }
+    return 0;
+}
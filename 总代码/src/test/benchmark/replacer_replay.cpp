@@ -0,0 +1,126 @@
+/**
+ * @description: 置换策略的回放测试：把页面访问序列依次交给LRU、CLOCK、LRU-K和ARC，比较不同缓冲池大小下的命中率
+ * 访问序列文件每行为"fd page_no"，可以在启动unibase时设置环境变量UNIBASE_ACCESS_TRACE=<文件>记录实际负载的访问序列；
+ * 不指定文件时生成一段模拟的混合负载：热点集中的点查询(OLTP)中穿插对大表的全表扫描(报表查询)
+ * 用法: replacer_replay [trace_file] [num_frames...]
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "replacer/arc_replacer.h"
+#include "replacer/clock_replacer.h"
+#include "replacer/lru_k_replacer.h"
+#include "replacer/lru_replacer.h"
+
+/**
+ * @description: 生成模拟的混合负载：80%的点查询落在20%的热点页面上，每隔一段时间扫描一遍比缓冲池大得多的表
+ */
+static std::vector<int64_t> generate_trace() {
+    const int hot_table_pages = 4096;
+    const int scan_table_pages = 16384;
+    const int num_point_queries = 400000;
+    const int scan_interval = 50000;
+    std::mt19937 rng(2024);
+    std::uniform_real_distribution<double> coin(0, 1);
+    std::uniform_int_distribution<int> hot(0, hot_table_pages / 5 - 1);
+    std::uniform_int_distribution<int> cold(hot_table_pages / 5, hot_table_pages - 1);
+    std::vector<int64_t> trace;
+    for (int i = 0; i < num_point_queries; i++) {
+        int page_no = coin(rng) < 0.8 ? hot(rng) : cold(rng);
+        trace.push_back((int64_t{0} << 32) | page_no);
+        if (i % scan_interval == scan_interval - 1) {
+            for (int scan_page = 0; scan_page < scan_table_pages; scan_page++) {
+                trace.push_back((int64_t{1} << 32) | scan_page);
+            }
+        }
+    }
+    return trace;
+}
+
+/**
+ * @description: 读取访问序列文件
+ */
+static std::vector<int64_t> load_trace(const std::string &path) {
+    std::ifstream ifs(path);
+    if (!ifs.is_open()) {
+        fprintf(stderr, "cannot open trace file %s\n", path.c_str());
+        exit(1);
+    }
+    std::vector<int64_t> trace;
+    int64_t fd, page_no;
+    while (ifs >> fd >> page_no) {
+        trace.push_back((fd << 32) | static_cast<uint32_t>(page_no));
+    }
+    return trace;
+}
+
+/**
+ * @description: 用给定的置换策略模拟一个有num_frames个帧的缓冲池，按BufferPoolManager的调用方式回放访问序列，返回命中率
+ */
+static double replay(Replacer *replacer, size_t num_frames, const std::vector<int64_t> &trace) {
+    std::unordered_map<int64_t, frame_id_t> page_table;
+    std::vector<int64_t> frame_pages(num_frames, -1);
+    size_t next_free = 0;
+    size_t hits = 0;
+    for (int64_t page : trace) {
+        frame_id_t frame_id;
+        auto it = page_table.find(page);
+        if (it != page_table.end()) {
+            frame_id = it->second;
+            hits++;
+        } else {
+            if (next_free < num_frames) {
+                frame_id = static_cast<frame_id_t>(next_free++);
+            } else if (!replacer->victim(&frame_id)) {
+                fprintf(stderr, "no victim\n");
+                exit(1);
+            }
+            if (frame_pages[frame_id] != -1) {
+                page_table.erase(frame_pages[frame_id]);
+            }
+            frame_pages[frame_id] = page;
+            page_table[page] = frame_id;
+        }
+        replacer->pin(frame_id);
+        replacer->record_access(frame_id, page);
+        replacer->unpin(frame_id);
+    }
+    return trace.empty() ? 0 : static_cast<double>(hits) / trace.size();
+}
+
+int main(int argc, char **argv) {
+    std::vector<int64_t> trace = argc > 1 ? load_trace(argv[1]) : generate_trace();
+    std::vector<size_t> frame_counts;
+    for (int i = 2; i < argc; i++) {
+        frame_counts.push_back(static_cast<size_t>(atol(argv[i])));
+    }
+    if (frame_counts.empty()) {
+        frame_counts = {512, 1024, 2048, 4096};
+    }
+
+    printf("accesses=%zu\n", trace.size());
+    printf("%-8s", "frames");
+    for (const char *name : {"LRU", "CLOCK", "LRU-K", "ARC"}) {
+        printf(" %10s", name);
+    }
+    printf("\n");
+    for (size_t num_frames : frame_counts) {
+        std::vector<std::unique_ptr<Replacer>> replacers;
+        replacers.emplace_back(new LRUReplacer(num_frames));
+        replacers.emplace_back(new ClockReplacer(num_frames));
+        replacers.emplace_back(new LRUKReplacer(num_frames));
+        replacers.emplace_back(new ARCReplacer(num_frames));
+        printf("%-8zu", num_frames);
+        for (auto &replacer : replacers) {
+            printf(" %9.2f%%", 100 * replay(replacer.get(), num_frames, trace));
+        }
+        printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,148 @@
+/**
+ * @description: 全表扫描的吞吐量测试：表的所有页面都已在缓冲池中，比较逐条记录按rid复制或取视图(每条记录查一次页表)
+ * 与按页面批量扫描(每个页面固定一次，按64位的字查找bitmap)，并以同样字节数的memcpy作为内存带宽的参照。
+ * 另外单独比较逐位与按字查找bitmap中为1的位
+ * 用法: scan_benchmark [num_records] [record_size] [fill_percent]
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "record/rm.h"
+
+static const std::string BENCH_FILE = "scan_benchmark.db";
+
+static double seconds_since(std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+static void print_result(const char *mode, long long num_records, long long bytes, double seconds, long long checksum) {
+    printf("%-12s %14.0f %12.1f %10.3f  (checksum %lld)\n", mode, num_records / seconds, bytes / seconds / (1 << 20),
+           seconds * 1000, checksum);
+}
+
+/**
+ * @description: 在随机填充的bitmap上找出所有为1的位，比较逐位检查与按字查找
+ */
+static void run_bitmap(int max_n, int fill_percent, int rounds) {
+    std::mt19937 rng(2024);
+    std::vector<char> bm((max_n + BITMAP_WIDTH - 1) / BITMAP_WIDTH);
+    Bitmap::init(bm.data(), static_cast<int>(bm.size()));
+    for (int i = 0; i < max_n; i++) {
+        if (static_cast<int>(rng() % 100) < fill_percent) {
+            Bitmap::set(bm.data(), i);
+        }
+    }
+    std::vector<int> bits(max_n);
+    long long checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < max_n; i++) {
+            if (Bitmap::is_set(bm.data(), i)) {
+                checksum += i;
+            }
+        }
+    }
+    print_result("bit", static_cast<long long>(rounds) * max_n, static_cast<long long>(rounds) * bm.size(),
+                 seconds_since(start), checksum);
+    checksum = 0;
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        int n = Bitmap::get_set_bits(bm.data(), max_n, bits.data());
+        for (int i = 0; i < n; i++) {
+            checksum += bits[i];
+        }
+    }
+    print_result("word", static_cast<long long>(rounds) * max_n, static_cast<long long>(rounds) * bm.size(),
+                 seconds_since(start), checksum);
+}
+
+int main(int argc, char **argv) {
+    int num_records = argc > 1 ? atoi(argv[1]) : 1000000;
+    int record_size = argc > 2 ? atoi(argv[2]) : 32;
+    int fill_percent = argc > 3 ? atoi(argv[3]) : 100;
+
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+    if (disk_manager->is_file(BENCH_FILE)) {
+        disk_manager->destroy_file(BENCH_FILE);
+    }
+    rm_manager->create_file(BENCH_FILE, record_size);
+    auto file_handle = rm_manager->open_file(BENCH_FILE);
+
+    // 插入后按fill_percent随机删除一部分记录，使页面上留有空闲的slot
+    std::mt19937 rng(2024);
+    std::vector<char> buf(record_size);
+    std::vector<Rid> rids;
+    for (int i = 0; i < num_records; i++) {
+        for (auto &c : buf) {
+            c = static_cast<char>(rng());
+        }
+        Rid rid = file_handle->insert_record(buf.data(), nullptr);
+        if (static_cast<int>(rng() % 100) < fill_percent) {
+            rids.push_back(rid);
+        } else {
+            file_handle->delete_record(rid, nullptr);
+        }
+    }
+    int num_pages = file_handle->get_file_hdr().num_pages;
+    long long bytes = static_cast<long long>(rids.size()) * record_size;
+    printf("records=%zu record_size=%d pages=%d pool=%zu\n", rids.size(), record_size, num_pages,
+           static_cast<size_t>(BUFFER_POOL_SIZE));
+    printf("%-12s %14s %12s %10s\n", "mode", "records/s", "MB/s", "time_ms");
+
+    // 预热：把所有页面读入缓冲池
+    for (RmScan scan(file_handle.get()); !scan.is_end(); scan.next_batch()) {
+    }
+
+    long long checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (auto &rid : rids) {
+        auto rec = file_handle->get_record(rid, nullptr);
+        checksum += rec->data[0];
+    }
+    print_result("per-record", static_cast<long long>(rids.size()), bytes, seconds_since(start), checksum);
+
+    checksum = 0;
+    start = std::chrono::steady_clock::now();
+    for (auto &rid : rids) {
+        RecordView view = file_handle->get_record_view(rid);
+        checksum += view.data()[0];
+    }
+    print_result("view", static_cast<long long>(rids.size()), bytes, seconds_since(start), checksum);
+
+    checksum = 0;
+    start = std::chrono::steady_clock::now();
+    long long scanned = 0;
+    RmScan scan(file_handle.get());
+    for (bool has_page = !scan.is_end(); has_page; has_page = scan.next_batch()) {
+        RmPageBatch &batch = scan.batch();
+        for (int i = 0; i < batch.size(); i++) {
+            checksum += batch.get_record(i)[0];
+        }
+        scanned += batch.size();
+    }
+    print_result("batch", scanned, bytes, seconds_since(start), checksum);
+
+    std::vector<char> src(bytes + 1), dst(bytes + 1);
+    checksum = 0;
+    start = std::chrono::steady_clock::now();
+    memcpy(dst.data(), src.data(), bytes);
+    checksum += dst[bytes / 2];
+    print_result("memcpy", static_cast<long long>(rids.size()), bytes, seconds_since(start), checksum);
+
+    int records_per_page = file_handle->get_file_hdr().num_records_per_page;
+    printf("\nbitmap: bits=%d fill=%d%%\n", records_per_page, fill_percent);
+    printf("%-12s %14s %12s %10s\n", "mode", "bits/s", "MB/s", "time_ms");
+    run_bitmap(records_per_page, fill_percent, num_pages);
+
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(BENCH_FILE);
+    return 0;
+}
@@ -0,0 +1,90 @@
+/**
+ * @description: 顺序扫描的I/O量与耗时测试：比较普通文件与压缩文件扫描同样的表页面
+ * 页面内容模拟RmFileHandle的定长记录槽：每条记录为一个INT和一个CHAR(n)字段，字符串较短，其余部分填充0
+ * 每次扫描前用posix_fadvise(DONTNEED)丢弃内核页缓存中该文件的内容，读取的字节数来自/proc/self/io的rchar
+ * 用法: scan_compression_benchmark [num_pages] [char_len]
+ */
+#include <fcntl.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "storage/disk_manager.h"
+
+/**
+ * @description: 读取当前进程通过read类系统调用读到的总字节数
+ */
+static long long read_chars() {
+    std::ifstream ifs("/proc/self/io");
+    std::string key;
+    long long value;
+    while (ifs >> key >> value) {
+        if (key == "rchar:") return value;
+    }
+    return 0;
+}
+
+static void fill_page(char *page, int page_no, int char_len, std::mt19937 &rng) {
+    memset(page, 0, PAGE_SIZE);
+    int record_size = static_cast<int>(sizeof(int)) + char_len;
+    int num_records = (PAGE_SIZE - 64) / record_size;
+    for (int i = 0; i < num_records; i++) {
+        char *record = page + 64 + i * record_size;
+        int id = page_no * num_records + i;
+        memcpy(record, &id, sizeof(id));
+        snprintf(record + sizeof(int), char_len, "name_%u", static_cast<unsigned>(rng() % 100000));
+    }
+}
+
+static void run_scan(DiskManager *disk_manager, const std::string &filename, bool compressed, int num_pages,
+                     int char_len) {
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    disk_manager->create_file(filename, compressed);
+    int fd = disk_manager->open_file(filename);
+    std::mt19937 rng(2024);
+    std::vector<char> page(PAGE_SIZE);
+    for (int page_no = 0; page_no < num_pages; page_no++) {
+        fill_page(page.data(), page_no, char_len, rng);
+        disk_manager->write_page(fd, page_no, page.data(), PAGE_SIZE);
+    }
+    fdatasync(fd);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+
+    long long rchar_before = read_chars();
+    auto start = std::chrono::steady_clock::now();
+    long long checksum = 0;
+    for (int page_no = 0; page_no < num_pages; page_no++) {
+        disk_manager->read_page(fd, page_no, page.data(), PAGE_SIZE);
+        checksum += page[64];
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    long long bytes_read = read_chars() - rchar_before;
+
+    printf("%-12s %12lld %12.1f %10.3f %10.0f  (checksum %lld)\n", compressed ? "compressed" : "plain", bytes_read,
+           static_cast<double>(num_pages) * PAGE_SIZE / std::max(bytes_read, 1LL), elapsed.count() * 1000,
+           num_pages / elapsed.count(), checksum);
+    disk_manager->close_file(fd);
+    disk_manager->destroy_file(filename);
+}
+
+int main(int argc, char **argv) {
+    int num_pages = argc > 1 ? atoi(argv[1]) : 16384;
+    int char_len = argc > 2 ? atoi(argv[2]) : 64;
+
+    DiskManager disk_manager;
+    // 普通文件用带缓存的I/O，两种模式都经过内核页缓存，便于比较读取的字节数
+    disk_manager.set_direct_io(false);
+    printf("pages=%d record=INT+CHAR(%d)\n", num_pages, char_len);
+    printf("%-12s %12s %12s %10s %10s\n", "mode", "bytes_read", "ratio", "time_ms", "pages/s");
+    run_scan(&disk_manager, "scan_compression_benchmark.plain", false, num_pages, char_len);
+    run_scan(&disk_manager, "scan_compression_benchmark.compressed", true, num_pages, char_len);
+    return 0;
+}
@@ -0,0 +1,133 @@
+#include <unistd.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "execution/executor_delete.h"
+#include "execution/executor_seq_scan.h"
+
+const std::string TEST_DB_NAME = "SeqScanExecutorTest_db";  // 以数据库名作为根目录
+const std::string TEST_TAB_NAME = "t";
+const int NUM_RECORDS = 100;
+const int NUM_GROUPS = 5;  // 第i条记录的a字段为i % NUM_GROUPS，b字段为i
+
+/** 对于每个测试点，先创建和进入目录TEST_DB_NAME，然后创建表t(a INT, b INT)并插入NUM_RECORDS条记录 */
+class SeqScanExecutorTest : public ::testing::Test {
+   public:
+    std::unique_ptr<DiskManager> disk_manager_;
+    std::unique_ptr<BufferPoolManager> buffer_pool_manager_;
+    std::unique_ptr<RmManager> rm_manager_;
+    std::unique_ptr<IxManager> ix_manager_;
+    std::unique_ptr<SmManager> sm_manager_;
+    std::unique_ptr<Context> context_;
+
+   public:
+    void SetUp() override {
+        ::testing::Test::SetUp();
+        disk_manager_ = std::make_unique<DiskManager>();
+        buffer_pool_manager_ = std::make_unique<BufferPoolManager>(200, disk_manager_.get());
+        rm_manager_ = std::make_unique<RmManager>(disk_manager_.get(), buffer_pool_manager_.get());
+        ix_manager_ = std::make_unique<IxManager>(disk_manager_.get(), buffer_pool_manager_.get());
+        sm_manager_ = std::make_unique<SmManager>(disk_manager_.get(), buffer_pool_manager_.get(), rm_manager_.get(),
+                                                  ix_manager_.get());
+        context_ = std::make_unique<Context>(nullptr, nullptr, nullptr);
+        if (disk_manager_->is_dir(TEST_DB_NAME)) {
+            std::string cmd = "rm -rf " + TEST_DB_NAME;
+            if (system(cmd.c_str()) < 0) {
+                throw UnixError();
+            }
+        }
+        sm_manager_->create_db(TEST_DB_NAME);
+        std::vector<ColDef> col_defs = {{"a", TYPE_INT, 4}, {"b", TYPE_INT, 4}};
+        sm_manager_->create_table(TEST_TAB_NAME, col_defs, nullptr);
+        RmFileHandle *fh = sm_manager_->fhs_.at(TEST_TAB_NAME).get();
+        for (int i = 0; i < NUM_RECORDS; i++) {
+            int buf[2] = {i % NUM_GROUPS, i};
+            fh->insert_record(reinterpret_cast<char *>(buf), context_.get());
+        }
+    }
+
+    void TearDown() override {
+        rm_manager_->close_file(sm_manager_->fhs_.at(TEST_TAB_NAME).get());
+        sm_manager_->fhs_.clear();
+        if (chdir("..") < 0) {
+            throw UnixError();
+        }
+    }
+
+    static Condition make_cond(const std::string &col_name, CompOp op, int val) {
+        Condition cond;
+        cond.lhs_col = {TEST_TAB_NAME, col_name};
+        cond.op = op;
+        cond.is_rhs_val = true;
+        cond.rhs_val.set_int(val);
+        cond.rhs_val.init_raw(sizeof(int));
+        return cond;
+    }
+
+    // 用条件conds扫描表，返回扫描到的记录的(a, b)
+    std::vector<std::pair<int, int>> scan(const std::vector<Condition> &conds) {
+        std::vector<std::pair<int, int>> rows;
+        SeqScanExecutor exec(sm_manager_.get(), TEST_TAB_NAME, conds, context_.get());
+        for (exec.beginTuple(); !exec.is_end(); exec.nextTuple()) {
+            auto rec = exec.Next();
+            const int *data = reinterpret_cast<const int *>(rec->data);
+            rows.emplace_back(data[0], data[1]);
+        }
+        return rows;
+    }
+};
+
+/**
+ * @brief 顺序扫描只返回满足所有条件的记录，包括第一条记录就不满足条件的情况
+ */
+TEST_F(SeqScanExecutorTest, FilterTest) {
+    EXPECT_EQ(NUM_RECORDS, static_cast<int>(scan({}).size()));
+
+    auto rows = scan({make_cond("a", OP_EQ, 1)});
+    EXPECT_EQ(NUM_RECORDS / NUM_GROUPS, static_cast<int>(rows.size()));
+    for (auto &row : rows) {
+        EXPECT_EQ(1, row.first);
+    }
+
+    rows = scan({make_cond("a", OP_NE, 0), make_cond("b", OP_LT, 50)});
+    EXPECT_EQ(40, static_cast<int>(rows.size()));
+    for (auto &row : rows) {
+        EXPECT_NE(0, row.first);
+        EXPECT_LT(row.second, 50);
+    }
+
+    // 同一张表的两个字段比较
+    Condition cond;
+    cond.lhs_col = {TEST_TAB_NAME, "b"};
+    cond.op = OP_EQ;
+    cond.is_rhs_val = false;
+    cond.rhs_col = {TEST_TAB_NAME, "a"};
+    rows = scan({cond});
+    EXPECT_EQ(NUM_GROUPS, static_cast<int>(rows.size()));
+
+    EXPECT_TRUE(scan({make_cond("b", OP_GE, NUM_RECORDS)}).empty());
+}
+
+/**
+ * @brief 与DELETE FROM t WHERE a = 1的执行方式相同：先用顺序扫描收集记录号，再删除，只删除满足条件的记录
+ */
+TEST_F(SeqScanExecutorTest, DeleteWithConditionTest) {
+    std::vector<Condition> conds = {make_cond("a", OP_EQ, 1)};
+    SeqScanExecutor scan_exec(sm_manager_.get(), TEST_TAB_NAME, conds, context_.get());
+    std::vector<Rid> rids;
+    for (scan_exec.beginTuple(); !scan_exec.is_end(); scan_exec.nextTuple()) {
+        rids.push_back(scan_exec.rid());
+    }
+    DeleteExecutor delete_exec(sm_manager_.get(), TEST_TAB_NAME, conds, rids, context_.get());
+    delete_exec.Next();
+
+    auto rows = scan({});
+    EXPECT_EQ(NUM_RECORDS - NUM_RECORDS / NUM_GROUPS, static_cast<int>(rows.size()));
+    for (auto &row : rows) {
+        EXPECT_NE(1, row.first);
+    }
+}
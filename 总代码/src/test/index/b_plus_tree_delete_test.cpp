@@ -491,4 +491,33 @@ TEST_F(BPlusTreeTests, LargeScaleTest) {
     }
     std::cout << "Insert keys count: " << add_cnt << '\n' << "Delete keys count: " << del_cnt << '\n';
     check_all(ih_.get(), mock);
-}
\ No newline at end of file
+}
+/**
+ * @brief 反复插入再删除同一批键值对，合并后释放的结点页面应当被复用，索引文件不再增长
+ */
+TEST_F(BPlusTreeTests, PageReuseTest) {
+    const int order = 4;
+    const int64_t scale = 200;
+
+    assert(order > 2 && order <= ih_->file_hdr_->btree_order_);
+    ih_->file_hdr_->btree_order_ = order;
+
+    int num_pages_after_first_round = 0;
+    for (int round = 0; round < 3; round++) {
+        for (int64_t key = 1; key <= scale; key++) {
+            Rid rid = {.page_no = 0, .slot_no = static_cast<int32_t>(key)};
+            ASSERT_NE(ih_->insert_entry((const char *)&key, rid, txn_.get()), IX_NO_PAGE);
+        }
+        if (round == 0) {
+            num_pages_after_first_round = ih_->file_hdr_->num_pages_;
+        } else {
+            // 第一轮之后新结点全部来自上一轮删除时释放的页面
+            EXPECT_EQ(ih_->file_hdr_->num_pages_, num_pages_after_first_round);
+        }
+        // 保留最后一个键，避免树变成空树
+        for (int64_t key = 1; key < scale; key++) {
+            ASSERT_TRUE(ih_->delete_entry((const char *)&key, txn_.get()));
+        }
+        EXPECT_GT(disk_manager_->get_num_free_pages(ih_->fd_), 0);
+    }
+}
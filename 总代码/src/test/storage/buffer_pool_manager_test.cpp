@@ -1,8 +1,14 @@
 #include "storage/buffer_pool_manager.h"
+#include "storage/buffer_pool_set.h"
 
+#include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cstring>
 #include <ctime>
+#include <fstream>
+#include <random>
+#include <set>
 #include <string>
 #include <thread>
 #include <unordered_map>
@@ -427,3 +433,1047 @@ TEST_F(BufferPoolManagerTest, ConcurrencyTest) {
 
     disk_manager_->close_file(fd);
 }
+
+/**
+ * @brief 测试预读：顺序扫描和显式预读读入的页面内容正确，被预读的已释放页面重新分配后不会残留旧内容
+ */
+TEST_F(BufferPoolManagerTest, ReadaheadTest) {
+    const std::string filename = "readahead_test";
+    const int num_pages = MAX_PAGES * 2;
+    const int buffer_pool_size = MAX_PAGES * 2;
+    auto disk_manager = BufferPoolManagerTest::disk_manager_.get();
+    auto bpm = std::make_unique<BufferPoolManager>(static_cast<size_t>(buffer_pool_size), disk_manager);
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+
+    char buf[PAGE_SIZE] = {};
+    for (int page_no = 0; page_no < num_pages; page_no++) {
+        snprintf(buf, sizeof(buf), "page %d", page_no);
+        disk_manager_->write_page(fd, page_no, buf, PAGE_SIZE);
+    }
+    disk_manager_->set_fd2pageno(fd, num_pages);
+
+    // 显式预读：等待后台线程读入完成，之后访问这些页面都命中缓冲池
+    bpm->prefetch_pages(PageId{fd, num_pages / 2}, num_pages / 2);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (bpm->get_num_prefetched_pages() < static_cast<size_t>(num_pages / 2) &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(bpm->get_num_prefetched_pages(), static_cast<size_t>(num_pages / 2));
+
+    // 顺序扫描整个文件，检测到顺序访问后自动预读
+    for (int page_no = 0; page_no < num_pages; page_no++) {
+        PageId page_id{fd, page_no};
+        Page *page = bpm->fetch_page(page_id);
+        ASSERT_NE(nullptr, page);
+        EXPECT_EQ(std::string(page->get_data()), "page " + std::to_string(page_no));
+        EXPECT_EQ(true, bpm->unpin_page(page_id, false));
+    }
+
+    // 释放的页面被预读进缓冲池后重新分配，new_page得到的是全0的新页面
+    EXPECT_EQ(true, bpm->delete_page(PageId{fd, 0}));
+    bpm->prefetch_pages(PageId{fd, 0}, 1);
+    PageId new_page_id{fd, INVALID_PAGE_ID};
+    Page *page = bpm->new_page(&new_page_id);
+    ASSERT_NE(nullptr, page);
+    EXPECT_EQ(new_page_id.page_no, 0);
+    EXPECT_EQ(page->get_data()[0], 0);
+    EXPECT_EQ(true, bpm->unpin_page(new_page_id, false));
+    page = bpm->fetch_page(new_page_id);
+    ASSERT_NE(nullptr, page);
+    EXPECT_EQ(page->get_data()[0], 0);
+    EXPECT_EQ(true, bpm->unpin_page(new_page_id, false));
+
+    bpm.reset();
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 测试后台写线程：淘汰端的脏页被提前写回磁盘，写回前日志已持久化到页面的page_lsn
+ */
+TEST_F(BufferPoolManagerTest, BackgroundWriterTest) {
+    const std::string filename = "background_writer_test";
+    const int buffer_pool_size = 64;
+    auto disk_manager = BufferPoolManagerTest::disk_manager_.get();
+    auto bpm = std::make_unique<BufferPoolManager>(static_cast<size_t>(buffer_pool_size), disk_manager);
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+
+    std::atomic<lsn_t> flushed_lsn{INVALID_LSN};
+    bpm->register_lsn_file(fd, 0);
+    bpm->set_log_flusher([&flushed_lsn](lsn_t lsn) {
+        lsn_t cur = flushed_lsn.load();
+        while (cur < lsn && !flushed_lsn.compare_exchange_weak(cur, lsn)) {
+        }
+    });
+
+    // 按顺序创建并修改页面，先unpin的页面位于淘汰端
+    std::vector<PageId> page_ids;
+    for (int i = 0; i < buffer_pool_size; i++) {
+        PageId page_id{fd, INVALID_PAGE_ID};
+        Page *page = bpm->new_page(&page_id);
+        ASSERT_NE(nullptr, page);
+        page->set_page_lsn(i + 1);
+        snprintf(page->get_data() + Page::OFFSET_PAGE_HDR, PAGE_SIZE - Page::OFFSET_PAGE_HDR, "page %d", i);
+        page_ids.push_back(page_id);
+    }
+    for (auto &page_id : page_ids) {
+        EXPECT_EQ(true, bpm->unpin_page(page_id, true));
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (bpm->get_num_background_written_pages() == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_GT(bpm->get_num_background_written_pages(), 0);
+
+    // 最先被淘汰的页面已经写回，磁盘上的内容与缓冲池一致，且日志先于页面持久化
+    char buf[PAGE_SIZE];
+    disk_manager_->read_page(fd, page_ids[0].page_no, buf, PAGE_SIZE);
+    EXPECT_EQ(std::string(buf + Page::OFFSET_PAGE_HDR), "page 0");
+    EXPECT_GE(flushed_lsn.load(), *reinterpret_cast<lsn_t *>(buf + Page::OFFSET_LSN));
+    Page *page = bpm->fetch_page(page_ids[0]);
+    ASSERT_NE(nullptr, page);
+    EXPECT_EQ(false, page->is_dirty());
+    EXPECT_EQ(true, bpm->unpin_page(page_ids[0], false));
+
+    bpm.reset();
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 测试写回前刷日志只使用保存了page_lsn的页面：登记文件的文件头页面和没有登记的文件中，
+ * Page::OFFSET_LSN处的数据不作为lsn
+ */
+TEST_F(BufferPoolManagerTest, LogFlusherLsnTest) {
+    auto disk_manager = BufferPoolManagerTest::disk_manager_.get();
+    auto bpm = std::make_unique<BufferPoolManager>(static_cast<size_t>(16), disk_manager);
+    disk_manager_->create_file("lsn_file");
+    disk_manager_->create_file("no_lsn_file");
+    int lsn_fd = disk_manager_->open_file("lsn_file");
+    int no_lsn_fd = disk_manager_->open_file("no_lsn_file");
+    bpm->register_lsn_file(lsn_fd, 1);
+    std::vector<lsn_t> flushed;
+    bpm->set_log_flusher([&flushed](lsn_t lsn) { flushed.push_back(lsn); });
+
+    // 每个文件创建两个页面，OFFSET_LSN处都写入数据，只有lsn_file的第1页的是page_lsn
+    for (int fd : {lsn_fd, no_lsn_fd}) {
+        for (int i = 0; i < 2; i++) {
+            PageId page_id{fd, INVALID_PAGE_ID};
+            Page *page = bpm->new_page(&page_id);
+            ASSERT_NE(nullptr, page);
+            page->set_page_lsn(fd == lsn_fd && page_id.page_no == 1 ? 7 : 1000 + page_id.page_no);
+            bpm->unpin_page(page_id, true);
+        }
+    }
+    bpm->flush_all_pages(no_lsn_fd);
+    EXPECT_TRUE(flushed.empty());
+    bpm->flush_all_pages(lsn_fd);
+    ASSERT_FALSE(flushed.empty());
+    for (lsn_t lsn : flushed) {
+        EXPECT_EQ(7, lsn);
+    }
+
+    bpm.reset();
+    disk_manager_->close_file(lsn_fd);
+    disk_manager_->close_file(no_lsn_fd);
+}
+
+/**
+ * @brief 测试分片缓冲池：多个线程并发地创建、修改和读取落在不同分片上的页面，内容保持正确
+ */
+TEST_F(BufferPoolManagerTest, ShardedConcurrencyTest) {
+    const std::string filename = "sharded_concurrency_test";
+    const int num_threads = 8;
+    const int pages_per_thread = MAX_PAGES;
+    const size_t num_shards = 4;
+    auto disk_manager = BufferPoolManagerTest::disk_manager_.get();
+    // 缓冲池只能容纳一半的页面，页面会在各分片内被淘汰并重新读入
+    auto bpm = std::make_unique<BufferPoolManager>(static_cast<size_t>(num_threads * pages_per_thread / 2),
+                                                   disk_manager, num_shards);
+    EXPECT_EQ(bpm->get_num_shards(), num_shards);
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+
+    std::vector<std::vector<PageId>> page_ids(num_threads);
+    std::vector<std::thread> threads;
+    for (int tid = 0; tid < num_threads; tid++) {
+        threads.emplace_back([&, tid]() {
+            for (int i = 0; i < pages_per_thread; i++) {
+                PageId page_id{fd, INVALID_PAGE_ID};
+                Page *page = bpm->new_page(&page_id);
+                while (page == nullptr) {
+                    page = bpm->new_page(&page_id);
+                }
+                snprintf(page->get_data(), PAGE_SIZE, "page %d", page_id.page_no);
+                EXPECT_EQ(true, bpm->unpin_page(page_id, true));
+                page_ids[tid].push_back(page_id);
+            }
+            for (int round = 0; round < 4; round++) {
+                for (auto &page_id : page_ids[tid]) {
+                    Page *page = bpm->fetch_page(page_id);
+                    while (page == nullptr) {
+                        page = bpm->fetch_page(page_id);
+                    }
+                    EXPECT_EQ(std::string(page->get_data()), "page " + std::to_string(page_id.page_no));
+                    EXPECT_EQ(true, bpm->unpin_page(page_id, false));
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    // 所有页面号互不相同，刷盘后磁盘上的内容正确
+    bpm->flush_all_pages(fd);
+    std::set<page_id_t> page_nos;
+    char buf[PAGE_SIZE];
+    for (auto &ids : page_ids) {
+        for (auto &page_id : ids) {
+            EXPECT_TRUE(page_nos.insert(page_id.page_no).second);
+            disk_manager_->read_page(fd, page_id.page_no, buf, PAGE_SIZE);
+            EXPECT_EQ(std::string(buf), "page " + std::to_string(page_id.page_no));
+        }
+    }
+    EXPECT_EQ(page_nos.size(), static_cast<size_t>(num_threads * pages_per_thread));
+
+    bpm.reset();
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 测试读写磁盘期间释放latch的正确性：缓冲池很小，每个线程反复修改自己的页面，脏页不断被淘汰并与相邻的
+ * 其他线程的页面合并写回，写回期间访问这些页面的线程需要等待写回完成，修改不会丢失
+ */
+TEST_F(BufferPoolManagerTest, IoOutsideLatchTest) {
+    const std::string filename = "io_outside_latch_test";
+    const int num_threads = 4;
+    const int pages_per_thread = 16;
+    const int num_rounds = 50;
+    auto disk_manager = BufferPoolManagerTest::disk_manager_.get();
+    auto bpm = std::make_unique<BufferPoolManager>(static_cast<size_t>(16), disk_manager, 1);
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+    // 页面交错分配给各线程，使一个线程的淘汰页与其他线程的页面相邻
+    for (int i = 0; i < num_threads * pages_per_thread; i++) {
+        PageId page_id{fd, INVALID_PAGE_ID};
+        Page *page = bpm->new_page(&page_id);
+        ASSERT_NE(nullptr, page);
+        snprintf(page->get_data(), PAGE_SIZE, "page %d round -1", page_id.page_no);
+        EXPECT_EQ(true, bpm->unpin_page(page_id, true));
+    }
+
+    std::vector<std::thread> threads;
+    for (int tid = 0; tid < num_threads; tid++) {
+        threads.emplace_back([&, tid]() {
+            for (int round = 0; round < num_rounds; round++) {
+                for (int i = 0; i < pages_per_thread; i++) {
+                    PageId page_id{fd, i * num_threads + tid};
+                    Page *page = bpm->fetch_page(page_id);
+                    while (page == nullptr) {
+                        page = bpm->fetch_page(page_id);
+                    }
+                    std::string expected =
+                        "page " + std::to_string(page_id.page_no) + " round " + std::to_string(round - 1);
+                    EXPECT_EQ(std::string(page->get_data()), expected);
+                    snprintf(page->get_data(), PAGE_SIZE, "page %d round %d", page_id.page_no, round);
+                    EXPECT_EQ(true, bpm->unpin_page(page_id, true));
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    bpm->flush_all_pages(fd);
+    char buf[PAGE_SIZE];
+    for (page_id_t page_no = 0; page_no < num_threads * pages_per_thread; page_no++) {
+        disk_manager_->read_page(fd, page_no, buf, PAGE_SIZE);
+        EXPECT_EQ(std::string(buf), "page " + std::to_string(page_no) + " round " + std::to_string(num_rounds - 1));
+    }
+
+    bpm.reset();
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 测试页面保护：离开作用域或被移动覆盖时自动解锁并取消固定，写保护独占页面，读保护可以同时持有
+ */
+TEST_F(BufferPoolManagerTest, PageGuardTest) {
+    const std::string filename = "page_guard_test";
+    const int buffer_pool_size = 4;
+    auto disk_manager = BufferPoolManagerTest::disk_manager_.get();
+    auto bpm = std::make_unique<BufferPoolManager>(static_cast<size_t>(buffer_pool_size), disk_manager);
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+
+    // 反复创建和读取远多于缓冲池帧数的页面，保护自动取消固定，缓冲池不会耗尽
+    std::vector<PageId> page_ids;
+    for (int i = 0; i < buffer_pool_size * 8; i++) {
+        PageId page_id{fd, INVALID_PAGE_ID};
+        WritePageGuard guard = bpm->new_page_guarded(&page_id);
+        ASSERT_TRUE(guard.is_valid());
+        snprintf(guard.get_data_mut(), PAGE_SIZE, "page %d", page_id.page_no);
+        page_ids.push_back(page_id);
+    }
+    for (auto &page_id : page_ids) {
+        ReadPageGuard guard = bpm->fetch_page_read(page_id);
+        ASSERT_TRUE(guard.is_valid());
+        EXPECT_EQ(std::string(guard.get_data()), "page " + std::to_string(page_id.page_no));
+    }
+
+    // 移动后原保护不再持有页面，页面只被取消固定一次
+    {
+        ReadPageGuard first = bpm->fetch_page_read(page_ids[0]);
+        ReadPageGuard second = std::move(first);
+        EXPECT_FALSE(first.is_valid());
+        EXPECT_TRUE(second.is_valid());
+        second.drop();
+        EXPECT_FALSE(second.is_valid());
+        EXPECT_FALSE(bpm->unpin_page(page_ids[0], false));
+    }
+
+    // 写保护持有期间其他线程无法读取页面，释放后读到修改后的内容
+    WritePageGuard writer = bpm->fetch_page_write(page_ids[1]);
+    std::atomic<bool> read_done{false};
+    std::string read_data;
+    std::thread reader([&]() {
+        ReadPageGuard guard = bpm->fetch_page_read(page_ids[1]);
+        read_data = guard.get_data();
+        read_done = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(read_done);
+    snprintf(writer.get_data_mut(), PAGE_SIZE, "modified");
+    writer.drop();
+    reader.join();
+    EXPECT_EQ(read_data, "modified");
+
+    // 两个线程可以同时持有同一页面的读保护
+    ReadPageGuard shared = bpm->fetch_page_read(page_ids[2]);
+    std::thread other_reader([&]() {
+        ReadPageGuard guard = bpm->fetch_page_read(page_ids[2]);
+        EXPECT_TRUE(guard.is_valid());
+    });
+    other_reader.join();
+    shared.drop();
+
+    bpm.reset();
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 测试写回被使用中的页面：写保护持有期间flush_page()等待，释放后写入磁盘的是修改完成的页面。
+ * 写保护先释放页面锁再以脏页取消固定，写回可能在两者之间完成，之后页面仍可能为脏页，不检查脏标记
+ */
+TEST_F(BufferPoolManagerTest, FlushLatchedPageTest) {
+    const std::string filename = "flush_latched_page_test";
+    auto disk_manager = BufferPoolManagerTest::disk_manager_.get();
+    auto bpm = std::make_unique<BufferPoolManager>(static_cast<size_t>(4), disk_manager);
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+    PageId page_id{fd, INVALID_PAGE_ID};
+    {
+        WritePageGuard guard = bpm->new_page_guarded(&page_id);
+        ASSERT_TRUE(guard.is_valid());
+        memset(guard.get_data_mut(), 'a', PAGE_SIZE);
+    }
+
+    WritePageGuard writer = bpm->fetch_page_write(page_id);
+    memset(writer.get_data_mut(), 'b', PAGE_SIZE / 2);
+    std::atomic<bool> flush_done{false};
+    std::thread flusher([&]() {
+        EXPECT_TRUE(bpm->flush_page(page_id));
+        flush_done = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(flush_done);
+    memset(writer.get_data_mut() + PAGE_SIZE / 2, 'b', PAGE_SIZE / 2);
+    writer.drop();
+    flusher.join();
+
+    char buf[PAGE_SIZE];
+    disk_manager->read_page(fd, page_id.page_no, buf, PAGE_SIZE);
+    EXPECT_EQ(std::string(buf, PAGE_SIZE), std::string(PAGE_SIZE, 'b'));
+
+    bpm.reset();
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 测试乐观读：页面没有被修改时验证通过；读取期间有写者修改页面时验证失败，重新开始后读到新内容。
+ * 并发时只有验证通过的读取结果被使用，它们总是一致的
+ */
+TEST_F(BufferPoolManagerTest, OptimisticReadTest) {
+    const std::string filename = "optimistic_read_test";
+    auto disk_manager = BufferPoolManagerTest::disk_manager_.get();
+    auto bpm = std::make_unique<BufferPoolManager>(static_cast<size_t>(4), disk_manager);
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+    PageId page_id{fd, INVALID_PAGE_ID};
+    {
+        WritePageGuard guard = bpm->new_page_guarded(&page_id);
+        ASSERT_TRUE(guard.is_valid());
+        memset(guard.get_data_mut(), 'a', PAGE_SIZE);
+    }
+
+    OptimisticPageGuard reader = bpm->fetch_page_optimistic(page_id);
+    ASSERT_TRUE(reader.is_valid());
+    EXPECT_EQ('a', reader.get_data()[PAGE_SIZE - 1]);
+    EXPECT_TRUE(reader.validate());
+    {
+        WritePageGuard writer = bpm->fetch_page_write(page_id);
+        memset(writer.get_data_mut(), 'b', PAGE_SIZE);
+    }
+    EXPECT_FALSE(reader.validate());
+    reader.begin_read();
+    EXPECT_EQ('b', reader.get_data()[PAGE_SIZE - 1]);
+    EXPECT_TRUE(reader.validate());
+    reader.drop();
+
+    // 写者不断把整个页面改写为同一个字符，读者验证通过的副本中所有字节都相同
+    std::atomic<bool> stop{false};
+    std::thread writer([&]() {
+        for (int round = 0; !stop; round++) {
+            WritePageGuard guard = bpm->fetch_page_write(page_id);
+            memset(guard.get_data_mut(), 'a' + round % 26, PAGE_SIZE);
+        }
+    });
+    std::vector<char> copy(PAGE_SIZE);
+    int num_validated = 0;
+    for (int i = 0; i < 2000; i++) {
+        OptimisticPageGuard guard = bpm->fetch_page_optimistic(page_id);
+        memcpy(copy.data(), guard.get_data(), PAGE_SIZE);
+        if (!guard.validate()) {
+            continue;
+        }
+        num_validated++;
+        EXPECT_EQ(copy[0], copy[PAGE_SIZE - 1]);
+        EXPECT_EQ(copy[0], copy[PAGE_SIZE / 2]);
+    }
+    stop = true;
+    writer.join();
+    EXPECT_GT(num_validated, 0);
+
+    bpm.reset();
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 测试按文件刷盘和丢弃页面：flush_all_pages只写回该文件的脏页，不影响其他文件；
+ * drop_all_pages把文件的页面移出缓冲池，脏页不写回，释放的帧可以被其他页面使用
+ */
+TEST_F(BufferPoolManagerTest, FileFlushAndDropTest) {
+    const int num_pages = 8;
+    auto bpm = std::make_unique<BufferPoolManager>(static_cast<size_t>(4 * num_pages), disk_manager_.get());
+    std::vector<int> fds;
+    for (int i = 0; i < 2; i++) {
+        std::string filename = "file_flush_drop_test_" + std::to_string(i);
+        if (disk_manager_->is_file(filename)) {
+            disk_manager_->destroy_file(filename);
+        }
+        disk_manager_->create_file(filename);
+        fds.push_back(disk_manager_->open_file(filename));
+    }
+    // 两个文件的页面先以'a'写入磁盘，再在缓冲池中改为'b'成为脏页
+    for (int fd : fds) {
+        for (int i = 0; i < num_pages; i++) {
+            PageId page_id{fd, INVALID_PAGE_ID};
+            Page *page = bpm->new_page(&page_id);
+            ASSERT_NE(nullptr, page);
+            memset(page->get_data(), 'a', PAGE_SIZE);
+            bpm->unpin_page(page_id, true);
+        }
+        bpm->flush_all_pages(fd);
+        for (int page_no = 0; page_no < num_pages; page_no++) {
+            Page *page = bpm->fetch_page(PageId{fd, page_no});
+            memset(page->get_data(), 'b', PAGE_SIZE);
+            bpm->unpin_page(page->get_page_id(), true);
+        }
+    }
+
+    char buf[PAGE_SIZE];
+    bpm->flush_all_pages(fds[0]);
+    for (int page_no = 0; page_no < num_pages; page_no++) {
+        disk_manager_->read_page(fds[0], page_no, buf, PAGE_SIZE);
+        EXPECT_EQ('b', buf[PAGE_SIZE - 1]);
+        disk_manager_->read_page(fds[1], page_no, buf, PAGE_SIZE);
+        EXPECT_EQ('a', buf[PAGE_SIZE - 1]);
+    }
+
+    // 丢弃第二个文件的页面后，它的修改不会写回，重新读取得到磁盘上的内容
+    bpm->drop_all_pages(fds[1]);
+    bpm->flush_all_pages(fds[1]);
+    for (int page_no = 0; page_no < num_pages; page_no++) {
+        disk_manager_->read_page(fds[1], page_no, buf, PAGE_SIZE);
+        EXPECT_EQ('a', buf[PAGE_SIZE - 1]);
+        Page *page = bpm->fetch_page(PageId{fds[1], page_no});
+        ASSERT_NE(nullptr, page);
+        EXPECT_EQ('a', page->get_data()[PAGE_SIZE - 1]);
+        bpm->unpin_page(page->get_page_id(), false);
+    }
+    // 第一个文件的页面仍在缓冲池中
+    Page *page = bpm->fetch_page(PageId{fds[0], 0});
+    EXPECT_EQ('b', page->get_data()[PAGE_SIZE - 1]);
+    bpm->unpin_page(page->get_page_id(), false);
+
+    bpm.reset();
+    for (int fd : fds) {
+        disk_manager_->close_file(fd);
+    }
+}
+
+/**
+ * @brief 测试在线调整缓冲池大小：缩小时先淘汰干净页，脏页不写回也不丢失；缩小后最多只能同时固定新大小个页面，
+ * 扩大后可以固定更多页面；调整大小与其他线程的访问并发进行时页面内容始终正确
+ */
+TEST_F(BufferPoolManagerTest, ResizeTest) {
+    const std::string filename = "resize_test";
+    const int num_pages = 256;
+    auto bpm = std::make_unique<BufferPoolManager>(static_cast<size_t>(64), disk_manager_.get(), 2, "LRU",
+                                                   static_cast<size_t>(num_pages));
+    EXPECT_EQ(64, bpm->get_pool_size());
+    EXPECT_EQ(num_pages, bpm->get_max_pool_size());
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+    // 每个页面的内容为'a' + page_no % 26，写入磁盘后缓冲池中只剩最后64个页面
+    for (int i = 0; i < num_pages; i++) {
+        PageId page_id{fd, INVALID_PAGE_ID};
+        Page *page = bpm->new_page(&page_id);
+        ASSERT_NE(nullptr, page);
+        memset(page->get_data(), 'a' + page_id.page_no % 26, PAGE_SIZE);
+        bpm->unpin_page(page_id, true);
+    }
+    bpm->flush_all_pages(fd);
+    // 把最后16个页面改为'#'成为脏页
+    for (int page_no = num_pages - 16; page_no < num_pages; page_no++) {
+        Page *page = bpm->fetch_page(PageId{fd, page_no});
+        memset(page->get_data(), '#', PAGE_SIZE);
+        bpm->unpin_page(page->get_page_id(), true);
+    }
+    auto expected = [&](int page_no) { return page_no >= num_pages - 16 ? '#' : static_cast<char>('a' + page_no % 26); };
+
+    // 缩小时淘汰的都是干净页，脏页还没有写回磁盘
+    bpm->resize(48);
+    EXPECT_EQ(48, bpm->get_pool_size());
+    char buf[PAGE_SIZE];
+    for (int page_no = num_pages - 16; page_no < num_pages; page_no++) {
+        disk_manager_->read_page(fd, page_no, buf, PAGE_SIZE);
+        EXPECT_EQ('a' + page_no % 26, buf[0]);
+    }
+
+    // 继续缩小，之后最多同时固定16个页面
+    bpm->resize(16);
+    EXPECT_EQ(16, bpm->get_pool_size());
+    std::vector<Page *> pinned;
+    for (int page_no = 0; page_no < num_pages; page_no++) {
+        Page *page = bpm->fetch_page(PageId{fd, page_no});
+        if (page == nullptr) {
+            break;
+        }
+        EXPECT_EQ(expected(page_no), page->get_data()[PAGE_SIZE - 1]);
+        pinned.push_back(page);
+    }
+    EXPECT_GE(16u, pinned.size());
+    EXPECT_LE(8u, pinned.size());
+    for (Page *page : pinned) {
+        bpm->unpin_page(page->get_page_id(), false);
+    }
+
+    // 扩大到上限后可以同时固定更多页面（页面在分片间分布不均匀，只固定四分之一）
+    bpm->resize(num_pages);
+    pinned.clear();
+    for (int page_no = 0; page_no < num_pages / 4; page_no++) {
+        Page *page = bpm->fetch_page(PageId{fd, page_no});
+        ASSERT_NE(nullptr, page);
+        EXPECT_EQ(expected(page_no), page->get_data()[PAGE_SIZE - 1]);
+        pinned.push_back(page);
+    }
+    for (Page *page : pinned) {
+        bpm->unpin_page(page->get_page_id(), false);
+    }
+    EXPECT_THROW(bpm->resize(num_pages + 1), InternalError);
+    EXPECT_THROW(bpm->resize(1), InternalError);
+
+    // 被固定的页面放不进缩小后的帧时，resize()等待它们被取消固定后再完成
+    pinned.clear();
+    for (int page_no = 0; page_no < 8; page_no++) {
+        pinned.push_back(bpm->fetch_page(PageId{fd, page_no}));
+        ASSERT_NE(nullptr, pinned.back());
+    }
+    std::atomic<bool> resized{false};
+    std::thread resizer([&]() {
+        bpm->resize(2);
+        resized = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(resized);
+    for (Page *page : pinned) {
+        bpm->unpin_page(page->get_page_id(), false);
+    }
+    resizer.join();
+    EXPECT_EQ(2, bpm->get_pool_size());
+    bpm->resize(num_pages);
+
+    // 调整大小的同时，其他线程随机读取页面
+    std::atomic<bool> stop{false};
+    std::atomic<int> num_errors{0};
+    std::vector<std::thread> readers;
+    for (int tid = 0; tid < 4; tid++) {
+        readers.emplace_back([&, tid]() {
+            std::mt19937 rng(tid);
+            std::uniform_int_distribution<int> dist(0, num_pages - 1);
+            while (!stop) {
+                int page_no = dist(rng);
+                Page *page = bpm->fetch_page(PageId{fd, page_no});
+                if (page == nullptr) {
+                    continue;
+                }
+                if (page->get_data()[0] != expected(page_no)) {
+                    num_errors++;
+                }
+                bpm->unpin_page(page->get_page_id(), false);
+            }
+        });
+    }
+    for (size_t new_size : {32, 200, 8, 128, 64}) {
+        bpm->resize(new_size);
+    }
+    stop = true;
+    for (auto &reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(0, num_errors.load());
+    EXPECT_EQ(64, bpm->get_pool_size());
+
+    bpm.reset();
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 测试重启后预热缓冲池：转储文件按热度排列；新的缓冲池按热度在后台读入页面，只使用空闲帧，
+ * 不会淘汰已经被访问的页面。预热后修改磁盘上的页面，从缓冲池中读到的仍是原内容，说明页面已在缓冲池中
+ */
+TEST_F(BufferPoolManagerTest, WarmRestartTest) {
+    const std::string filename = "warm_restart_test";
+    const std::string dump_file = "warm_restart_test.dump";
+    const int num_pages = 256;
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+    auto bpm = std::make_unique<BufferPoolManager>(static_cast<size_t>(64), disk_manager_.get(), 1);
+    // 没有转储文件时不预热
+    EXPECT_EQ(0, bpm->warm_up(dump_file));
+    for (int i = 0; i < num_pages; i++) {
+        PageId page_id{fd, INVALID_PAGE_ID};
+        Page *page = bpm->new_page(&page_id);
+        ASSERT_NE(nullptr, page);
+        memset(page->get_data(), 'a' + page_id.page_no % 26, PAGE_SIZE);
+        bpm->unpin_page(page_id, true);
+    }
+    bpm->flush_all_pages(fd);
+    // 写完所有页面后再访问页面0、2、...、30，缓冲池中最热的是它们，其次是最后写入的页面。间隔访问避免触发顺序预读
+    for (int page_no = 0; page_no < 32; page_no += 2) {
+        Page *page = bpm->fetch_page(PageId{fd, page_no});
+        bpm->unpin_page(page->get_page_id(), false);
+    }
+    EXPECT_EQ(64, bpm->dump_resident_pages(dump_file));
+    std::ifstream ifs(dump_file);
+    std::string file_name;
+    int page_no;
+    double heat;
+    ASSERT_TRUE(ifs >> file_name >> page_no >> heat);
+    EXPECT_EQ(filename, file_name);
+    EXPECT_EQ(30, page_no);
+    EXPECT_DOUBLE_EQ(1.0, heat);
+    ifs.close();
+
+    // 重启后的缓冲池只有32个帧，预热前客户端已经读入了8个页面
+    bpm = std::make_unique<BufferPoolManager>(static_cast<size_t>(32), disk_manager_.get(), 1);
+    for (int cold_page_no = 100; cold_page_no < 116; cold_page_no += 2) {
+        Page *page = bpm->fetch_page(PageId{fd, cold_page_no});
+        bpm->unpin_page(page->get_page_id(), false);
+    }
+    EXPECT_EQ(32, bpm->warm_up(dump_file));
+    bpm->wait_for_warm_up();
+    EXPECT_EQ(24, bpm->get_num_prefetched_pages());
+
+    char buf[PAGE_SIZE];
+    memset(buf, '#', PAGE_SIZE);
+    for (int i = 0; i < num_pages; i++) {
+        disk_manager_->write_page(fd, i, buf, PAGE_SIZE);
+    }
+    // 客户端读入的页面和最热的页面都在缓冲池中
+    for (int resident_page_no : {0, 14, 30, 100, 114, 240}) {
+        Page *page = bpm->fetch_page(PageId{fd, resident_page_no});
+        EXPECT_EQ('a' + resident_page_no % 26, page->get_data()[0]);
+        bpm->unpin_page(page->get_page_id(), false);
+    }
+    Page *page = bpm->fetch_page(PageId{fd, 50});
+    EXPECT_EQ('#', page->get_data()[0]);
+    bpm->unpin_page(page->get_page_id(), false);
+
+    bpm.reset();
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 测试pointer swizzling：第一次访问经过页表并swizzle页面，之后直接通过引用访问且不固定页面；
+ * replacer选中被swizzle的页面时先冷却，页面留在缓冲池中，再次访问时重新swizzle；页面离开帧时引用被清空，
+ * 之前得到的未固定保护验证失败
+ */
+TEST_F(BufferPoolManagerTest, SwizzleTest) {
+    const std::string filename = "swizzle_test";
+    const size_t pool_size = 16;
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+    auto bpm = std::make_unique<BufferPoolManager>(pool_size, disk_manager_.get(), 1);
+    auto swips = std::make_unique<SwipTable>(bpm.get(), fd);
+    const int num_pages = 64;
+    for (int i = 0; i < num_pages; i++) {
+        PageId page_id{fd, INVALID_PAGE_ID};
+        Page *page = bpm->new_page(&page_id);
+        ASSERT_NE(nullptr, page);
+        memset(page->get_data(), 'a' + page_id.page_no % 26, PAGE_SIZE);
+        bpm->unpin_page(page_id, true);
+    }
+    bpm->flush_all_pages(fd);
+
+    // 第一次访问固定页面并swizzle它，第二次直接通过引用得到同一个帧
+    PageId hot{fd, 0};
+    Page *frame = nullptr;
+    {
+        OptimisticPageGuard guard = bpm->fetch_page_swizzled(hot, swips.get());
+        ASSERT_TRUE(guard.is_valid());
+        EXPECT_TRUE(guard.is_pinned());
+        frame = guard.get_page();
+    }
+    EXPECT_EQ(frame, swips->get(hot.page_no));
+    {
+        OptimisticPageGuard guard = bpm->fetch_page_swizzled(hot, swips.get());
+        EXPECT_FALSE(guard.is_pinned());
+        EXPECT_EQ(frame, guard.get_page());
+        EXPECT_EQ('a', guard.get_data()[PAGE_SIZE - 1]);
+        EXPECT_TRUE(guard.validate());
+    }
+
+    // 页面0最久没有经过replacer，被选中时冷却而不是淘汰，留在缓冲池中
+    for (int page_no = 2; page_no < 2 + static_cast<int>(pool_size) * 2; page_no += 2) {
+        Page *page = bpm->fetch_page(PageId{fd, page_no});
+        ASSERT_NE(nullptr, page);
+        bpm->unpin_page(page->get_page_id(), false);
+        if (swips->get(hot.page_no) == nullptr) {
+            break;
+        }
+    }
+    EXPECT_EQ(nullptr, swips->get(hot.page_no));
+    {
+        OptimisticPageGuard guard = bpm->fetch_page_swizzled(hot, swips.get());
+        EXPECT_TRUE(guard.is_pinned());
+        EXPECT_EQ(frame, guard.get_page());
+    }
+    EXPECT_EQ(frame, swips->get(hot.page_no));
+
+    // 页面离开帧后引用被清空，之前得到的未固定保护验证失败
+    OptimisticPageGuard stale = bpm->fetch_page_swizzled(hot, swips.get());
+    EXPECT_FALSE(stale.is_pinned());
+    bpm->drop_all_pages(fd);
+    EXPECT_EQ(nullptr, swips->get(hot.page_no));
+    EXPECT_FALSE(stale.validate());
+    stale.drop();
+
+    // 多个线程通过引用并发读取，同时有线程访问其他页面使被swizzle的页面不断冷却、淘汰
+    std::atomic<bool> stop{false};
+    std::atomic<int> num_errors{0};
+    std::vector<std::thread> readers;
+    for (int tid = 0; tid < 3; tid++) {
+        readers.emplace_back([&, tid]() {
+            std::mt19937 rng(tid);
+            std::uniform_int_distribution<int> dist(0, 7);
+            while (!stop) {
+                int page_no = dist(rng);
+                while (true) {
+                    OptimisticPageGuard guard = bpm->fetch_page_swizzled(PageId{fd, page_no}, swips.get());
+                    char ch = guard.get_data()[PAGE_SIZE / 2];
+                    if (guard.validate()) {
+                        if (ch != 'a' + page_no % 26) {
+                            num_errors++;
+                        }
+                        break;
+                    }
+                }
+            }
+        });
+    }
+    for (int round = 0; round < 200; round++) {
+        Page *page = bpm->fetch_page(PageId{fd, 8 + round % (num_pages - 8)});
+        if (page != nullptr) {
+            bpm->unpin_page(page->get_page_id(), false);
+        }
+    }
+    stop = true;
+    for (auto &reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(0, num_errors.load());
+
+    swips.reset();
+    bpm.reset();
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 测试每种置换策略下缓冲池的页面内容都正确，被固定的页面不会被淘汰
+ */
+TEST_F(BufferPoolManagerTest, ReplacerTypeTest) {
+    const int buffer_pool_size = 16;
+    const int num_pages = 256;
+    auto disk_manager = BufferPoolManagerTest::disk_manager_.get();
+    for (const std::string replacer_type : {"LRU", "CLOCK", "LRU-K", "ARC"}) {
+        const std::string filename = "replacer_type_test_" + replacer_type;
+        auto bpm = std::make_unique<BufferPoolManager>(static_cast<size_t>(buffer_pool_size), disk_manager, 0,
+                                                       replacer_type);
+        disk_manager_->create_file(filename);
+        int fd = disk_manager_->open_file(filename);
+
+        // 页面0一直被固定
+        PageId pinned_page_id{fd, INVALID_PAGE_ID};
+        Page *pinned_page = bpm->new_page(&pinned_page_id);
+        ASSERT_NE(nullptr, pinned_page);
+        snprintf(pinned_page->get_data(), PAGE_SIZE, "pinned");
+        for (int i = 1; i < num_pages; i++) {
+            PageId page_id{fd, INVALID_PAGE_ID};
+            Page *page = bpm->new_page(&page_id);
+            ASSERT_NE(nullptr, page);
+            snprintf(page->get_data(), PAGE_SIZE, "page %d", page_id.page_no);
+            EXPECT_EQ(true, bpm->unpin_page(page_id, true));
+        }
+        srand(0);
+        for (int i = 0; i < num_pages * 4; i++) {
+            // 一半的访问落在前几个页面上，其余随机
+            page_id_t page_no = i % 2 == 0 ? 1 + rand() % 4 : 1 + rand() % (num_pages - 1);
+            Page *page = bpm->fetch_page(PageId{fd, page_no});
+            ASSERT_NE(nullptr, page) << replacer_type;
+            EXPECT_EQ(std::string(page->get_data()), "page " + std::to_string(page_no)) << replacer_type;
+            EXPECT_EQ(true, bpm->unpin_page(PageId{fd, page_no}, false));
+        }
+        EXPECT_EQ(pinned_page, bpm->fetch_page(pinned_page_id));
+        EXPECT_EQ(std::string(pinned_page->get_data()), "pinned");
+        EXPECT_EQ(true, bpm->unpin_page(pinned_page_id, true));
+        EXPECT_EQ(true, bpm->unpin_page(pinned_page_id, true));
+
+        bpm.reset();
+        disk_manager_->close_file(fd);
+    }
+    EXPECT_THROW(BufferPoolManager(buffer_pool_size, disk_manager, 0, "MRU"), InternalError);
+}
+
+/**
+ * @brief 测试缓冲池访问策略：使用私有环扫描一个比缓冲池大得多的文件时，扫描只循环使用环中的帧，
+ * 之前读入缓冲池的热点页面不会被淘汰；不使用访问策略的扫描则会把它们挤出缓冲池
+ */
+TEST_F(BufferPoolManagerTest, BufferAccessStrategyTest) {
+    const int buffer_pool_size = 64;
+    const int num_hot_pages = 16;
+    const int num_scan_pages = 256;
+    auto disk_manager = BufferPoolManagerTest::disk_manager_.get();
+    char buf[PAGE_SIZE];
+
+    const std::string scan_filename = "strategy_scan_file";
+    disk_manager_->create_file(scan_filename);
+    int scan_fd = disk_manager_->open_file(scan_filename);
+    for (int i = 0; i < num_scan_pages; i++) {
+        page_id_t page_no = disk_manager_->allocate_page(scan_fd);
+        memset(buf, 0, PAGE_SIZE);
+        snprintf(buf, PAGE_SIZE, "scan %d", page_no);
+        disk_manager_->write_page(scan_fd, page_no, buf, PAGE_SIZE);
+    }
+
+    for (bool use_strategy : {true, false}) {
+        const std::string hot_filename = use_strategy ? "strategy_hot_file" : "no_strategy_hot_file";
+        auto bpm = std::make_unique<BufferPoolManager>(static_cast<size_t>(buffer_pool_size), disk_manager);
+        disk_manager_->create_file(hot_filename);
+        int hot_fd = disk_manager_->open_file(hot_filename);
+        for (int i = 0; i < num_hot_pages; i++) {
+            PageId page_id{hot_fd, INVALID_PAGE_ID};
+            Page *page = bpm->new_page(&page_id);
+            ASSERT_NE(nullptr, page);
+            snprintf(page->get_data(), PAGE_SIZE, "hot %d", page_id.page_no);
+            EXPECT_EQ(true, bpm->unpin_page(page_id, true));
+        }
+        bpm->flush_all_pages(hot_fd);
+        // 热点页面在缓冲池中是干净的，改写磁盘上的内容：之后读到"stale"说明页面被淘汰后重新读盘
+        for (int i = 0; i < num_hot_pages; i++) {
+            memset(buf, 0, PAGE_SIZE);
+            snprintf(buf, PAGE_SIZE, "stale %d", i);
+            disk_manager_->write_page(hot_fd, i, buf, PAGE_SIZE);
+        }
+
+        BufferAccessStrategy strategy(BufferAccessType::BULK_READ);
+        for (int i = 0; i < num_scan_pages; i++) {
+            Page *page = bpm->fetch_page(PageId{scan_fd, i}, use_strategy ? &strategy : nullptr);
+            ASSERT_NE(nullptr, page);
+            EXPECT_EQ(std::string(page->get_data()), "scan " + std::to_string(i));
+            EXPECT_EQ(true, bpm->unpin_page(PageId{scan_fd, i}, false));
+        }
+
+        int num_hot_resident = 0;
+        for (int i = 0; i < num_hot_pages; i++) {
+            Page *page = bpm->fetch_page(PageId{hot_fd, i});
+            ASSERT_NE(nullptr, page);
+            num_hot_resident += std::string(page->get_data()) == "hot " + std::to_string(i);
+            EXPECT_EQ(true, bpm->unpin_page(PageId{hot_fd, i}, false));
+        }
+        if (use_strategy) {
+            EXPECT_EQ(num_hot_pages, num_hot_resident);
+            EXPECT_GT(strategy.get_num_reused_frames(), 0);
+        } else {
+            EXPECT_EQ(0, num_hot_resident);
+        }
+
+        bpm.reset();
+        disk_manager_->close_file(hot_fd);
+    }
+    disk_manager_->close_file(scan_fd);
+}
+
+/**
+ * @brief 测试具名缓冲池：不同缓冲池中的文件互不挤占帧，大表在默认缓冲池中扫描后，
+ * 另一个缓冲池中的索引页面仍然常驻；只能按名称取得已创建的缓冲池
+ */
+TEST_F(BufferPoolManagerTest, BufferPoolSetTest) {
+    const std::string audit_filename = "buffer_pool_set_audit";
+    const std::string index_filename = "buffer_pool_set_index";
+    const int num_audit_pages = 128;
+    const int num_index_pages = 16;
+    disk_manager_->create_file(audit_filename);
+    disk_manager_->create_file(index_filename);
+    int audit_fd = disk_manager_->open_file(audit_filename);
+    int index_fd = disk_manager_->open_file(index_filename);
+
+    auto default_pool = std::make_unique<BufferPoolManager>(static_cast<size_t>(32), disk_manager_.get(), 1);
+    BufferPoolSet pools(disk_manager_.get(), default_pool.get());
+    pools.create_pool("index_pool", num_index_pages, "LRU-K");
+    EXPECT_THROW(pools.create_pool("index_pool", num_index_pages), BufferPoolExistsError);
+    EXPECT_THROW(pools.create_pool(DEFAULT_BUFFER_POOL, num_index_pages), BufferPoolExistsError);
+    EXPECT_THROW(pools.get_pool("audit_pool"), BufferPoolNotFoundError);
+    EXPECT_EQ(default_pool.get(), pools.get_pool(DEFAULT_BUFFER_POOL));
+    EXPECT_EQ((std::vector<std::string>{DEFAULT_BUFFER_POOL, "index_pool"}), pools.get_pool_names());
+
+    BufferPoolManager *index_pool = pools.get_pool("index_pool");
+    EXPECT_EQ(num_index_pages, index_pool->get_pool_size());
+    for (int i = 0; i < num_index_pages; i++) {
+        PageId page_id{index_fd, INVALID_PAGE_ID};
+        Page *page = index_pool->new_page(&page_id);
+        ASSERT_NE(nullptr, page);
+        memset(page->get_data(), 'i', PAGE_SIZE);
+        EXPECT_EQ(true, index_pool->unpin_page(page_id, true));
+    }
+    index_pool->flush_all_pages(index_fd);
+    // 审计表写满默认缓冲池好几遍
+    for (int i = 0; i < num_audit_pages; i++) {
+        PageId page_id{audit_fd, INVALID_PAGE_ID};
+        Page *page = default_pool->new_page(&page_id);
+        ASSERT_NE(nullptr, page);
+        memset(page->get_data(), 'a', PAGE_SIZE);
+        EXPECT_EQ(true, default_pool->unpin_page(page_id, true));
+    }
+
+    char buf[PAGE_SIZE];
+    memset(buf, '#', PAGE_SIZE);
+    disk_manager_->write_page(audit_fd, 0, buf, PAGE_SIZE);
+    for (int i = 0; i < num_index_pages; i++) {
+        disk_manager_->write_page(index_fd, i, buf, PAGE_SIZE);
+    }
+    // 索引页面都还在自己的缓冲池中，审计表最早的页面已经被淘汰
+    for (int i = 0; i < num_index_pages; i++) {
+        Page *page = index_pool->fetch_page(PageId{index_fd, i});
+        ASSERT_NE(nullptr, page);
+        EXPECT_EQ('i', page->get_data()[0]);
+        EXPECT_EQ(true, index_pool->unpin_page(PageId{index_fd, i}, false));
+    }
+    Page *page = default_pool->fetch_page(PageId{audit_fd, 0});
+    ASSERT_NE(nullptr, page);
+    EXPECT_EQ('#', page->get_data()[0]);
+    EXPECT_EQ(true, default_pool->unpin_page(PageId{audit_fd, 0}, false));
+
+    index_pool->drop_all_pages(index_fd);
+    pools.drop_pool("index_pool");
+    EXPECT_FALSE(pools.is_pool("index_pool"));
+    EXPECT_THROW(pools.drop_pool("index_pool"), BufferPoolNotFoundError);
+    EXPECT_THROW(pools.drop_pool(DEFAULT_BUFFER_POOL), InternalError);
+
+    default_pool->drop_all_pages(audit_fd);
+    default_pool.reset();
+    disk_manager_->close_file(audit_fd);
+    disk_manager_->close_file(index_fd);
+}
+
+/**
+ * @brief 测试共享内存中的缓冲池：进程退出后帧仍保留在共享内存段中，新的缓冲池接管其中干净、未被固定的页面，
+ * 不再从磁盘读取；退出时为脏或被固定的页面不接管。重新打开文件后文件句柄变化，页面所在的分片随之变化
+ */
+TEST_F(BufferPoolManagerTest, SharedBufferPoolTest) {
+    const std::string filename = "shared_buffer_pool_test";
+    const std::string segment = "/unibase_bpm_test_" + std::to_string(getpid());
+    const int num_pages = 64;
+    SharedFrameSegment::destroy(segment);
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+    auto bpm = std::make_unique<BufferPoolManager>(static_cast<size_t>(128), disk_manager_.get(), 2, REPLACER_TYPE, 0,
+                                                   segment);
+    EXPECT_TRUE(bpm->is_shared());
+    EXPECT_EQ(FramePageType::SHARED, bpm->get_frame_page_type());
+    // 同一个段不能被两个缓冲池同时使用
+    EXPECT_THROW(BufferPoolManager(128, disk_manager_.get(), 2, REPLACER_TYPE, 0, segment), InternalError);
+    for (int i = 0; i < num_pages; i++) {
+        PageId page_id{fd, INVALID_PAGE_ID};
+        Page *page = bpm->new_page(&page_id);
+        ASSERT_NE(nullptr, page);
+        memset(page->get_data() + sizeof(lsn_t), 'a' + page_id.page_no % 26, PAGE_SIZE - sizeof(lsn_t));
+        bpm->unpin_page(page_id, true);
+    }
+    bpm->flush_all_pages(fd);
+    // 退出时页面1被修改过还没有写回，页面2仍被固定
+    Page *dirty_page = bpm->fetch_page(PageId{fd, 1});
+    dirty_page->get_data()[PAGE_SIZE - 1] = '!';
+    bpm->unpin_page(PageId{fd, 1}, true);
+    bpm->fetch_page(PageId{fd, 2});
+    // 模拟进程退出：没有关闭文件，页面留在缓冲池中
+    bpm.reset();
+
+    char buf[PAGE_SIZE];
+    memset(buf, '#', PAGE_SIZE);
+    for (int i = 0; i < num_pages; i++) {
+        disk_manager_->write_page(fd, i, buf, PAGE_SIZE);
+    }
+    // 先打开另一个文件，使重新打开后的文件句柄与之前不同
+    disk_manager_->close_file(fd);
+    disk_manager_->create_file(filename + "_other");
+    int other_fd = disk_manager_->open_file(filename + "_other");
+    fd = disk_manager_->open_file(filename);
+    disk_manager_->set_fd2pageno(fd, num_pages);
+
+    bpm = std::make_unique<BufferPoolManager>(static_cast<size_t>(128), disk_manager_.get(), 2, REPLACER_TYPE, 0,
+                                              segment);
+    EXPECT_EQ(num_pages - 2, bpm->reattach_shared_frames(std::numeric_limits<lsn_t>::max()));
+    for (int i = 0; i < num_pages; i++) {
+        Page *page = bpm->fetch_page(PageId{fd, i});
+        ASSERT_NE(nullptr, page);
+        char expected = (i == 1 || i == 2) ? '#' : static_cast<char>('a' + i % 26);
+        EXPECT_EQ(expected, page->get_data()[PAGE_SIZE - 1]);
+        bpm->unpin_page(PageId{fd, i}, false);
+    }
+    bpm.reset();
+
+    // 段与缓冲池大小不匹配时重新创建，没有可接管的页面
+    bpm = std::make_unique<BufferPoolManager>(static_cast<size_t>(64), disk_manager_.get(), 2, REPLACER_TYPE, 0,
+                                              segment);
+    EXPECT_EQ(0, bpm->reattach_shared_frames(std::numeric_limits<lsn_t>::max()));
+    bpm.reset();
+    SharedFrameSegment::destroy(segment);
+    disk_manager_->close_file(fd);
+    disk_manager_->close_file(other_fd);
+}
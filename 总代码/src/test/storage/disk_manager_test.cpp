@@ -1,7 +1,13 @@
 #include "storage/disk_manager.h"
 
+#include <sys/stat.h>
+
+#include <algorithm>
 #include <cassert>
+#include <cstdio>
 #include <cstring>
+#include <set>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -147,3 +153,404 @@ TEST_F(DiskManagerTest, PageOperation) {
     disk_manager_->destroy_file(filename);
     EXPECT_EQ(disk_manager_->is_file(filename), false);
 }
+
+/**
+ * @brief 测试连续多页面的向量化读写 read_pages/write_pages
+ */
+TEST_F(DiskManagerTest, MultiPageOperation) {
+    const std::string filename = "MultiPageOperationTestFile";
+    if (disk_manager_->is_file(filename)) {
+        disk_manager_->destroy_file(filename);
+    }
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+
+    std::vector<std::vector<char>> data(MAX_PAGES, std::vector<char>(PAGE_SIZE));
+    std::vector<const char *> write_ptrs;
+    for (auto &page : data) {
+        rand_buf(page.data(), PAGE_SIZE);
+        write_ptrs.push_back(page.data());
+    }
+    // 一次写入全部页面
+    disk_manager_->write_pages(fd, 0, write_ptrs.data(), MAX_PAGES);
+
+    // 从中间位置读取一段连续页面，并与单页读取的结果比较
+    const int start = MAX_PAGES / 4;
+    const int count = MAX_PAGES / 2;
+    std::vector<std::vector<char>> bufs(count, std::vector<char>(PAGE_SIZE, 0));
+    std::vector<char *> read_ptrs;
+    for (auto &buf : bufs) {
+        read_ptrs.push_back(buf.data());
+    }
+    disk_manager_->read_pages(fd, start, read_ptrs.data(), count);
+    for (int i = 0; i < count; i++) {
+        EXPECT_EQ(std::memcmp(bufs[i].data(), data[start + i].data(), PAGE_SIZE), 0);
+    }
+    char buf[PAGE_SIZE] = {0};
+    disk_manager_->read_page(fd, MAX_PAGES - 1, buf, PAGE_SIZE);
+    EXPECT_EQ(std::memcmp(buf, data[MAX_PAGES - 1].data(), PAGE_SIZE), 0);
+
+    // 读取超过文件末尾的页面时应抛出异常
+    EXPECT_THROW(disk_manager_->read_pages(fd, MAX_PAGES - 1, read_ptrs.data(), 2), InternalError);
+
+    disk_manager_->close_file(fd);
+    disk_manager_->destroy_file(filename);
+}
+
+/**
+ * @brief 测试异步页面读写 submit_read/submit_write/poll_completions，分别测试io_uring和同步退化两种模式
+ */
+TEST_F(DiskManagerTest, AsyncPageOperation) {
+    const std::string filename = "AsyncPageOperationTestFile";
+    if (disk_manager_->is_file(filename)) {
+        disk_manager_->destroy_file(filename);
+    }
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+
+    for (bool async : {true, false}) {
+        disk_manager_->set_async_io(async);
+        std::vector<std::vector<char>> data(MAX_PAGES, std::vector<char>(PAGE_SIZE));
+        for (int page_no = 0; page_no < MAX_PAGES; page_no++) {
+            rand_buf(data[page_no].data(), PAGE_SIZE);
+            data[page_no][0] = static_cast<char>(page_no);
+            disk_manager_->submit_write(fd, page_no, data[page_no].data(), PAGE_SIZE, page_no);
+        }
+        std::vector<IoCompletion> completions;
+        while (completions.size() < MAX_PAGES) {
+            disk_manager_->poll_completions(&completions, MAX_PAGES - completions.size());
+        }
+        for (auto &completion : completions) {
+            EXPECT_EQ(completion.result, PAGE_SIZE);
+        }
+
+        // 倒序提交读请求，按user_data核对每个页面的内容
+        std::vector<std::vector<char>> bufs(MAX_PAGES, std::vector<char>(PAGE_SIZE, 0));
+        for (int page_no = MAX_PAGES - 1; page_no >= 0; page_no--) {
+            disk_manager_->submit_read(fd, page_no, bufs[page_no].data(), PAGE_SIZE, page_no);
+        }
+        completions.clear();
+        while (completions.size() < MAX_PAGES) {
+            disk_manager_->poll_completions(&completions, 1);
+        }
+        for (auto &completion : completions) {
+            ASSERT_EQ(completion.result, PAGE_SIZE);
+            EXPECT_EQ(std::memcmp(bufs[completion.user_data].data(), data[completion.user_data].data(), PAGE_SIZE), 0);
+        }
+        // 读取文件末尾之后的页面，结果为0字节
+        char buf[PAGE_SIZE];
+        disk_manager_->submit_read(fd, MAX_PAGES, buf, PAGE_SIZE, MAX_PAGES);
+        completions.clear();
+        disk_manager_->poll_completions(&completions, 1);
+        ASSERT_EQ(completions.size(), 1);
+        EXPECT_EQ(completions[0].result, 0);
+    }
+
+    disk_manager_->close_file(fd);
+    disk_manager_->destroy_file(filename);
+}
+
+/**
+ * @brief 测试O_DIRECT模式：对齐的缓冲区直接读写，未对齐的缓冲区和不足一页的读写经对齐缓冲区中转
+ */
+TEST_F(DiskManagerTest, DirectIoOperation) {
+    const std::string filename = "DirectIoOperationTestFile";
+    if (disk_manager_->is_file(filename)) {
+        disk_manager_->destroy_file(filename);
+    }
+    disk_manager_->create_file(filename);
+    disk_manager_->set_direct_io(true);
+    int fd = disk_manager_->open_file(filename);
+    if (!disk_manager_->is_direct_io(fd)) {
+        disk_manager_->close_file(fd);
+        disk_manager_->destroy_file(filename);
+        GTEST_SKIP() << "file system does not support O_DIRECT";
+    }
+
+    // 对齐的整页读写
+    void *aligned = nullptr;
+    ASSERT_EQ(posix_memalign(&aligned, DIRECT_IO_ALIGNMENT, 2 * PAGE_SIZE), 0);
+    char *aligned_buf = static_cast<char *>(aligned);
+    rand_buf(aligned_buf, 2 * PAGE_SIZE);
+    disk_manager_->write_page(fd, 0, aligned_buf, PAGE_SIZE);
+    char *read_buf = aligned_buf + PAGE_SIZE;
+    disk_manager_->read_page(fd, 0, read_buf, PAGE_SIZE);
+    EXPECT_EQ(std::memcmp(aligned_buf, read_buf, PAGE_SIZE), 0);
+
+    // 未对齐的缓冲区，以及只覆盖页面开头一部分的写入不能破坏页面的其余部分
+    std::vector<char> unaligned(PAGE_SIZE + 1);
+    rand_buf(unaligned.data() + 1, PAGE_SIZE);
+    disk_manager_->write_page(fd, 1, unaligned.data() + 1, PAGE_SIZE);
+    char header[100];
+    rand_buf(header, sizeof(header));
+    disk_manager_->write_page(fd, 1, header, sizeof(header));
+    std::memcpy(unaligned.data() + 1, header, sizeof(header));
+    std::vector<char> page(PAGE_SIZE + 1);
+    disk_manager_->read_page(fd, 1, page.data() + 1, PAGE_SIZE);
+    EXPECT_EQ(std::memcmp(page.data() + 1, unaligned.data() + 1, PAGE_SIZE), 0);
+    char header_read[sizeof(header)];
+    disk_manager_->read_page(fd, 1, header_read, sizeof(header_read));
+    EXPECT_EQ(std::memcmp(header_read, header, sizeof(header)), 0);
+
+    // 未对齐缓冲区的多页读写
+    std::vector<char *> pages = {page.data() + 1, aligned_buf};
+    disk_manager_->read_pages(fd, 0, pages.data(), 2);
+    EXPECT_EQ(std::memcmp(page.data() + 1, read_buf, PAGE_SIZE), 0);
+    EXPECT_EQ(std::memcmp(aligned_buf, unaligned.data() + 1, PAGE_SIZE), 0);
+    EXPECT_THROW(disk_manager_->read_page(fd, 2, read_buf, PAGE_SIZE), InternalError);
+
+    free(aligned);
+    disk_manager_->close_file(fd);
+    disk_manager_->destroy_file(filename);
+}
+
+/**
+ * @brief 测试空闲页面管理：释放的页面被优先复用，空闲页面表在关闭文件后持久化
+ */
+TEST_F(DiskManagerTest, FreePageOperation) {
+    const std::string filename = "FreePageOperationTestFile";
+    if (disk_manager_->is_file(filename)) {
+        disk_manager_->destroy_file(filename);
+    }
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+    disk_manager_->set_fd2pageno(fd, 0);
+
+    char buf[PAGE_SIZE];
+    rand_buf(buf, PAGE_SIZE);
+    for (int i = 0; i < MAX_PAGES; i++) {
+        page_id_t page_no = disk_manager_->allocate_page(fd);
+        EXPECT_EQ(page_no, i);
+        disk_manager_->write_page(fd, page_no, buf, PAGE_SIZE);
+    }
+    // 释放一段足够长的连续页面(会被打洞)和几个零散页面
+    for (page_id_t page_no = 10; page_no < 10 + FREE_PAGE_PUNCH_MIN_RUN; page_no++) {
+        disk_manager_->deallocate_page(fd, page_no);
+    }
+    disk_manager_->deallocate_page(fd, 100);
+    disk_manager_->deallocate_page(fd, 5);
+    disk_manager_->deallocate_page(fd, 5);  // 重复释放不影响空闲页面表
+    EXPECT_EQ(disk_manager_->get_num_free_pages(fd), FREE_PAGE_PUNCH_MIN_RUN + 2);
+    if (FREE_PAGE_PUNCH_MIN_RUN > 0) {
+        char zeros[PAGE_SIZE] = {};
+        char page[PAGE_SIZE];
+        disk_manager_->read_page(fd, 10, page, PAGE_SIZE);
+        EXPECT_EQ(std::memcmp(page, zeros, PAGE_SIZE), 0);
+        disk_manager_->read_page(fd, 9, page, PAGE_SIZE);
+        EXPECT_EQ(std::memcmp(page, buf, PAGE_SIZE), 0);
+    }
+    // 按页号从小到大复用
+    EXPECT_EQ(disk_manager_->allocate_page(fd), 5);
+    EXPECT_EQ(disk_manager_->allocate_page(fd), 10);
+
+    // 关闭后重新打开，空闲页面表保持不变
+    disk_manager_->close_file(fd);
+    EXPECT_TRUE(disk_manager_->is_file(DiskManager::get_free_list_name(filename)));
+    fd = disk_manager_->open_file(filename);
+    disk_manager_->set_fd2pageno(fd, MAX_PAGES);
+    EXPECT_FALSE(disk_manager_->is_file(DiskManager::get_free_list_name(filename)));
+    EXPECT_EQ(disk_manager_->get_num_free_pages(fd), FREE_PAGE_PUNCH_MIN_RUN);
+    EXPECT_EQ(disk_manager_->allocate_page(fd), 11);
+    for (int i = 0; i < FREE_PAGE_PUNCH_MIN_RUN - 2; i++) {
+        disk_manager_->allocate_page(fd);
+    }
+    EXPECT_EQ(disk_manager_->allocate_page(fd), 100);
+    EXPECT_EQ(disk_manager_->allocate_page(fd), MAX_PAGES);
+
+    disk_manager_->close_file(fd);
+    disk_manager_->destroy_file(filename);
+    EXPECT_FALSE(disk_manager_->is_file(DiskManager::get_free_list_name(filename)));
+}
+
+/**
+ * @brief 测试压缩文件：页面读写对调用者透明，关闭后重新打开、以及页面映射表丢失(崩溃)后都能读出最新内容
+ */
+TEST_F(DiskManagerTest, CompressedPageOperation) {
+    const std::string filename = "CompressedPageOperationTestFile";
+    if (disk_manager_->is_file(filename)) {
+        disk_manager_->destroy_file(filename);
+    }
+    disk_manager_->create_file(filename, true);
+    int fd = disk_manager_->open_file(filename);
+    EXPECT_TRUE(disk_manager_->is_compressed(fd));
+
+    // 模拟定长记录：少量有效数据加大量填充0，偶尔是不可压缩的随机页面
+    std::vector<std::vector<char>> mock(MAX_PAGES, std::vector<char>(PAGE_SIZE, 0));
+    auto fill = [&](int page_no, bool random) {
+        auto &page = mock[page_no];
+        if (random) {
+            rand_buf(page.data(), PAGE_SIZE);
+            return;
+        }
+        std::fill(page.begin(), page.end(), 0);
+        for (int offset = 0; offset + 64 <= PAGE_SIZE; offset += 64) {
+            snprintf(page.data() + offset, 64, "record %d-%d", page_no, offset);
+        }
+    };
+    for (int page_no = 0; page_no < MAX_PAGES; page_no++) {
+        fill(page_no, page_no % 16 == 15);
+        disk_manager_->write_page(fd, page_no, mock[page_no].data(), PAGE_SIZE);
+    }
+    EXPECT_LT(disk_manager_->get_compressed_bytes(fd), static_cast<size_t>(MAX_PAGES) * PAGE_SIZE / 2);
+
+    // 压缩页面变为不可压缩页面(需要换到更大的槽)，以及只写页面开头的一部分
+    fill(3, true);
+    disk_manager_->write_page(fd, 3, mock[3].data(), PAGE_SIZE);
+    fill(15, false);
+    disk_manager_->write_page(fd, 15, mock[15].data(), PAGE_SIZE);
+    char header[100];
+    rand_buf(header, sizeof(header));
+    disk_manager_->write_page(fd, 7, header, sizeof(header));
+    memcpy(mock[7].data(), header, sizeof(header));
+
+    auto check_all = [&]() {
+        std::vector<char> buf(PAGE_SIZE);
+        for (int page_no = 0; page_no < MAX_PAGES; page_no++) {
+            disk_manager_->read_page(fd, page_no, buf.data(), PAGE_SIZE);
+            ASSERT_EQ(std::memcmp(buf.data(), mock[page_no].data(), PAGE_SIZE), 0) << "page " << page_no;
+        }
+        EXPECT_THROW(disk_manager_->read_page(fd, MAX_PAGES, buf.data(), PAGE_SIZE), InternalError);
+    };
+    check_all();
+
+    // 正常关闭后重新打开
+    disk_manager_->close_file(fd);
+    fd = disk_manager_->open_file(filename);
+    EXPECT_TRUE(disk_manager_->is_compressed(fd));
+    check_all();
+
+    // 页面映射表丢失时扫描所有槽重建
+    disk_manager_->close_file(fd);
+    unlink(CompressedFile::get_page_map_name(filename).c_str());
+    fd = disk_manager_->open_file(filename);
+    check_all();
+
+    disk_manager_->close_file(fd);
+    disk_manager_->destroy_file(filename);
+    EXPECT_FALSE(disk_manager_->is_file(CompressedFile::get_page_map_name(filename)));
+}
+
+/**
+ * @brief 测试文件按extent增长：分配页面时按整个extent预分配磁盘空间，但不改变文件大小；批量分配得到连续页号
+ */
+TEST_F(DiskManagerTest, ExtentOperation) {
+    const std::string filename = "ExtentOperationTestFile";
+    if (disk_manager_->is_file(filename)) {
+        disk_manager_->destroy_file(filename);
+    }
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+    disk_manager_->set_fd2pageno(fd, 0);
+    const int extent_pages = DiskManager::FILE_EXTENT_PAGES;
+
+    EXPECT_EQ(disk_manager_->allocate_page(fd), 0);
+    EXPECT_EQ(disk_manager_->get_fd2pageno(fd), 1);
+    if (extent_pages > 1) {
+        EXPECT_EQ(disk_manager_->get_extent_end(fd), extent_pages);
+        struct stat st;
+        ASSERT_EQ(stat(filename.c_str(), &st), 0);
+        EXPECT_EQ(st.st_size, 0);  // 预分配不改变文件大小，未写入的页面仍然不可读
+        EXPECT_GE(static_cast<long>(st.st_blocks) * 512, static_cast<long>(FILE_EXTENT_SIZE));
+    }
+
+    // 批量分配跨越extent边界，预分配到下一个extent的末尾
+    page_id_t start_page_no = disk_manager_->allocate_pages(fd, extent_pages + 1);
+    EXPECT_EQ(start_page_no, 1);
+    EXPECT_EQ(disk_manager_->get_fd2pageno(fd), extent_pages + 2);
+    EXPECT_GE(disk_manager_->get_extent_end(fd), disk_manager_->get_fd2pageno(fd));
+    if (extent_pages > 1) {
+        EXPECT_EQ(disk_manager_->get_extent_end(fd) % extent_pages, 0);
+    }
+
+    char buf[PAGE_SIZE];
+    char page[PAGE_SIZE];
+    rand_buf(buf, PAGE_SIZE);
+    disk_manager_->write_page(fd, extent_pages + 1, buf, PAGE_SIZE);
+    disk_manager_->read_page(fd, extent_pages + 1, page, PAGE_SIZE);
+    EXPECT_EQ(std::memcmp(page, buf, PAGE_SIZE), 0);
+    EXPECT_EQ(disk_manager_->get_file_size(filename), (extent_pages + 2) * PAGE_SIZE);
+
+    // 重新打开后从已使用的页面个数开始继续预分配
+    disk_manager_->close_file(fd);
+    fd = disk_manager_->open_file(filename);
+    disk_manager_->set_fd2pageno(fd, extent_pages + 2);
+    EXPECT_EQ(disk_manager_->get_extent_end(fd), extent_pages + 2);
+    EXPECT_EQ(disk_manager_->allocate_page(fd), extent_pages + 2);
+    EXPECT_GE(disk_manager_->get_extent_end(fd), extent_pages + 3);
+
+    disk_manager_->close_file(fd);
+    disk_manager_->destroy_file(filename);
+}
+
+/**
+ * @brief 测试文件注册表：文件数超过MAX_OPEN_FILES时描述符被淘汰并在访问时重新打开，
+ *        同一路径关闭后重新打开得到相同的文件句柄，删除后重新创建得到新的文件句柄，并发打开同一文件得到相同的句柄
+ */
+TEST_F(DiskManagerTest, FileRegistryOperation) {
+    const int num_files = MAX_OPEN_FILES + MAX_FILES;
+    std::vector<std::string> filenames(num_files);
+    std::vector<int> fds(num_files);
+    char buf[PAGE_SIZE];
+    char page[PAGE_SIZE];
+    for (int i = 0; i < num_files; i++) {
+        filenames[i] = "FileRegistryOperationTestFile" + std::to_string(i);
+        if (disk_manager_->is_file(filenames[i])) {
+            disk_manager_->destroy_file(filenames[i]);
+        }
+        disk_manager_->create_file(filenames[i]);
+        fds[i] = disk_manager_->open_file(filenames[i]);
+        memset(buf, i % 256, PAGE_SIZE);
+        disk_manager_->write_page(fds[i], 0, buf, PAGE_SIZE);
+        EXPECT_LE(disk_manager_->get_num_os_fds(), MAX_OPEN_FILES);
+    }
+    EXPECT_EQ(std::set<int>(fds.begin(), fds.end()).size(), static_cast<size_t>(num_files));
+
+    // 描述符被淘汰的文件在访问时重新打开
+    for (int i = 0; i < num_files; i++) {
+        EXPECT_EQ(disk_manager_->get_file_fd(filenames[i]), fds[i]);
+        EXPECT_EQ(disk_manager_->get_file_name(fds[i]), filenames[i]);
+        disk_manager_->read_page(fds[i], 0, page, PAGE_SIZE);
+        memset(buf, i % 256, PAGE_SIZE);
+        EXPECT_EQ(std::memcmp(page, buf, PAGE_SIZE), 0);
+    }
+    EXPECT_LE(disk_manager_->get_num_os_fds(), MAX_OPEN_FILES);
+
+    // 关闭后重新打开得到相同的句柄，删除后重新创建得到新的句柄
+    disk_manager_->close_file(fds[0]);
+    EXPECT_THROW(disk_manager_->read_page(fds[0], 0, page, PAGE_SIZE), FileNotOpenError);
+    EXPECT_EQ(disk_manager_->open_file(filenames[0]), fds[0]);
+    disk_manager_->close_file(fds[0]);
+    disk_manager_->destroy_file(filenames[0]);
+    disk_manager_->create_file(filenames[0]);
+    fds[0] = disk_manager_->open_file(filenames[0]);
+    EXPECT_GE(fds[0], num_files);
+
+    // 多个线程并发打开同一批文件
+    const int num_threads = 4;
+    for (int i = 1; i <= MAX_FILES; i++) {
+        disk_manager_->close_file(fds[i]);
+    }
+    std::vector<std::vector<int>> opened(num_threads, std::vector<int>(MAX_FILES + 1));
+    std::vector<std::thread> threads;
+    for (int tid = 0; tid < num_threads; tid++) {
+        threads.emplace_back([&, tid]() {
+            for (int i = 1; i <= MAX_FILES; i++) {
+                opened[tid][i] = disk_manager_->open_file(filenames[i]);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    for (int tid = 0; tid < num_threads; tid++) {
+        for (int i = 1; i <= MAX_FILES; i++) {
+            EXPECT_EQ(opened[tid][i], fds[i]);
+        }
+    }
+
+    for (int i = 0; i < num_files; i++) {
+        disk_manager_->close_file(fds[i]);
+        disk_manager_->destroy_file(filenames[i]);
+    }
+    EXPECT_EQ(disk_manager_->get_num_os_fds(), 0);
+}
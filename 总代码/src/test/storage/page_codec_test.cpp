@@ -0,0 +1,68 @@
+#include "storage/page_codec.h"
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "common/config.h"
+#include "gtest/gtest.h"
+
+/**
+ * @brief 压缩后再解压应当得到原数据，覆盖全0、重复模式、随机数据和很短的输入
+ */
+TEST(PageCodecTest, RoundTrip) {
+    std::mt19937 rng(42);
+    std::vector<std::vector<char>> inputs;
+    inputs.emplace_back(PAGE_SIZE, 0);
+    std::vector<char> pattern(PAGE_SIZE);
+    for (int i = 0; i < PAGE_SIZE; i++) pattern[i] = "abcdefg"[i % 7];
+    inputs.push_back(pattern);
+    std::vector<char> random(PAGE_SIZE);
+    for (auto &c : random) c = static_cast<char>(rng());
+    inputs.push_back(random);
+    std::vector<char> mixed(PAGE_SIZE, 0);
+    for (int i = 0; i < PAGE_SIZE; i += 100) mixed[i] = static_cast<char>(rng());
+    inputs.push_back(mixed);
+    inputs.emplace_back(3, 'x');
+    inputs.emplace_back();
+
+    for (auto &input : inputs) {
+        int len = static_cast<int>(input.size());
+        std::vector<char> compressed(PageCodec::max_compressed_size(len));
+        int compressed_len = PageCodec::compress(input.data(), len, compressed.data(), compressed.size());
+        ASSERT_GE(compressed_len, 0);
+        std::vector<char> output(len + 1);
+        ASSERT_EQ(PageCodec::decompress(compressed.data(), compressed_len, output.data(), len), len);
+        EXPECT_EQ(std::memcmp(output.data(), input.data(), len), 0);
+    }
+    // 全0页面应当被压缩到很小
+    std::vector<char> compressed(PAGE_SIZE);
+    EXPECT_LT(PageCodec::compress(inputs[0].data(), PAGE_SIZE, compressed.data(), PAGE_SIZE), 64);
+    // 随机数据无法压缩到比原数据更小
+    EXPECT_EQ(PageCodec::compress(random.data(), PAGE_SIZE, compressed.data(), PAGE_SIZE - 1), -1);
+}
+
+/**
+ * @brief 损坏或被截断的压缩数据不能导致越界读写，解压应当返回-1
+ */
+TEST(PageCodecTest, CorruptedInput) {
+    std::vector<char> page(PAGE_SIZE, 0);
+    for (int i = 0; i < PAGE_SIZE; i += 64) page[i] = static_cast<char>(i);
+    std::vector<char> compressed(PageCodec::max_compressed_size(PAGE_SIZE));
+    int compressed_len = PageCodec::compress(page.data(), PAGE_SIZE, compressed.data(), compressed.size());
+    ASSERT_GT(compressed_len, 0);
+
+    std::vector<char> output(PAGE_SIZE);
+    // 去掉末尾只有0个字面量的结束序列后仍是合法的编码，因此只检查更短的截断
+    for (int len = 0; len < compressed_len - 1; len++) {
+        EXPECT_EQ(PageCodec::decompress(compressed.data(), len, output.data(), PAGE_SIZE), -1);
+    }
+    // 解压结果长度与期望不符
+    EXPECT_EQ(PageCodec::decompress(compressed.data(), compressed_len, output.data(), PAGE_SIZE / 2), -1);
+    std::mt19937 rng(7);
+    for (int round = 0; round < 1000; round++) {
+        std::vector<char> corrupted(compressed.begin(), compressed.begin() + compressed_len);
+        corrupted[rng() % compressed_len] = static_cast<char>(rng());
+        PageCodec::decompress(corrupted.data(), compressed_len, output.data(), PAGE_SIZE);
+    }
+}
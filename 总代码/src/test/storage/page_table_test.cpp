@@ -0,0 +1,91 @@
+#include <atomic>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "errors.h"
+#include "gtest/gtest.h"
+#include "storage/page_table.h"
+
+/**
+ * @brief 测试PageTable的插入、查找、更新和删除，删除时后面的条目前移后仍能被找到；
+ * 以及PageId的比较与哈希：页号超过65536的页面不会与其他文件的页面冲突
+ */
+TEST(PageTableTest, SimpleTest) {
+    EXPECT_TRUE((PageId{0, 5} < PageId{1, 0}));
+    EXPECT_FALSE((PageId{1, 0} < PageId{0, 5}));
+    EXPECT_NE(PageId({0, 65536}).Get(), PageId({1, 0}).Get());
+
+    const size_t max_entries = 1024;
+    PageTable page_table(max_entries);
+    EXPECT_EQ(page_table.capacity(), 2 * max_entries);
+    std::unordered_map<int64_t, frame_id_t> expected;
+    for (int i = 0; i < static_cast<int>(max_entries); i++) {
+        PageId page_id{i % 3, i * 40000};
+        page_table.insert(page_id, i);
+        expected[page_id.Get()] = i;
+    }
+    EXPECT_EQ(max_entries, page_table.size());
+    EXPECT_THROW(page_table.insert(PageId{7, 7}, 7), InternalError);
+    page_table.insert(PageId{0, 0}, 4242);
+    expected[PageId({0, 0}).Get()] = 4242;
+    EXPECT_EQ(4242, page_table.find(PageId{0, 0}));
+    EXPECT_EQ(INVALID_FRAME_ID, page_table.find(PageId{3, 0}));
+
+    // 删除一半的条目，剩下的条目都仍能找到
+    for (int i = 0; i < static_cast<int>(max_entries); i += 2) {
+        PageId page_id{i % 3, i * 40000};
+        EXPECT_TRUE(page_table.erase(page_id));
+        EXPECT_FALSE(page_table.erase(page_id));
+        expected.erase(page_id.Get());
+    }
+    EXPECT_EQ(max_entries / 2, page_table.size());
+    for (int i = 0; i < static_cast<int>(max_entries); i++) {
+        PageId page_id{i % 3, i * 40000};
+        auto it = expected.find(page_id.Get());
+        EXPECT_EQ(it == expected.end() ? INVALID_FRAME_ID : it->second, page_table.find(page_id));
+    }
+}
+
+/**
+ * @brief 测试不加锁的查找：一个线程不断插入和删除一组页面，使其他条目在表中前后移动，
+ * 查找线程对始终在表中的页面每次都能得到正确的帧
+ */
+TEST(PageTableTest, ConcurrentLookupTest) {
+    const int num_stable = 256;
+    const int num_churn = 256;
+    PageTable page_table(num_stable + num_churn);
+    for (int i = 0; i < num_stable; i++) {
+        page_table.insert(PageId{1, i}, i);
+    }
+    std::atomic<bool> stop{false};
+    std::thread writer([&]() {
+        for (int round = 0; !stop; round++) {
+            for (int i = 0; i < num_churn; i++) {
+                page_table.insert(PageId{2, round * num_churn + i}, i);
+            }
+            for (int i = 0; i < num_churn; i++) {
+                page_table.erase(PageId{2, round * num_churn + i});
+            }
+        }
+    });
+    std::vector<std::thread> readers;
+    std::atomic<int> num_errors{0};
+    for (int tid = 0; tid < 4; tid++) {
+        readers.emplace_back([&]() {
+            for (int round = 0; round < 200; round++) {
+                for (int i = 0; i < num_stable; i++) {
+                    if (page_table.find(PageId{1, i}) != i) {
+                        num_errors++;
+                    }
+                }
+            }
+        });
+    }
+    for (auto &reader : readers) {
+        reader.join();
+    }
+    stop = true;
+    writer.join();
+    EXPECT_EQ(0, num_errors.load());
+}
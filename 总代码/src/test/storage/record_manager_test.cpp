@@ -4,10 +4,13 @@
 #include "record/rm.h"
 #undef private  // for use private variables in "rm.h"
 
+#include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cstring>
 #include <ctime>
 #include <iostream>
+#include <thread>
 #include <unordered_map>
 
 #include "gtest/gtest.h"
@@ -38,6 +41,12 @@ void check_equal(const RmFileHandle *file_handle,
         auto mock_buf = (char *)entry.second.c_str();
         auto rec = file_handle->get_record(rid, context);
         assert(memcmp(mock_buf, rec->data, file_handle->file_hdr_.record_size) == 0);
+        RecordView view = file_handle->get_record_view(rid);
+        assert(view.size() == file_handle->file_hdr_.record_size);
+        assert(memcmp(mock_buf, view.data(), view.size()) == 0);
+        auto copy = view.to_record();
+        view.drop();
+        assert(memcmp(mock_buf, copy->data, file_handle->file_hdr_.record_size) == 0);
     }
     // Randomly get record
     for (int i = 0; i < 10; i++) {
@@ -51,11 +60,22 @@ void check_equal(const RmFileHandle *file_handle,
     size_t num_records = 0;
     for (RmScan scan(file_handle); !scan.is_end(); scan.next()) {
         assert(mock.count(scan.rid()) > 0);
-        auto rec = file_handle->get_record(scan.rid(), context);
-        assert(memcmp(rec->data, mock.at(scan.rid()).c_str(), file_handle->file_hdr_.record_size) == 0);
+        // 扫描持有当前页面的读保护，直接读取帧中的记录，不再重复获取同一页面
+        assert(memcmp(scan.record(), mock.at(scan.rid()).c_str(), file_handle->file_hdr_.record_size) == 0);
         num_records++;
     }
     assert(num_records == mock.size());
+    // Test RM batch scan
+    num_records = 0;
+    RmScan scan(file_handle);
+    for (bool has_page = !scan.is_end(); has_page; has_page = scan.next_batch()) {
+        RmPageBatch &batch = scan.batch();
+        for (int i = 0; i < batch.size(); i++) {
+            assert(memcmp(batch.get_record(i), mock.at(batch.rid(i)).c_str(), file_handle->file_hdr_.record_size) == 0);
+            num_records++;
+        }
+    }
+    assert(num_records == mock.size());
 }
 
 // std::cout can call this, for example: std::cout << rid
@@ -63,6 +83,41 @@ std::ostream &operator<<(std::ostream &os, const Rid &rid) {
     return os << '(' << rid.page_no << ", " << rid.slot_no << ')';
 }
 
+/**
+ * @brief 测试按64位的字查找bitmap，与逐位检查的结果比较，包括不是字节、字的整数倍的长度
+ */
+TEST(RecordManagerTest, BitmapTest) {
+    srand((unsigned)time(nullptr));
+    char bm[64];
+    int bits[sizeof(bm) * BITMAP_WIDTH];
+    for (int max_n : {1, 7, 8, 63, 64, 65, 130, 511, 512}) {
+        for (int round = 0; round < 20; round++) {
+            rand_buf(sizeof(bm), bm);
+            int expected_count = 0;
+            for (int i = 0; i < max_n; i++) {
+                expected_count += Bitmap::is_set(bm, i);
+            }
+            EXPECT_EQ(expected_count, Bitmap::count(bm, max_n));
+            EXPECT_EQ(expected_count, Bitmap::get_set_bits(bm, max_n, bits));
+            int n = 0;
+            for (int i = 0; i < max_n; i++) {
+                if (Bitmap::is_set(bm, i)) {
+                    EXPECT_EQ(i, bits[n++]);
+                }
+            }
+            for (bool bit : {false, true}) {
+                for (int curr = -1; curr < max_n; curr++) {
+                    int expected = curr + 1;
+                    while (expected < max_n && Bitmap::is_set(bm, expected) != bit) {
+                        expected++;
+                    }
+                    EXPECT_EQ(expected, Bitmap::next_bit(bit, bm, max_n, curr));
+                }
+            }
+        }
+    }
+}
+
 /**
  * @brief 简单测试record的基本功能
  * @note lab1 计分：15 points
@@ -223,4 +278,63 @@ TEST(RecordManagerTest, MultipleFilesTest) {
         std::string filename = filenames[i];
         rm_manager->destroy_file(filename);
     }
-}
\ No newline at end of file
+}
+/**
+ * @brief 测试记录视图和扫描与写者交错：视图或扫描持有页面期间，其他线程对同一页面的修改等待它们释放，
+ * 持有期间读到的始终是修改前的内容，释放后读到修改后的内容
+ */
+TEST(RecordManagerTest, ViewWriterInterleaveTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+    std::string filename = "view_writer.txt";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    const int record_size = 16;
+    rm_manager->create_file(filename, record_size);
+    auto file_handle = rm_manager->open_file(filename);
+    std::string old_data(record_size, 'a');
+    std::string new_data(record_size, 'b');
+    std::vector<Rid> rids;
+    for (int i = 0; i < 4; i++) {
+        rids.push_back(file_handle->insert_record(const_cast<char *>(old_data.c_str()), nullptr));
+    }
+
+    // 视图持有页面时写者等待，视图中的内容不变
+    RecordView view = file_handle->get_record_view(rids[0]);
+    std::atomic<bool> updated{false};
+    std::thread writer([&]() {
+        file_handle->update_record(rids[0], const_cast<char *>(new_data.c_str()), nullptr);
+        updated = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(updated);
+    EXPECT_EQ(std::string(view.data(), record_size), old_data);
+    view.drop();
+    writer.join();
+    EXPECT_EQ(std::string(file_handle->get_record(rids[0], nullptr)->data, record_size), new_data);
+
+    // 扫描停在页面上时写者等待，扫描离开页面后写者完成
+    RmScan scan(file_handle.get());
+    ASSERT_FALSE(scan.is_end());
+    updated = false;
+    writer = std::thread([&]() {
+        file_handle->update_record(rids[1], const_cast<char *>(new_data.c_str()), nullptr);
+        updated = true;
+    });
+    int num_records = 0;
+    for (; !scan.is_end(); scan.next()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        EXPECT_FALSE(updated);
+        std::string expected = scan.rid() == rids[0] ? new_data : old_data;
+        EXPECT_EQ(std::string(scan.record(), record_size), expected);
+        num_records++;
+    }
+    EXPECT_EQ(num_records, 4);
+    writer.join();
+    EXPECT_EQ(std::string(file_handle->get_record(rids[1], nullptr)->data, record_size), new_data);
+
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
@@ -0,0 +1,175 @@
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "replacer/arc_replacer.h"
+#include "replacer/clock_replacer.h"
+#include "replacer/lru_k_replacer.h"
+
+/**
+ * @brief 把frame_id对应的页面访问一次：固定、记录访问、取消固定，与BufferPoolManager的调用方式一致
+ */
+static void access(Replacer *replacer, frame_id_t frame_id, int64_t page_key) {
+    replacer->pin(frame_id);
+    replacer->record_access(frame_id, page_key);
+    replacer->unpin(frame_id);
+}
+
+/**
+ * @brief 测试ClockReplacer：引用位为1的帧获得第二次机会，被固定的帧不会被淘汰
+ */
+TEST(ClockReplacerTest, SimpleTest) {
+    ClockReplacer clock_replacer(7);
+
+    for (frame_id_t frame_id = 1; frame_id <= 6; frame_id++) {
+        clock_replacer.unpin(frame_id);
+    }
+    EXPECT_EQ(6, clock_replacer.Size());
+
+    // 所有帧的引用位都为1，转完一圈清零后从1开始淘汰
+    int value;
+    EXPECT_TRUE(clock_replacer.victim(&value));
+    EXPECT_EQ(1, value);
+    EXPECT_TRUE(clock_replacer.victim(&value));
+    EXPECT_EQ(2, value);
+
+    // 3被固定，4被再次访问获得第二次机会
+    clock_replacer.pin(3);
+    clock_replacer.record_access(4, 4);
+    EXPECT_EQ(3, clock_replacer.Size());
+    std::vector<frame_id_t> candidates;
+    clock_replacer.peek_victims(&candidates, 3);
+    EXPECT_EQ(candidates, (std::vector<frame_id_t>{5, 6, 4}));
+    EXPECT_TRUE(clock_replacer.victim(&value));
+    EXPECT_EQ(5, value);
+    EXPECT_TRUE(clock_replacer.victim(&value));
+    EXPECT_EQ(6, value);
+    EXPECT_TRUE(clock_replacer.victim(&value));
+    EXPECT_EQ(4, value);
+    EXPECT_FALSE(clock_replacer.victim(&value));
+
+    clock_replacer.unpin(3);
+    EXPECT_TRUE(clock_replacer.victim(&value));
+    EXPECT_EQ(3, value);
+}
+
+/**
+ * @brief 测试LRUKReplacer：引用不足K次的帧优先淘汰，引用满K次的帧按倒数第K次引用的时间淘汰，
+ * 帧中换成新页面时引用历史重新开始
+ */
+TEST(LRUKReplacerTest, SimpleTest) {
+    LRUKReplacer lru_k_replacer(7, 2);
+
+    // 相邻两次访问之间隔开足够多的其他访问，避免被视为相关引用
+    auto spaced_access = [&](frame_id_t frame_id, int64_t page_key) {
+        for (int i = 0; i < REPLACER_CORRELATED_PERIOD; i++) {
+            lru_k_replacer.record_access(6, 6);
+        }
+        access(&lru_k_replacer, frame_id, page_key);
+    };
+    lru_k_replacer.pin(6);
+    for (frame_id_t frame_id = 1; frame_id <= 5; frame_id++) {
+        access(&lru_k_replacer, frame_id, frame_id);
+    }
+    // 1、2被引用了两次，3、4、5只引用了一次
+    spaced_access(1, 1);
+    spaced_access(2, 2);
+    EXPECT_EQ(5, lru_k_replacer.Size());
+
+    int value;
+    EXPECT_TRUE(lru_k_replacer.victim(&value));
+    EXPECT_EQ(3, value);
+    // 4被固定，不能被淘汰
+    lru_k_replacer.pin(4);
+    EXPECT_TRUE(lru_k_replacer.victim(&value));
+    EXPECT_EQ(5, value);
+    EXPECT_TRUE(lru_k_replacer.victim(&value));
+    EXPECT_EQ(1, value);
+
+    // 帧2换成了新页面，之前的引用历史作废，它比4更早被淘汰
+    lru_k_replacer.unpin(4);
+    spaced_access(2, 20);
+    spaced_access(4, 4);
+    EXPECT_TRUE(lru_k_replacer.victim(&value));
+    EXPECT_EQ(2, value);
+    EXPECT_TRUE(lru_k_replacer.victim(&value));
+    EXPECT_EQ(4, value);
+    EXPECT_FALSE(lru_k_replacer.victim(&value));
+}
+
+/**
+ * @brief 测试ARCReplacer：再次被引用的页面进入T2，命中ghost链表的页面直接进入T2并调整T1的目标大小
+ */
+TEST(ARCReplacerTest, SimpleTest) {
+    ARCReplacer arc_replacer(4);
+
+    for (frame_id_t frame_id = 0; frame_id < 4; frame_id++) {
+        access(&arc_replacer, frame_id, 100 + frame_id);
+    }
+    EXPECT_EQ(4, arc_replacer.Size());
+    // 间隔足够远后再次访问101，它从T1移到T2
+    for (int i = 0; i < REPLACER_CORRELATED_PERIOD; i++) {
+        arc_replacer.record_access(0, 100);
+    }
+    access(&arc_replacer, 1, 101);
+
+    // T1中最久未被访问的是100
+    int value;
+    EXPECT_TRUE(arc_replacer.victim(&value));
+    EXPECT_EQ(0, value);
+    // 100被淘汰后再次访问，命中B1，进入T2，同时T1的目标大小p_增加到1
+    access(&arc_replacer, 0, 100);
+    // T1(102、103)超过目标大小，淘汰其中最久未被访问的102
+    EXPECT_TRUE(arc_replacer.victim(&value));
+    EXPECT_EQ(2, value);
+    // T1不再超过目标大小，淘汰T2中最久未被访问的101
+    EXPECT_TRUE(arc_replacer.victim(&value));
+    EXPECT_EQ(1, value);
+    EXPECT_EQ(2, arc_replacer.Size());
+}
+
+/**
+ * @brief 测试抗扫描：热点页面被反复访问后，一次远大于缓存的顺序扫描不会把它们挤出缓存
+ */
+TEST(ReplacerTest, ScanResistanceTest) {
+    const size_t num_frames = 64;
+    const int num_hot_pages = 32;
+    const int num_scan_pages = 1024;
+    std::vector<std::unique_ptr<Replacer>> replacers;
+    replacers.emplace_back(new LRUKReplacer(num_frames));
+    replacers.emplace_back(new ARCReplacer(num_frames));
+    for (auto &replacer : replacers) {
+        std::vector<int64_t> frame_pages(num_frames, -1);
+        std::unordered_map<int64_t, frame_id_t> page_table;
+        size_t next_free = 0;
+        auto fetch = [&](int64_t page) {
+            auto it = page_table.find(page);
+            frame_id_t frame_id;
+            if (it != page_table.end()) {
+                frame_id = it->second;
+            } else {
+                if (next_free < num_frames) {
+                    frame_id = static_cast<frame_id_t>(next_free++);
+                } else {
+                    ASSERT_TRUE(replacer->victim(&frame_id));
+                    page_table.erase(frame_pages[frame_id]);
+                }
+                frame_pages[frame_id] = page;
+                page_table[page] = frame_id;
+            }
+            access(replacer.get(), frame_id, page);
+        };
+        for (int round = 0; round < 4; round++) {
+            for (int page = 0; page < num_hot_pages; page++) {
+                fetch(page);
+            }
+        }
+        for (int page = 0; page < num_scan_pages; page++) {
+            fetch(1000000 + page);
+        }
+        for (int page = 0; page < num_hot_pages; page++) {
+            EXPECT_TRUE(page_table.count(page)) << "hot page " << page << " was evicted by the scan";
+        }
+    }
+}
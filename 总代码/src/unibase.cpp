@@ -4,6 +4,7 @@
 #include <csignal>
 #include <unistd.h>
 #include <atomic>
+#include <limits>
 
 #include "errors.h"
 #include "optimizer/optimizer.h"
@@ -19,7 +20,12 @@
 static bool should_exit = false;
 
 auto disk_manager = std::make_unique<DiskManager>();
-auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+// 置换策略默认为REPLACER_TYPE，可以在启动时用环境变量UNIBASE_REPLACER指定；运行时可以用SET buffer_pool_size = n;
+// 在BUFFER_POOL_MAX_SIZE以内调整缓冲池大小；设置了环境变量UNIBASE_SHARED_BUFFER_POOL时帧放在该名称的共享内存段中
+auto buffer_pool_manager = std::make_unique<BufferPoolManager>(
+    BUFFER_POOL_SIZE, disk_manager.get(), 0, getenv("UNIBASE_REPLACER") ? getenv("UNIBASE_REPLACER") : REPLACER_TYPE,
+    BUFFER_POOL_MAX_SIZE,
+    getenv("UNIBASE_SHARED_BUFFER_POOL") ? getenv("UNIBASE_SHARED_BUFFER_POOL") : SHARED_BUFFER_POOL_NAME);
 auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
 auto ix_manager = std::make_unique<IxManager>(disk_manager.get(), buffer_pool_manager.get());
 auto sm_manager = std::make_unique<SmManager>(disk_manager.get(), buffer_pool_manager.get(), rm_manager.get(), ix_manager.get());
@@ -276,10 +282,22 @@ int main(int argc, char **argv) {
         // Open database
         sm_manager->open_db(db_name);
 
+        // 设置了环境变量UNIBASE_ACCESS_TRACE时，把页面访问序列记录到该文件，用于离线比较置换策略
+        if (const char *trace_path = getenv("UNIBASE_ACCESS_TRACE")) {
+            buffer_pool_manager->start_access_trace(trace_path);
+        }
+
         // recovery database
         recovery->analyze();
         recovery->redo();
         recovery->undo();
+
+        // 缓冲池在共享内存中时，恢复完成后接管上一个进程留下的页面，不需要重新从磁盘读入。
+        // 日志管理器还没有记录持久化到的lsn，暂不限制页面的page_lsn
+        if (buffer_pool_manager->is_shared()) {
+            size_t num_reattached = buffer_pool_manager->reattach_shared_frames(std::numeric_limits<lsn_t>::max());
+            std::cout << "Reattached " << num_reattached << " pages from shared memory\n";
+        }
         
         // 开启服务端，开始接受客户端连接
         start_server();